@@ -0,0 +1,53 @@
+/**
+ * Tests that collections whose initialization is deferred by 'lazyCollectionInitialization' are
+ * usable after restart, both when first used by a client and when initialized in the background.
+ *
+ * @tags: [requires_persistence]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For isIxscan.
+
+const numCollections = 20;
+
+let conn = MongoRunner.runMongod();
+let testDB = conn.getDB("test");
+for (let i = 0; i < numCollections; i++) {
+    const coll = testDB["coll" + i];
+    assert.commandWorked(coll.insert({_id: i, a: i}));
+    assert.commandWorked(coll.createIndex({a: 1}));
+    // Collections with a TTL index are initialized eagerly rather than deferred.
+    if (i % 2 === 0) {
+        assert.commandWorked(coll.createIndex({expireAt: 1}, {expireAfterSeconds: 3600}));
+    }
+}
+MongoRunner.stopMongod(conn);
+
+conn = MongoRunner.runMongod({
+    restart: conn,
+    cleanData: false,
+    setParameter: {lazyCollectionInitialization: true, lazyCollectionInitializationThreads: 2}
+});
+testDB = conn.getDB("test");
+
+// The first collection used by a client must see all of its indexes, whether or not the
+// background initialization reached it yet.
+const explain = testDB.coll1.find({a: 1}).explain();
+assert(isIxscan(testDB, explain.queryPlanner.winningPlan), tojson(explain));
+assert.eq(2, testDB.coll1.getIndexes().length);
+
+checkLog.containsJson(conn, 5160003, {numCollections: numCollections / 2});
+
+for (let i = 0; i < numCollections; i++) {
+    const coll = testDB["coll" + i];
+    assert.eq([{_id: i, a: i}], coll.find({a: i}).toArray());
+    assert.eq(i % 2 === 0 ? 3 : 2, coll.getIndexes().length);
+}
+
+// Collections can be dropped and recreated as usual.
+assert(testDB.coll1.drop());
+assert.commandWorked(testDB.coll1.insert({_id: 0}));
+
+MongoRunner.stopMongod(conn);
+})();
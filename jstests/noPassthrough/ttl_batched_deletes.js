@@ -0,0 +1,77 @@
+/**
+ * Tests that the TTL monitor removes expired documents in bounded batches, processes several TTL
+ * indexes in one pass and still logs one delete oplog entry per document.
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: 2,
+    nodeOptions: {
+        setParameter: {
+            ttlMonitorEnabled: false,
+            ttlMonitorSleepSecs: 1,
+            ttlMonitorBatchedDeleteTargetDocs: 10,
+            ttlMonitorMaxConcurrentIndexes: 2,
+        }
+    }
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const testDB = primary.getDB("test");
+// The last collection records pre-images, so its documents are deleted one at a time.
+const collNames = ["ttl_batched_a", "ttl_batched_b", "ttl_batched_c", "ttl_batched_preimages"];
+const numDocs = 95;
+const expired = new Date(Date.now() - 60 * 1000);
+
+for (let collName of collNames) {
+    const coll = testDB[collName];
+    assert.commandWorked(
+        testDB.createCollection(collName, {recordPreImages: collName === "ttl_batched_preimages"}));
+    assert.commandWorked(coll.createIndex({x: 1}, {expireAfterSeconds: 0}));
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < numDocs; i++) {
+        bulk.insert({_id: i, x: expired});
+    }
+    // A document that has not expired must survive the batched deletes.
+    bulk.insert({_id: "live", x: new Date(Date.now() + 24 * 60 * 60 * 1000)});
+    assert.commandWorked(bulk.execute());
+}
+
+const metricsBefore = testDB.serverStatus().metrics.ttl;
+assert.commandWorked(testDB.adminCommand({setParameter: 1, ttlMonitorEnabled: true}));
+
+assert.soon(function() {
+    return collNames.every(collName => testDB[collName].count() === 1);
+}, "TTL monitor did not remove the expired documents");
+
+const metricsAfter = testDB.serverStatus().metrics.ttl;
+assert.eq(metricsAfter.deletedDocuments - metricsBefore.deletedDocuments,
+          numDocs * collNames.length,
+          tojson(metricsAfter));
+// Every batched collection needs at least ten full batches of ten documents.
+assert.gte(metricsAfter.deletedDocumentBatches - metricsBefore.deletedDocumentBatches,
+           10 * (collNames.length - 1),
+           tojson(metricsAfter));
+
+// Each batched delete is still replicated as its own oplog entry, with its own timestamp.
+for (let collName of collNames) {
+    const ns = testDB[collName].getFullName();
+    const deletes = primary.getDB("local").oplog.rs.find({op: "d", ns: ns}).toArray();
+    assert.eq(numDocs, deletes.length, tojson(deletes));
+    const timestamps = new Set(deletes.map(entry => entry.ts.toString()));
+    assert.eq(numDocs, timestamps.size, tojson(deletes));
+}
+
+rst.awaitReplication();
+const secondaryDB = rst.getSecondary().getDB("test");
+for (let collName of collNames) {
+    assert.eq([{_id: "live"}], secondaryDB[collName].find({}, {_id: 1}).toArray());
+}
+
+rst.stopSet();
+})();
@@ -0,0 +1,46 @@
+/**
+ * Tests that initial sync clones collections correctly when it appends their documents through
+ * the storage engine's bulk load interface.
+ * @tags: [
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const primaryDB = rst.getPrimary().getDB(jsTestName());
+const nDocs = 1000;
+let bulk = primaryDB.coll.initializeUnorderedBulkOp();
+for (let i = 0; i < nDocs; i++) {
+    bulk.insert({_id: i, x: i % 10, payload: "a".repeat(100)});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(primaryDB.coll.createIndex({x: 1}));
+assert.commandWorked(primaryDB.createCollection("empty"));
+
+const secondary = rst.add({
+    rsConfig: {priority: 0, votes: 0},
+    setParameter: {collectionBulkLoaderUseRecordStoreBulkLoad: true}
+});
+rst.reInitiate();
+rst.awaitSecondaryNodes();
+rst.awaitReplication();
+
+const secondaryDB = secondary.getDB(jsTestName());
+secondaryDB.getMongo().setSlaveOk();
+assert.eq(nDocs, secondaryDB.coll.find().itcount());
+assert.eq(nDocs / 10, secondaryDB.coll.find({x: 3}).hint({x: 1}).itcount());
+assert.eq(0, secondaryDB.empty.find().itcount());
+
+// The loaded documents can be written to after initial sync.
+assert.commandWorked(primaryDB.coll.insert({_id: nDocs, x: 0}));
+rst.awaitReplication();
+assert.eq(nDocs + 1, secondaryDB.coll.find().itcount());
+
+// The collections are validated when the set is stopped.
+rst.stopSet();
+})();
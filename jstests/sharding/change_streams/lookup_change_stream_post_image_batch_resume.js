@@ -0,0 +1,80 @@
+/**
+ * Tests that an updateLookup change stream on mongos, which reads events ahead to look up their
+ * post-images together, reports the resume token of the last event it returned as the
+ * postBatchResumeToken of a full batch, so that resuming from it does not skip the events which
+ * were read ahead but not returned yet.
+ * @tags: [
+ *   uses_change_streams,
+ * ]
+ */
+(function() {
+"use strict";
+
+const nDocs = 10;
+const batchSize = 3;
+
+const st = new ShardingTest({
+    shards: 2,
+    mongos: 1,
+    rs: {nodes: 1},
+    other: {mongosOptions: {setParameter: {internalChangeStreamPostImageLookupBatchSize: nDocs}}}
+});
+
+const mongosDB = st.s0.getDB(jsTestName());
+const mongosColl = mongosDB.test;
+
+// Shard the collection so that its updates are merged from both shards.
+st.shardColl(mongosColl, {_id: 1}, {_id: nDocs / 2}, {_id: nDocs / 2}, mongosDB.getName());
+for (let i = 0; i < nDocs; i++) {
+    assert.commandWorked(mongosColl.insert({_id: i, updated: false}));
+}
+
+const changeStream = [{$changeStream: {fullDocument: "updateLookup"}}];
+const cursorId = assert
+                     .commandWorked(mongosDB.runCommand(
+                         {aggregate: mongosColl.getName(), pipeline: changeStream, cursor: {}}))
+                     .cursor.id;
+
+for (let i = 0; i < nDocs; i++) {
+    assert.commandWorked(mongosColl.update(
+        {_id: i}, {$set: {updated: true}}, {writeConcern: {w: "majority"}}));
+}
+
+function assertIsUpdateOf(event, id) {
+    assert.eq(event.operationType, "update", tojson(event));
+    assert.eq(event.documentKey, {_id: id}, tojson(event));
+    assert.eq(event.fullDocument, {_id: id, updated: true}, tojson(event));
+}
+
+// Read until a getMore returns a full batch, which leaves the events read ahead of it unreturned.
+let events = [];
+let postBatchResumeToken;
+assert.soon(() => {
+    const cursor = assert
+                       .commandWorked(mongosDB.runCommand({
+                           getMore: cursorId,
+                           collection: mongosColl.getName(),
+                           batchSize: batchSize
+                       }))
+                       .cursor;
+    events = events.concat(cursor.nextBatch);
+    postBatchResumeToken = cursor.postBatchResumeToken;
+    return cursor.nextBatch.length === batchSize;
+});
+assert.lt(events.length, nDocs, tojson(events));
+events.forEach((event, i) => assertIsUpdateOf(event, i));
+assert.eq(bsonWoCompare(postBatchResumeToken, events[events.length - 1]._id), 0);
+assert.commandWorked(
+    mongosDB.runCommand({killCursors: mongosColl.getName(), cursors: [cursorId]}));
+
+// A stream resumed from the postBatchResumeToken sees every update not returned yet.
+const resumedCursor =
+    mongosColl.watch([], {resumeAfter: postBatchResumeToken, fullDocument: "updateLookup"});
+for (let i = events.length; i < nDocs; i++) {
+    assert.soon(() => resumedCursor.hasNext());
+    assertIsUpdateOf(resumedCursor.next(), i);
+}
+resumedCursor.close();
+
+st.stop();
+})();
@@ -0,0 +1,105 @@
+/**
+ * Tests that a shard runs the $lookup sub-pipeline against its local collection when it is the only
+ * shard owning the foreign documents, rather than targeting itself through the routing table.
+ *
+ * @tags: [
+ *   requires_profiling,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/discover_topology.js");                       // For findNonConfigNodes.
+load("jstests/noPassthrough/libs/server_parameter_helpers.js");  // For setParameterOnAllHosts.
+
+const st = new ShardingTest({shards: 2, mongos: 1});
+
+setParameterOnAllHosts(
+    DiscoverTopology.findNonConfigNodes(st.s), "internalQueryAllowShardedLookup", true);
+
+const mongosDB = st.s.getDB(jsTestName());
+assert.commandWorked(mongosDB.adminCommand({enableSharding: mongosDB.getName()}));
+st.ensurePrimaryShard(mongosDB.getName(), st.shard0.shardName);
+
+const localColl = mongosDB.local;
+const foreignColl = mongosDB.foreign;
+const shard0DB = st.shard0.getDB(jsTestName());
+const shard1DB = st.shard1.getDB(jsTestName());
+
+const nDocs = 10;
+for (let i = 0; i < nDocs; i++) {
+    assert.commandWorked(localColl.insert({_id: i, foreignId: i}));
+    assert.commandWorked(foreignColl.insert({_id: i, key: i}));
+}
+
+const pipeline = [
+    {$lookup: {from: foreignColl.getName(), localField: "foreignId", foreignField: "key", as: "f"}},
+    {$sort: {_id: 1}},
+];
+
+function runLookup() {
+    const results = localColl.aggregate(pipeline).toArray();
+    assert.eq(results.length, nDocs, tojson(results));
+    for (let result of results) {
+        assert.eq([{_id: result._id, key: result._id}], result.f, tojson(result));
+    }
+}
+
+function resetProfiler(db) {
+    assert.commandWorked(db.setProfilingLevel(0));
+    db.system.profile.drop();
+    assert.commandWorked(db.setProfilingLevel(2));
+}
+
+/**
+ * Runs the $lookup and returns how many aggregates on the foreign collection each shard received.
+ * A first run refreshes any routing information made stale by the previous step.
+ */
+function countForeignAggregates() {
+    runLookup();
+    resetProfiler(shard0DB);
+    resetProfiler(shard1DB);
+    runLookup();
+    const filter = {"command.aggregate": foreignColl.getName()};
+    return [shard0DB.system.profile.find(filter).itcount(),
+            shard1DB.system.profile.find(filter).itcount()];
+}
+
+// The unsharded foreign collection lives on the primary shard, which runs the $lookup, so the
+// sub-pipelines read it directly.
+assert.eq([0, 0], countForeignAggregates());
+
+// With local reads disabled, the shard targets itself with one aggregate per sub-pipeline.
+assert.commandWorked(
+    st.shard0.adminCommand({setParameter: 1, internalQueryDisableCoLocatedSubpipelineReads: true}));
+assert.eq([nDocs, 0], countForeignAggregates());
+assert.commandWorked(st.shard0.adminCommand(
+    {setParameter: 1, internalQueryDisableCoLocatedSubpipelineReads: false}));
+
+// After a movePrimary the former primary no longer owns the unsharded collections. The $lookup
+// still finds every foreign document, and runs locally on the new primary shard.
+assert.commandWorked(
+    mongosDB.adminCommand({movePrimary: mongosDB.getName(), to: st.shard1.shardName}));
+assert.eq([0, 0], countForeignAggregates());
+assert.commandWorked(
+    mongosDB.adminCommand({movePrimary: mongosDB.getName(), to: st.shard0.shardName}));
+assert.eq([0, 0], countForeignAggregates());
+
+// Once the foreign collection is sharded with all of its chunks on the shard running the $lookup,
+// the sub-pipelines still read locally.
+assert.commandWorked(
+    mongosDB.adminCommand({shardCollection: foreignColl.getFullName(), key: {key: 1}}));
+assert.commandWorked(mongosDB.adminCommand({split: foreignColl.getFullName(), middle: {key: 5}}));
+assert.eq([0, 0], countForeignAggregates());
+
+// Moving half of the chunks away makes only the sub-pipelines for the other shard's keys remote.
+assert.commandWorked(mongosDB.adminCommand({
+    moveChunk: foreignColl.getFullName(),
+    find: {key: 5},
+    to: st.shard1.shardName,
+    _waitForDelete: true
+}));
+assert.eq([0, nDocs / 2], countForeignAggregates());
+
+st.stop();
+})();
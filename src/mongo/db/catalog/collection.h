@@ -370,11 +370,16 @@ public:
      * outside this Collection. The bulk loader is notified with the RecordId of the document
      * inserted into the RecordStore.
      *
+     * If 'recordStoreBulkLoader' is provided, the document is appended through it rather than
+     * inserted transactionally. See RecordStore::makeBulkLoader().
+     *
      * NOTE: It is up to caller to commit the indexes.
      */
-    virtual Status insertDocumentForBulkLoader(OperationContext* const opCtx,
-                                               const BSONObj& doc,
-                                               const OnRecordInsertedFn& onRecordInserted) = 0;
+    virtual Status insertDocumentForBulkLoader(
+        OperationContext* const opCtx,
+        const BSONObj& doc,
+        const OnRecordInsertedFn& onRecordInserted,
+        RecordStoreBulkLoader* recordStoreBulkLoader = nullptr) = 0;
 
     /**
      * Updates the document @ oldLocation with newDoc.
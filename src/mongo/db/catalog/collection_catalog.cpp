@@ -34,12 +34,14 @@
 
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/uncommitted_collections.h"
+#include "mongo/db/client.h"
 #include "mongo/db/concurrency/lock_manager_defs.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -263,9 +265,17 @@ Collection* CollectionCatalog::lookupCollectionByUUID(OperationContext* opCtx,
         return coll;
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto coll = _lookupCollectionByUUID(lock, uuid);
-    return (coll && coll->isCommitted()) ? coll : nullptr;
+    Collection* coll;
+    {
+        stdx::lock_guard<Latch> lock(_catalogLock);
+        coll = _lookupCollectionByUUID(lock, uuid);
+        if (!coll || !coll->isCommitted()) {
+            return nullptr;
+        }
+    }
+
+    _initializeIfDeferred(opCtx, uuid, coll);
+    return coll;
 }
 
 void CollectionCatalog::makeCollectionVisible(CollectionUUID uuid) {
@@ -291,10 +301,74 @@ Collection* CollectionCatalog::lookupCollectionByNamespace(OperationContext* opC
         return coll;
     }
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto it = _collections.find(nss);
-    auto coll = (it == _collections.end() ? nullptr : it->second);
-    return (coll && coll->isCommitted()) ? coll : nullptr;
+    Collection* coll;
+    {
+        stdx::lock_guard<Latch> lock(_catalogLock);
+        auto it = _collections.find(nss);
+        coll = (it == _collections.end() ? nullptr : it->second);
+        if (!coll || !coll->isCommitted()) {
+            return nullptr;
+        }
+    }
+
+    _initializeIfDeferred(opCtx, coll->uuid(), coll);
+    return coll;
+}
+
+void CollectionCatalog::_initializeIfDeferred(OperationContext* opCtx,
+                                              CollectionUUID uuid,
+                                              Collection* coll) const {
+    if (_numDeferredInitialization.load() == 0) {
+        return;
+    }
+
+    stdx::unique_lock<Latch> lk(_deferredInitLock);
+    while (true) {
+        auto it = _deferredInitialization.find(uuid);
+        if (it == _deferredInitialization.end()) {
+            return;
+        }
+        if (!it->second) {
+            it->second = true;
+            break;
+        }
+
+        // Another thread is initializing this collection. If it fails, the entry goes back to
+        // not being in progress and we try to initialize the collection ourselves.
+        opCtx->waitForConditionOrInterrupt(_deferredInitCV, lk, [&] {
+            auto it = _deferredInitialization.find(uuid);
+            return it == _deferredInitialization.end() || !it->second;
+        });
+    }
+    lk.unlock();
+
+    auto onFailure = makeGuard([&] {
+        stdx::lock_guard<Latch> lk(_deferredInitLock);
+        auto it = _deferredInitialization.find(uuid);
+        if (it != _deferredInitialization.end()) {
+            it->second = false;
+        }
+        _deferredInitCV.notify_all();
+    });
+
+    {
+        auto client = opCtx->getServiceContext()->makeClient("CollectionCatalog-initialize");
+        AlternativeClientRegion acr(client);
+        auto initOpCtx = cc().makeOperationContext();
+
+        LOGV2_DEBUG(5160000,
+                    1,
+                    "Initializing collection deferred at startup",
+                    "namespace"_attr = coll->ns(),
+                    "uuid"_attr = uuid);
+        coll->init(initOpCtx.get());
+    }
+
+    onFailure.dismiss();
+    stdx::lock_guard<Latch> guard(_deferredInitLock);
+    _deferredInitialization.erase(uuid);
+    _numDeferredInitialization.store(_deferredInitialization.size());
+    _deferredInitCV.notify_all();
 }
 
 boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationContext* opCtx,
@@ -513,6 +587,12 @@ std::unique_ptr<Collection> CollectionCatalog::deregisterCollection(CollectionUU
     // references to the erased element.
     _generationNumber++;
 
+    stdx::lock_guard<Latch> deferredInitLock(_deferredInitLock);
+    if (_deferredInitialization.erase(uuid)) {
+        _numDeferredInitialization.store(_deferredInitialization.size());
+        _deferredInitCV.notify_all();
+    }
+
     return coll;
 }
 
@@ -545,6 +625,41 @@ void CollectionCatalog::deregisterAllCollections() {
     _resourceInformation.clear();
 
     _generationNumber++;
+
+    stdx::lock_guard<Latch> deferredInitLock(_deferredInitLock);
+    _deferredInitialization.clear();
+    _numDeferredInitialization.store(0);
+    _deferredInitCV.notify_all();
+}
+
+void CollectionCatalog::deferCollectionInitialization(CollectionUUID uuid) {
+    invariant(isDeferredInitializationAllowed());
+    stdx::lock_guard<Latch> lock(_catalogLock);
+    auto coll = _lookupCollectionByUUID(lock, uuid);
+    invariant(coll);
+    invariant(!coll->isInitialized());
+
+    stdx::lock_guard<Latch> deferredInitLock(_deferredInitLock);
+    _deferredInitialization.emplace(uuid, false);
+    _numDeferredInitialization.store(_deferredInitialization.size());
+}
+
+bool CollectionCatalog::isDeferredInitializationAllowed() const {
+    return _deferredInitializationAllowed.load();
+}
+
+void CollectionCatalog::disallowDeferredInitialization() {
+    _deferredInitializationAllowed.store(false);
+}
+
+std::vector<CollectionUUID> CollectionCatalog::getCollectionsAwaitingInitialization() const {
+    stdx::lock_guard<Latch> lock(_deferredInitLock);
+    std::vector<CollectionUUID> ret;
+    ret.reserve(_deferredInitialization.size());
+    for (const auto& entry : _deferredInitialization) {
+        ret.push_back(entry.first);
+    }
+    return ret;
 }
 
 CollectionCatalog::iterator CollectionCatalog::begin(StringData db) const {
@@ -35,6 +35,8 @@
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/uuid.h"
 
@@ -134,11 +136,39 @@ public:
      */
     void deregisterAllCollections();
 
+    /**
+     * Marks the registered collection with 'uuid' as awaiting lazy initialization. Such a
+     * collection is initialized by the first lookupCollectionByUUID() or
+     * lookupCollectionByNamespace() call that returns it. Iteration and
+     * checkIfCollectionSatisfiable() do not initialize collections, so callers of those may only
+     * rely on catalog metadata (namespace, UUID, catalog id) unless they look the collection up.
+     */
+    void deferCollectionInitialization(CollectionUUID uuid);
+
+    /**
+     * Returns the UUIDs of all collections still awaiting lazy initialization.
+     */
+    std::vector<CollectionUUID> getCollectionsAwaitingInitialization() const;
+
+    /**
+     * Lazy initialization is only meant for the collections opened at startup. Once startup has
+     * handed the deferred collections over to background initialization, it calls
+     * disallowDeferredInitialization() so that catalogs reopened later, e.g. by rollback, are
+     * initialized eagerly again.
+     */
+    bool isDeferredInitializationAllowed() const;
+    void disallowDeferredInitialization();
+
     /**
      * This function gets the Collection pointer that corresponds to the CollectionUUID.
      * The required locks must be obtained prior to calling this function, or else the found
      * Collection pointer might no longer be valid when the call returns.
      *
+     * If the collection is awaiting lazy initialization, it is initialized before it is returned.
+     * The call then blocks for the duration of the initialization, or until a concurrent
+     * initialization of the same collection finishes, and throws if 'opCtx' is interrupted while
+     * waiting or if the initialization fails.
+     *
      * Returns nullptr if the 'uuid' is not known.
      */
     Collection* lookupCollectionByUUID(OperationContext* opCtx, CollectionUUID uuid) const;
@@ -156,6 +186,9 @@ public:
      * The required locks must be obtained prior to calling this function, or else the found
      * Collection pointer may no longer be valid when the call returns.
      *
+     * Like lookupCollectionByUUID(), may block on and throw from lazy initialization of the
+     * collection.
+     *
      * Returns nullptr if the namespace is unknown.
      */
     Collection* lookupCollectionByNamespace(OperationContext* opCtx,
@@ -288,6 +321,15 @@ private:
 
     Collection* _lookupCollectionByUUID(WithLock, CollectionUUID uuid) const;
 
+    /**
+     * Initializes 'coll' if it is awaiting lazy initialization, or waits for a concurrent
+     * initialization of it to finish. The initialization runs on a separate Client so that it
+     * neither reads at the caller's snapshot nor uses the caller's locks.
+     */
+    void _initializeIfDeferred(OperationContext* opCtx,
+                               CollectionUUID uuid,
+                               Collection* coll) const;
+
     const std::vector<CollectionUUID>& _getOrdering_inlock(const StringData& db,
                                                            const stdx::lock_guard<Latch>&);
     mutable mongo::Mutex _catalogLock;
@@ -342,5 +384,21 @@ private:
      * Simple database name to integer profile level map. Access protected by the _catalogLock.
      */
     DatabaseProfileLevelMap _databaseProfileLevels;
+
+    // Protects _deferredInitialization.
+    mutable Mutex _deferredInitLock = MONGO_MAKE_LATCH("CollectionCatalog::_deferredInitLock");
+    mutable stdx::condition_variable _deferredInitCV;
+
+    /**
+     * Collections awaiting lazy initialization, mapped to whether some thread is currently
+     * initializing them. Entries are removed once the collection is initialized or deregistered.
+     */
+    mutable stdx::unordered_map<CollectionUUID, bool, CollectionUUID::Hash> _deferredInitialization;
+
+    // Mirrors _deferredInitialization.size() so that lookups can skip '_deferredInitLock' once
+    // every collection has been initialized.
+    mutable AtomicWord<size_t> _numDeferredInitialization{0};
+
+    AtomicWord<bool> _deferredInitializationAllowed{true};
 };
 }  // namespace mongo
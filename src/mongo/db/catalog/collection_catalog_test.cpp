@@ -694,6 +694,93 @@ TEST_F(CollectionCatalogTest, GetAllCollectionNamesAndGetAllDbNamesWithUncommitt
     catalog.deregisterAllCollections();
 }
 
+/**
+ * A CollectionMock which counts its initializations, for testing deferred initialization.
+ */
+class InitCountingCollectionMock : public CollectionMock {
+public:
+    InitCountingCollectionMock(const NamespaceString& nss, CollectionUUID uuid)
+        : CollectionMock(nss), _uuid(uuid) {}
+
+    void init(OperationContext* opCtx) final {
+        ++numInits;
+    }
+
+    bool isInitialized() const final {
+        return numInits > 0;
+    }
+
+    UUID uuid() const final {
+        return _uuid;
+    }
+
+    int numInits = 0;
+
+private:
+    const UUID _uuid;
+};
+
+TEST_F(CollectionCatalogTest, DeferredCollectionIsInitializedOnLookupByUUID) {
+    auto uuid = CollectionUUID::gen();
+    auto mock = std::make_unique<InitCountingCollectionMock>(NamespaceString("dbA", "coll"), uuid);
+    auto coll = mock.get();
+    std::unique_ptr<Collection> collection = std::move(mock);
+    catalog.registerCollection(uuid, &collection);
+
+    catalog.deferCollectionInitialization(uuid);
+    ASSERT_EQ(catalog.getCollectionsAwaitingInitialization().size(), 1U);
+    ASSERT_EQ(coll->numInits, 0);
+
+    auto opCtx = makeOperationContext();
+    ASSERT_EQ(catalog.lookupCollectionByUUID(opCtx.get(), uuid), coll);
+    ASSERT_EQ(coll->numInits, 1);
+    ASSERT(catalog.getCollectionsAwaitingInitialization().empty());
+
+    // Subsequent lookups do not initialize the collection again.
+    ASSERT_EQ(catalog.lookupCollectionByUUID(opCtx.get(), uuid), coll);
+    ASSERT_EQ(coll->numInits, 1);
+}
+
+TEST_F(CollectionCatalogTest, DeferredCollectionIsInitializedOnLookupByNamespace) {
+    NamespaceString nss("dbA", "coll");
+    auto uuid = CollectionUUID::gen();
+    auto mock = std::make_unique<InitCountingCollectionMock>(nss, uuid);
+    auto coll = mock.get();
+    std::unique_ptr<Collection> collection = std::move(mock);
+    catalog.registerCollection(uuid, &collection);
+    catalog.deferCollectionInitialization(uuid);
+
+    // Resolving the namespace does not initialize the collection.
+    auto opCtx = makeOperationContext();
+    ASSERT_EQ(catalog.lookupNSSByUUID(opCtx.get(), uuid), nss);
+    ASSERT_EQ(coll->numInits, 0);
+
+    ASSERT_EQ(catalog.lookupCollectionByNamespace(opCtx.get(), nss), coll);
+    ASSERT_EQ(coll->numInits, 1);
+    ASSERT(catalog.getCollectionsAwaitingInitialization().empty());
+}
+
+TEST_F(CollectionCatalogTest, IteratingDoesNotInitializeDeferredCollections) {
+    auto uuid = CollectionUUID::gen();
+    auto mock = std::make_unique<InitCountingCollectionMock>(NamespaceString("dbA", "coll"), uuid);
+    auto coll = mock.get();
+    std::unique_ptr<Collection> collection = std::move(mock);
+    catalog.registerCollection(uuid, &collection);
+    catalog.deferCollectionInitialization(uuid);
+
+    int numCollections = 0;
+    for (auto it = catalog.begin("dbA"); it != catalog.end(); ++it) {
+        ASSERT_EQ(*it, coll);
+        ++numCollections;
+    }
+    ASSERT_EQ(numCollections, 1);
+    ASSERT_EQ(coll->numInits, 0);
+
+    // Dropping a collection which was never initialized forgets about it.
+    catalog.deregisterCollection(uuid);
+    ASSERT(catalog.getCollectionsAwaitingInitialization().empty());
+}
+
 class ForEachCollectionFromDbTest : public CatalogTestFixture {
 public:
     void createTestData() {
@@ -45,6 +45,7 @@
 #include "mongo/db/catalog/index_catalog_impl.h"
 #include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/catalog/index_key_validate.h"
+#include "mongo/db/catalog/oplog_namespace_index.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/d_concurrency.h"
@@ -464,6 +465,10 @@ Status CollectionImpl::insertDocumentsForOplog(OperationContext* opCtx,
     if (!status.isOK())
         return status;
 
+    if (OplogNamespaceIndex::isEnabled()) {
+        OplogNamespaceIndex::get(opCtx->getServiceContext()).onOplogWrites(*records);
+    }
+
     opCtx->recoveryUnit()->onCommit(
         [this](boost::optional<Timestamp>) { notifyCappedWaitersIfNeeded(); });
 
@@ -551,7 +556,8 @@ Status CollectionImpl::insertDocument(OperationContext* opCtx,
 
 Status CollectionImpl::insertDocumentForBulkLoader(OperationContext* opCtx,
                                                    const BSONObj& doc,
-                                                   const OnRecordInsertedFn& onRecordInserted) {
+                                                   const OnRecordInsertedFn& onRecordInserted,
+                                                   RecordStoreBulkLoader* recordStoreBulkLoader) {
 
     auto status = checkFailCollectionInsertsFailPoint(_ns, doc);
     if (!status.isOK()) {
@@ -567,8 +573,9 @@ Status CollectionImpl::insertDocumentForBulkLoader(OperationContext* opCtx,
 
     // Using timestamp 0 for these inserts, which are non-oplog so we don't have an appropriate
     // timestamp to use.
-    StatusWith<RecordId> loc =
-        _recordStore->insertRecord(opCtx, doc.objdata(), doc.objsize(), Timestamp());
+    StatusWith<RecordId> loc = recordStoreBulkLoader
+        ? recordStoreBulkLoader->insertRecord(doc.objdata(), doc.objsize())
+        : _recordStore->insertRecord(opCtx, doc.objdata(), doc.objsize(), Timestamp());
 
     if (!loc.isOK())
         return loc.getStatus();
@@ -639,6 +646,10 @@ Status CollectionImpl::_insertDocuments(OperationContext* opCtx,
     if (!status.isOK())
         return status;
 
+    if (_ns.isOplog() && OplogNamespaceIndex::isEnabled()) {
+        OplogNamespaceIndex::get(opCtx->getServiceContext()).onOplogWrites(records);
+    }
+
     std::vector<BsonRecord> bsonRecords;
     bsonRecords.reserve(count);
     int recordIndex = 0;
@@ -177,11 +177,15 @@ public:
      * outside this Collection. The bulk loader is notified with the RecordId of the document
      * inserted into the RecordStore.
      *
+     * If 'recordStoreBulkLoader' is provided, the document is appended through it rather than
+     * inserted transactionally. See RecordStore::makeBulkLoader().
+     *
      * NOTE: It is up to caller to commit the indexes.
      */
     Status insertDocumentForBulkLoader(OperationContext* opCtx,
                                        const BSONObj& doc,
-                                       const OnRecordInsertedFn& onRecordInserted) final;
+                                       const OnRecordInsertedFn& onRecordInserted,
+                                       RecordStoreBulkLoader* recordStoreBulkLoader) final;
 
     /**
      * Updates the document @ oldLocation with newDoc.
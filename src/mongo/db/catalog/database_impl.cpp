@@ -55,6 +55,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_builds_coordinator.h"
 #include "mongo/db/introspect.h"
 #include "mongo/db/op_observer.h"
@@ -73,6 +74,7 @@
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/system_index.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
@@ -127,6 +129,17 @@ void assertMovePrimaryInProgress(OperationContext* opCtx, NamespaceString const&
     }
 }
 
+/**
+ * Returns whether the durable catalog lists a TTL index for the collection with 'catalogId'. TTL
+ * indexes are registered with the TTLCollectionCache when the IndexCatalog is initialized.
+ */
+bool hasTTLIndex(OperationContext* opCtx, RecordId catalogId) {
+    const auto md = DurableCatalog::get(opCtx)->getMetaData(opCtx, catalogId);
+    return std::any_of(md.indexes.begin(), md.indexes.end(), [](const auto& index) {
+        return index.spec.hasField(IndexDescriptor::kExpireAfterSecondsFieldName);
+    });
+}
+
 }  // namespace
 
 Status DatabaseImpl::validateDBName(StringData dbname) {
@@ -169,13 +182,26 @@ void DatabaseImpl::init(OperationContext* const opCtx) const {
         uasserted(10028, status.toString());
     }
 
+    // Collections on internal databases are few and needed right away, so only user collections
+    // are left for lazy initialization. Repair initializes collections itself. Collections with a
+    // TTL index are initialized eagerly so the TTL monitor finds them on its first pass.
     auto& catalog = CollectionCatalog::get(opCtx);
+    const bool deferInitialization = gLazyCollectionInitialization &&
+        catalog.isDeferredInitializationAllowed() && !storageGlobalParams.repair &&
+        !NamespaceString(_name).isOnInternalDb();
+
     for (const auto& uuid : catalog.getAllCollectionUUIDsFromDb(_name)) {
         auto collection = catalog.lookupCollectionByUUID(opCtx, uuid);
         invariant(collection);
         // If this is called from the repair path, the collection is already initialized.
-        if (!collection->isInitialized())
+        if (collection->isInitialized())
+            continue;
+
+        if (deferInitialization && !hasTTLIndex(opCtx, collection->getCatalogId())) {
+            catalog.deferCollectionInitialization(uuid);
+        } else {
             collection->init(opCtx);
+        }
     }
 
     // At construction time of the viewCatalog, the CollectionCatalog map wasn't initialized yet,
@@ -0,0 +1,155 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/lazy_collection_initializer.h"
+
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+class LazyCollectionInitializer {
+public:
+    explicit LazyCollectionInitializer(std::vector<CollectionUUID> uuids)
+        : _uuids(std::move(uuids)), _remaining(_uuids.size()), _pool(_makeThreadPoolOptions()) {}
+
+    void startup() {
+        LOGV2(5160001,
+              "Starting background initialization of collections deferred at startup",
+              "numCollections"_attr = _uuids.size(),
+              "numThreads"_attr = gLazyCollectionInitializationThreads);
+
+        _pool.startup();
+        for (const auto& uuid : _uuids) {
+            _pool.schedule([this, uuid](Status status) {
+                if (!status.isOK() || _shuttingDown.load()) {
+                    return;
+                }
+                _initializeCollection(uuid);
+            });
+        }
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        _pool.shutdown();
+        _pool.join();
+    }
+
+private:
+    static ThreadPool::Options _makeThreadPoolOptions() {
+        ThreadPool::Options options;
+        options.poolName = "LazyCollectionInitializer";
+        options.minThreads = 0;
+        options.maxThreads = gLazyCollectionInitializationThreads;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName.c_str());
+            stdx::lock_guard<Client> lk(cc());
+            cc().setSystemOperationKillable(lk);
+        };
+        return options;
+    }
+
+    void _initializeCollection(const CollectionUUID& uuid) {
+        auto opCtx = cc().makeOperationContext();
+        auto& catalog = CollectionCatalog::get(opCtx.get());
+
+        // The collection may have been dropped or initialized by a lookup in the meantime, in
+        // which case there is nothing left to do. Otherwise, the lookup done while acquiring the
+        // collection lock initializes it.
+        if (auto nss = catalog.lookupNSSByUUID(opCtx.get(), uuid)) {
+            try {
+                AutoGetCollection autoColl(
+                    opCtx.get(), NamespaceStringOrUUID(nss->db().toString(), uuid), MODE_IS);
+            } catch (const DBException& ex) {
+                LOGV2_DEBUG(5160002,
+                            1,
+                            "Skipping background initialization of collection",
+                            "uuid"_attr = uuid,
+                            "error"_attr = ex.toStatus());
+            }
+        }
+
+        if (_remaining.subtractAndFetch(1) == 0) {
+            LOGV2(5160003,
+                  "Finished background initialization of collections deferred at startup",
+                  "numCollections"_attr = _uuids.size(),
+                  "durationMillis"_attr = _timer.millis());
+        }
+    }
+
+    const std::vector<CollectionUUID> _uuids;
+    AtomicWord<size_t> _remaining;
+    AtomicWord<bool> _shuttingDown{false};
+    Timer _timer;
+    ThreadPool _pool;
+};
+
+const auto getLazyCollectionInitializer =
+    ServiceContext::declareDecoration<std::unique_ptr<LazyCollectionInitializer>>();
+
+}  // namespace
+
+void startLazyCollectionInitializer(ServiceContext* serviceContext) {
+    auto& catalog = CollectionCatalog::get(serviceContext);
+    catalog.disallowDeferredInitialization();
+
+    auto uuids = catalog.getCollectionsAwaitingInitialization();
+    if (uuids.empty()) {
+        return;
+    }
+
+    auto& initializer = getLazyCollectionInitializer(serviceContext);
+    invariant(!initializer);
+    initializer = std::make_unique<LazyCollectionInitializer>(std::move(uuids));
+    initializer->startup();
+}
+
+void shutdownLazyCollectionInitializer(ServiceContext* serviceContext) {
+    auto& initializer = getLazyCollectionInitializer(serviceContext);
+    if (initializer) {
+        initializer->shutdown();
+        initializer.reset();
+    }
+}
+
+}  // namespace mongo
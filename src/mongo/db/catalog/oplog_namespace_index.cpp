@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/oplog_namespace_index.h"
+
+#include <algorithm>
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/record_store.h"
+
+namespace mongo {
+namespace {
+
+const auto getOplogNamespaceIndex = ServiceContext::declareDecoration<OplogNamespaceIndex>();
+
+}  // namespace
+
+OplogNamespaceIndex& OplogNamespaceIndex::get(ServiceContext* serviceContext) {
+    return getOplogNamespaceIndex(serviceContext);
+}
+
+bool OplogNamespaceIndex::isEnabled() {
+    return internalChangeStreamOplogNamespaceIndexMaxEntries > 0;
+}
+
+void OplogNamespaceIndex::onOplogWrites(const std::vector<Record>& records) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (const auto& record : records) {
+        const auto entry = record.data.toBson();
+        const auto tsElem = entry["ts"];
+        if (tsElem.type() != BSONType::bsonTimestamp) {
+            continue;
+        }
+        const auto ts = tsElem.timestamp();
+        if (!_indexedFrom || ts < *_indexedFrom) {
+            _indexedFrom = ts;
+        }
+
+        const auto nsElem = entry["ns"];
+        const auto op = entry["op"].valueStringDataSafe();
+        if (op == "c"_sd || nsElem.type() != BSONType::String) {
+            _add(lk, kAllNamespacesKey, ts);
+            continue;
+        }
+
+        const auto ns = nsElem.valueStringData();
+        if (ns.empty()) {
+            // Periodic no-ops.
+            continue;
+        }
+        _add(lk, ns, ts);
+        _add(lk, nsToDatabaseSubstring(ns), ts);
+    }
+    _evict(lk);
+}
+
+boost::optional<Timestamp> OplogNamespaceIndex::nextRelevantTimestamp(const NamespaceString& nss,
+                                                                      Timestamp from,
+                                                                      Timestamp readTs) const {
+    if (nss.isAdminDB()) {
+        return boost::none;
+    }
+    const auto key = nss.isCollectionlessAggregateNS() ? nss.db() : StringData(nss.ns());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (!_indexedFrom || from < *_indexedFrom) {
+        return boost::none;
+    }
+    if (from <= _evictedThrough(lk, key) || from <= _evictedThrough(lk, kAllNamespacesKey)) {
+        return boost::none;
+    }
+
+    auto goal = readTs;
+    for (auto k : {key, kAllNamespacesKey}) {
+        auto it = _namespaces.find(k.toString());
+        if (it == _namespaces.end()) {
+            continue;
+        }
+        auto next = it->second.timestamps.lower_bound(from);
+        if (next != it->second.timestamps.end()) {
+            goal = std::min(goal, *next);
+        }
+    }
+
+    if (goal <= from) {
+        return boost::none;
+    }
+    return goal;
+}
+
+size_t OplogNamespaceIndex::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _indexOrder.size();
+}
+
+void OplogNamespaceIndex::_add(WithLock, StringData key, Timestamp ts) {
+    auto& entries = _namespaces[key.toString()];
+    if (entries.timestamps.insert(ts).second) {
+        _indexOrder.emplace_back(key.toString(), ts);
+    }
+}
+
+void OplogNamespaceIndex::_evict(WithLock) {
+    const auto maxEntries =
+        static_cast<size_t>(internalChangeStreamOplogNamespaceIndexMaxEntries);
+    while (_indexOrder.size() > maxEntries) {
+        const auto& [key, ts] = _indexOrder.front();
+        auto it = _namespaces.find(key);
+        invariant(it != _namespaces.end());
+        auto& entries = it->second;
+        entries.timestamps.erase(ts);
+        entries.evictedThrough = std::max(entries.evictedThrough, ts);
+        if (entries.timestamps.empty()) {
+            _removedNamespacesEvictedThrough =
+                std::max(_removedNamespacesEvictedThrough, entries.evictedThrough);
+            _namespaces.erase(it);
+        }
+        _indexOrder.pop_front();
+    }
+}
+
+Timestamp OplogNamespaceIndex::_evictedThrough(WithLock, StringData key) const {
+    auto it = _namespaces.find(key.toString());
+    return it == _namespaces.end()
+        ? _removedNamespacesEvictedThrough
+        : std::max(it->second.evictedThrough, _removedNamespacesEvictedThrough);
+}
+
+}  // namespace mongo
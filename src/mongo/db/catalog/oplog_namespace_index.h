@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+
+namespace mongo {
+
+struct Record;
+class ServiceContext;
+
+/**
+ * An in-memory index from namespace to the timestamps of the oplog entries written on this node
+ * for that namespace, used by change streams on a single collection or database to seek past the
+ * stretches of oplog that can't contain any event for them, instead of scanning them.
+ *
+ * CRUD entries are indexed under both their collection and their database. Command entries,
+ * which include transactions, renames and drops, are indexed under every namespace, as are any
+ * entries the index can't attribute to a single namespace.
+ *
+ * The index is bounded by 'internalChangeStreamOplogNamespaceIndexMaxEntries', past which the
+ * oldest entries are evicted. The index only knows about entries written since startup and since
+ * the last eviction for each namespace, and never lets a change stream skip anything it does not
+ * know about.
+ */
+class OplogNamespaceIndex {
+    OplogNamespaceIndex(const OplogNamespaceIndex&) = delete;
+    OplogNamespaceIndex& operator=(const OplogNamespaceIndex&) = delete;
+
+public:
+    OplogNamespaceIndex() = default;
+
+    static OplogNamespaceIndex& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns whether the index is enabled, that is, whether
+     * 'internalChangeStreamOplogNamespaceIndexMaxEntries' is non-zero.
+     */
+    static bool isEnabled();
+
+    /**
+     * Indexes the oplog entries in 'records', which are being written to the oplog. Must be called
+     * before the write commits, so that an entry is indexed before it can be read.
+     */
+    void onOplogWrites(const std::vector<Record>& records);
+
+    /**
+     * For a change stream on 'nss' that has read the oplog up to, but not including, 'from',
+     * returns a timestamp 'goal' in ('from', 'readTs'] such that no entry in ['from', 'goal') can
+     * be relevant to the change stream. 'readTs' must be a timestamp at or before which all oplog
+     * entries are committed.
+     *
+     * Returns boost::none if there is nothing the change stream can skip, or if the change stream
+     * is on the whole cluster.
+     */
+    boost::optional<Timestamp> nextRelevantTimestamp(const NamespaceString& nss,
+                                                     Timestamp from,
+                                                     Timestamp readTs) const;
+
+    /**
+     * Returns the number of indexed entries.
+     */
+    size_t size() const;
+
+private:
+    struct NamespaceEntries {
+        // Timestamps of the indexed entries for the namespace.
+        std::set<Timestamp> timestamps;
+
+        // The latest timestamp evicted for the namespace. Entries at or before it may be missing.
+        Timestamp evictedThrough;
+    };
+
+    void _add(WithLock, StringData key, Timestamp ts);
+
+    void _evict(WithLock);
+
+    Timestamp _evictedThrough(WithLock, StringData key) const;
+
+    // The key under which entries that are relevant to every namespace are indexed.
+    static constexpr StringData kAllNamespacesKey = ""_sd;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogNamespaceIndex::_mutex");
+
+    // The timestamp of the first entry indexed. Entries before it were written before startup.
+    boost::optional<Timestamp> _indexedFrom;
+
+    stdx::unordered_map<std::string, NamespaceEntries> _namespaces;
+
+    // Every indexed (key, timestamp) pair, in the order they were indexed, for eviction.
+    std::deque<std::pair<std::string, Timestamp>> _indexOrder;
+
+    // The latest timestamp evicted for any namespace that no longer has any indexed entry.
+    Timestamp _removedNamespacesEvictedThrough;
+};
+
+}  // namespace mongo
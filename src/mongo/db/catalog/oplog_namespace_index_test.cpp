@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/oplog_namespace_index.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class OplogNamespaceIndexTest : public unittest::Test {
+public:
+    void setUp() override {
+        _originalMaxEntries = internalChangeStreamOplogNamespaceIndexMaxEntries;
+        internalChangeStreamOplogNamespaceIndexMaxEntries = 1000;
+    }
+
+    void tearDown() override {
+        internalChangeStreamOplogNamespaceIndexMaxEntries = _originalMaxEntries;
+    }
+
+protected:
+    // Indexes one oplog entry per (op, ns) pair, at consecutive timestamps starting at 'first'.
+    void write(unsigned first, std::vector<std::pair<std::string, std::string>> ops) {
+        std::vector<BSONObj> entries;
+        for (const auto& [op, ns] : ops) {
+            entries.push_back(BSON("ts" << Timestamp(first++, 0) << "op" << op << "ns" << ns
+                                        << "o" << BSONObj()));
+        }
+        std::vector<Record> records;
+        for (const auto& entry : entries) {
+            records.push_back({RecordId(), RecordData(entry.objdata(), entry.objsize())});
+        }
+        _index.onOplogWrites(records);
+    }
+
+    boost::optional<Timestamp> next(StringData ns, unsigned from, unsigned readTs = 100) {
+        return _index.nextRelevantTimestamp(
+            NamespaceString(ns), Timestamp(from, 0), Timestamp(readTs, 0));
+    }
+
+    OplogNamespaceIndex _index;
+
+private:
+    long long _originalMaxEntries = 0;
+};
+
+TEST_F(OplogNamespaceIndexTest, SkipsToTheNextEntryForTheNamespace) {
+    write(10, {{"i", "test.a"}, {"i", "test.b"}, {"u", "test.b"}, {"d", "test.a"}});
+
+    ASSERT(next("test.a", 10) == boost::none);
+    ASSERT(next("test.a", 11) == Timestamp(13, 0));
+    ASSERT(next("test.b", 10) == Timestamp(11, 0));
+    ASSERT(next("test.b", 13) == Timestamp(100, 0));
+    ASSERT(next("test.c", 10) == Timestamp(100, 0));
+    ASSERT(next("other.a", 10) == Timestamp(100, 0));
+}
+
+TEST_F(OplogNamespaceIndexTest, NeverSkipsPastTheReadTimestamp) {
+    write(10, {{"i", "test.a"}, {"i", "test.b"}});
+    ASSERT(next("test.c", 10, 11) == Timestamp(11, 0));
+    ASSERT(next("test.c", 11, 11) == boost::none);
+}
+
+TEST_F(OplogNamespaceIndexTest, DatabaseStreamsSeeEntriesForAllCollections) {
+    write(10, {{"i", "test.a"}, {"i", "other.a"}, {"i", "test.b"}});
+    ASSERT(next("test.$cmd.aggregate", 10) == boost::none);
+    ASSERT(next("test.$cmd.aggregate", 11) == Timestamp(12, 0));
+    ASSERT(next("other.$cmd.aggregate", 12) == Timestamp(100, 0));
+}
+
+TEST_F(OplogNamespaceIndexTest, CommandsAreRelevantToEveryNamespace) {
+    write(10, {{"i", "test.a"}, {"c", "admin.$cmd"}, {"n", ""}, {"i", "test.a"}});
+    ASSERT(next("test.b", 10) == Timestamp(11, 0));
+    ASSERT(next("test.b", 12) == Timestamp(100, 0));
+}
+
+TEST_F(OplogNamespaceIndexTest, ClusterWideStreamsNeverSkip) {
+    write(10, {{"i", "test.a"}});
+    ASSERT(next("admin.$cmd.aggregate", 11) == boost::none);
+}
+
+TEST_F(OplogNamespaceIndexTest, NeverSkipsEntriesWrittenBeforeTheFirstIndexedEntry) {
+    ASSERT(next("test.a", 10) == boost::none);
+    write(10, {{"i", "test.a"}});
+    ASSERT(next("test.b", 9) == boost::none);
+    ASSERT(next("test.b", 10) == Timestamp(100, 0));
+}
+
+TEST_F(OplogNamespaceIndexTest, NeverSkipsEvictedEntries) {
+    internalChangeStreamOplogNamespaceIndexMaxEntries = 4;
+
+    // Each CRUD entry is indexed under its collection and its database.
+    write(10, {{"i", "test.a"}, {"i", "test.b"}, {"i", "test.b"}});
+    ASSERT_EQ(4U, _index.size());
+
+    // The entry for test.a was evicted: nothing at or before it can be skipped.
+    ASSERT(next("test.c", 10) == boost::none);
+    ASSERT(next("test.c", 11) == Timestamp(100, 0));
+    ASSERT(next("test.b", 13) == Timestamp(100, 0));
+}
+
+}  // namespace
+}  // namespace mongo
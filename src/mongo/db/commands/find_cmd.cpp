@@ -411,6 +411,9 @@ public:
                 opCtx->recoveryUnit()->setReadOnce(true);
             }
 
+            FindCommon::allowReadSnapshotReuseIfEligible(opCtx,
+                                                         cq->getQueryRequest().isTailable());
+
             // Get the execution plan for the query.
             bool permitYield = true;
             auto exec =
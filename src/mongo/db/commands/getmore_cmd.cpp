@@ -505,6 +505,7 @@ public:
                 // execution to assume read data will not be needed again and need not be cached.
                 opCtx->recoveryUnit()->setReadOnce(true);
             }
+            FindCommon::allowReadSnapshotReuseIfEligible(opCtx, cursorPin->isTailable());
             exec->reattachToOperationContext(opCtx);
             exec->restoreState();
 
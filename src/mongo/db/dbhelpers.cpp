@@ -48,6 +48,8 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/repl/local_oplog_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
@@ -292,4 +294,29 @@ void Helpers::emptyCollection(OperationContext* opCtx, const NamespaceString& ns
     deleteObjects(opCtx, collection, nss, BSONObj(), false);
 }
 
+void Helpers::deleteWithReservedOplogSlots(OperationContext* opCtx,
+                                           const NamespaceString& nss,
+                                           size_t count,
+                                           const std::function<void(size_t)>& deleteOne) {
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+    invariant(count > 0);
+
+    std::vector<OplogSlot> oplogSlots;
+    if (!repl::ReplicationCoordinator::get(opCtx)->isOplogDisabledFor(opCtx, nss)) {
+        oplogSlots = repl::LocalOplogInfo::get(opCtx)->getNextOpTimes(opCtx, count);
+    }
+
+    // A delete which matches no document leaves its slot unused, so the slot is reset for every
+    // delete, and once they are all done.
+    auto& reservedSlot = OpObserver::ReservedDeleteSlot::get(opCtx).slot;
+    ON_BLOCK_EXIT([&] { reservedSlot = boost::none; });
+    for (size_t i = 0; i < count; ++i) {
+        if (!oplogSlots.empty()) {
+            uassertStatusOK(opCtx->recoveryUnit()->setTimestamp(oplogSlots[i].getTimestamp()));
+            reservedSlot = oplogSlots[i];
+        }
+        deleteOne(i);
+    }
+}
+
 }  // namespace mongo
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/record_id.h"
 
@@ -155,6 +157,17 @@ struct Helpers {
      * Does not oplog the operation.
      */
     static void emptyCollection(OperationContext* opCtx, const NamespaceString& nss);
+
+    /**
+     * Performs 'count' replicated deletes from 'nss' in the caller's WriteUnitOfWork by calling
+     * 'deleteOne' with the index of each. The oplog slots of all of them are reserved in one call,
+     * and each delete is timestamped with its own slot, see OpObserver::ReservedDeleteSlot. Every
+     * call of 'deleteOne' must delete at most one document, and must not record its pre-image.
+     */
+    static void deleteWithReservedOplogSlots(OperationContext* opCtx,
+                                             const NamespaceString& nss,
+                                             size_t count,
+                                             const std::function<void(size_t)>& deleteOne);
 };
 
 }  // namespace mongo
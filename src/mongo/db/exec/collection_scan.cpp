@@ -35,10 +35,12 @@
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/oplog_namespace_index.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
+#include "mongo/db/exec/shared_oplog_reader.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/repl/optime.h"
@@ -98,7 +100,41 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    const bool useSharedOplogReader = shouldUseSharedOplogReader();
+    if (!useSharedOplogReader) {
+        _sharedOplogEntries.clear();
+    } else if (!_lastSeenId.isNull()) {
+        // The scan that published an entry may have read at a newer majority committed snapshot.
+        // Only entries visible in this scan's own snapshot are taken, so that its cursor can later
+        // be repositioned on the last of them.
+        boost::optional<RecordId> upTo;
+        if (auto readTs = opCtx()->recoveryUnit()->getPointInTimeReadTimestamp()) {
+            if (auto readTsId = oploghack::keyForOptime(*readTs); readTsId.isOK()) {
+                upTo = readTsId.getValue();
+            }
+        }
+        if (_sharedOplogEntries.empty() && upTo) {
+            SharedOplogReader::get(opCtx()->getServiceContext())
+                .getEntriesAfter(collection()->uuid(),
+                                 _lastSeenId,
+                                 *upTo,
+                                 kSharedOplogReaderBatchSize,
+                                 &_sharedOplogEntries);
+        }
+        if (!_sharedOplogEntries.empty()) {
+            auto entry = std::move(_sharedOplogEntries.front());
+            _sharedOplogEntries.pop_front();
+            ++_specificStats.docsFromSharedOplogReader;
+
+            // Our own cursor is now behind. When we next need it, it is recreated and positioned
+            // on '_lastSeenId', as for a tailable cursor that hit EOF.
+            _cursor.reset();
+            return returnRecord(entry.id, std::move(entry.obj), out);
+        }
+    }
+
     boost::optional<Record> record;
+    bool recordFollowsLastSeenId = false;
     const bool needToMakeCursor = !_cursor;
     try {
         if (needToMakeCursor) {
@@ -138,6 +174,7 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
                                             << "tailable cursor position. "
                                             << "Last seen record id: " << _lastSeenId);
                 }
+                _repositionedOnLastSeenId = true;
             }
 
             if (_params.resumeAfterRecordId) {
@@ -163,9 +200,12 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         }
 
         if (_lastSeenId.isNull() && _params.minTs) {
+            // A change stream may not need to read anything before a later entry.
+            record = seekToNextRelevantOplogEntry(*_params.minTs);
+
             // See if the RecordStore supports the oplogStartHack.
             StatusWith<RecordId> goal = oploghack::keyForOptime(*_params.minTs);
-            if (goal.isOK()) {
+            if (!record && goal.isOK()) {
                 boost::optional<RecordId> startLoc =
                     collection()->getRecordStore()->oplogStartHack(opCtx(), goal.getValue());
                 if (startLoc && !startLoc->isNull()) {
@@ -173,10 +213,15 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
                     record = _cursor->seekExact(*startLoc);
                 }
             }
+        } else if (_repositionedOnLastSeenId) {
+            _repositionedOnLastSeenId = false;
+            record = seekToNextRelevantOplogEntry(
+                Timestamp(static_cast<unsigned long long>(_lastSeenId.repr()) + 1));
         }
 
         if (!record) {
             record = _cursor->next();
+            recordFollowsLastSeenId = !_lastSeenId.isNull();
         }
     } catch (const WriteConflictException&) {
         // Leave us in a state to try again next time.
@@ -199,26 +244,93 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    _lastSeenId = record->id;
+    auto obj = record->data.releaseToBson();
+    if (useSharedOplogReader && recordFollowsLastSeenId) {
+        // Let the change streams trailing this one take this entry from memory.
+        obj = obj.getOwned();
+        SharedOplogReader::get(opCtx()->getServiceContext())
+            .publish(collection()->uuid(), _lastSeenId, record->id, obj);
+    }
+
+    return returnRecord(record->id, std::move(obj), out);
+}
+
+bool CollectionScan::shouldUseSharedOplogReader() const {
+    // Only change streams tail the oplog while tracking the latest oplog timestamp. Entries read
+    // at the majority committed snapshot can't be rolled back, so they can be handed to any other
+    // change stream.
+    return _params.tailable && _params.shouldTrackLatestOplogTimestamp &&
+        SharedOplogReader::isEnabled() &&
+        opCtx()->recoveryUnit()->getTimestampReadSource() ==
+        RecoveryUnit::ReadSource::kMajorityCommitted;
+}
+
+boost::optional<Record> CollectionScan::seekToNextRelevantOplogEntry(Timestamp from) {
+    if (!_params.tailable || !_params.shouldTrackLatestOplogTimestamp ||
+        !OplogNamespaceIndex::isEnabled()) {
+        return boost::none;
+    }
+
+    // Every oplog entry at or before the majority committed snapshot is committed, and was
+    // therefore indexed before it could be read.
+    auto recoveryUnit = opCtx()->recoveryUnit();
+    if (recoveryUnit->getTimestampReadSource() != RecoveryUnit::ReadSource::kMajorityCommitted) {
+        return boost::none;
+    }
+    auto readTs = recoveryUnit->getPointInTimeReadTimestamp();
+    if (!readTs) {
+        return boost::none;
+    }
+
+    // The change stream is on the namespace of the expression context; the scan is on the oplog.
+    auto goal = OplogNamespaceIndex::get(opCtx()->getServiceContext())
+                    .nextRelevantTimestamp(expCtx()->ns, from, *readTs);
+    if (!goal) {
+        return boost::none;
+    }
+
+    StatusWith<RecordId> goalId = oploghack::keyForOptime(*goal);
+    if (!goalId.isOK()) {
+        return boost::none;
+    }
+    boost::optional<RecordId> startLoc =
+        collection()->getRecordStore()->oplogStartHack(opCtx(), goalId.getValue());
+    if (!startLoc || startLoc->isNull() || (!_lastSeenId.isNull() && *startLoc <= _lastSeenId)) {
+        return boost::none;
+    }
+
+    LOGV2_DEBUG(5173000,
+                3,
+                "Skipping oplog entries that are not relevant to the change stream",
+                "from"_attr = from,
+                "to"_attr = *goal);
+    ++_specificStats.oplogSeeksPastIrrelevantEntries;
+    return _cursor->seekExact(*startLoc);
+}
+
+PlanStage::StageState CollectionScan::returnRecord(const RecordId& recordId,
+                                                   BSONObj obj,
+                                                   WorkingSetID* out) {
+    _lastSeenId = recordId;
     if (_params.shouldTrackLatestOplogTimestamp) {
-        setLatestOplogEntryTimestamp(*record);
+        setLatestOplogEntryTimestamp(obj);
     }
 
     WorkingSetID id = _workingSet->allocate();
     WorkingSetMember* member = _workingSet->get(id);
-    member->recordId = record->id;
-    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson());
+    member->recordId = recordId;
+    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), std::move(obj));
     _workingSet->transitionToRecordIdAndObj(id);
 
     return returnIfMatches(member, id, out);
 }
 
-void CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
-    auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
+void CollectionScan::setLatestOplogEntryTimestamp(const BSONObj& obj) {
+    auto tsElem = obj[repl::OpTime::kTimestampFieldName];
     uassert(ErrorCodes::Error(4382100),
             str::stream() << "CollectionScan was asked to track latest operation time, "
                              "but found a result without a valid 'ts' field: "
-                          << record.data.toBson().toString(),
+                          << obj.toString(),
             tsElem.type() == BSONType::bsonTimestamp);
     _latestOplogEntryTimestamp = std::max(_latestOplogEntryTimestamp, tsElem.timestamp());
 }
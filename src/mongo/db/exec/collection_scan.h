@@ -29,10 +29,12 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/exec/shared_oplog_reader.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
 
@@ -94,11 +96,34 @@ private:
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
     /**
-     * Extracts the timestamp from the 'ts' field of 'record', and sets '_latestOplogEntryTimestamp'
+     * Makes 'obj', the record with id 'recordId', the last record seen by this scan and returns it
+     * through returnIfMatches().
+     */
+    StageState returnRecord(const RecordId& recordId, BSONObj obj, WorkingSetID* out);
+
+    /**
+     * Extracts the timestamp from the 'ts' field of 'obj', and sets '_latestOplogEntryTimestamp'
      * to that time if it isn't already greater. Throws an exception if the 'ts' field cannot be
      * extracted.
      */
-    void setLatestOplogEntryTimestamp(const Record& record);
+    void setLatestOplogEntryTimestamp(const BSONObj& obj);
+
+    /**
+     * Returns whether this scan is a change stream scan of the oplog that exchanges entries with
+     * the other change streams through the SharedOplogReader.
+     */
+    bool shouldUseSharedOplogReader() const;
+
+    /**
+     * For a change stream scan of the oplog that has read everything before 'from', seeks the
+     * cursor past the following entries that the OplogNamespaceIndex shows can't be relevant to
+     * the change stream. Returns the record the cursor was moved to, or boost::none if there is
+     * nothing to skip, in which case the cursor is left where it was.
+     */
+    boost::optional<Record> seekToNextRelevantOplogEntry(Timestamp from);
+
+    // The number of entries taken from the SharedOplogReader at a time.
+    static constexpr size_t kSharedOplogReaderBatchSize = 64;
 
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
@@ -117,6 +142,13 @@ private:
 
     RecordId _lastSeenId;  // Null if nothing has been returned from _cursor yet.
 
+    // Entries following '_lastSeenId' that were taken from the SharedOplogReader but not yet
+    // returned.
+    std::deque<SharedOplogReader::Entry> _sharedOplogEntries;
+
+    // Whether the cursor was just recreated and positioned on '_lastSeenId'.
+    bool _repositionedOnLastSeenId = false;
+
     // If _params.shouldTrackLatestOplogTimestamp is set and the collection is the oplog, the latest
     // timestamp seen in the collection.  Otherwise, this is a null timestamp.
     Timestamp _latestOplogEntryTimestamp;
@@ -236,6 +236,13 @@ struct CollectionScanStats : public SpecificStats {
     // How many documents did we check against our filter?
     size_t docsTested;
 
+    // How many of the documents checked were taken from the SharedOplogReader rather than read
+    // from the collection?
+    size_t docsFromSharedOplogReader{0};
+
+    // How many times did we seek past oplog entries that can't be relevant to a change stream?
+    size_t oplogSeeksPastIrrelevantEntries{0};
+
     // >0 if we're traversing the collection forwards. <0 if we're traversing it
     // backwards.
     int direction;
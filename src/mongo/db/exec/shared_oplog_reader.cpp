@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/shared_oplog_reader.h"
+
+#include <algorithm>
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getSharedOplogReader = ServiceContext::declareDecoration<SharedOplogReader>();
+
+}  // namespace
+
+SharedOplogReader& SharedOplogReader::get(ServiceContext* serviceContext) {
+    return getSharedOplogReader(serviceContext);
+}
+
+bool SharedOplogReader::isEnabled() {
+    return internalChangeStreamSharedOplogReaderBufferBytes.load() > 0;
+}
+
+void SharedOplogReader::getEntriesAfter(const UUID& oplogUUID,
+                                        const RecordId& after,
+                                        const RecordId& upTo,
+                                        size_t maxEntries,
+                                        std::deque<Entry>* out) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_entries.empty() || _oplogUUID != oplogUUID) {
+        return;
+    }
+
+    auto it = _entries.begin();
+    if (after != _firstPrevId) {
+        it = std::lower_bound(
+            _entries.begin(), _entries.end(), after, [](const Entry& entry, const RecordId& id) {
+                return entry.id < id;
+            });
+        if (it == _entries.end() || it->id != after) {
+            return;
+        }
+        ++it;
+    }
+
+    for (; it != _entries.end() && it->id <= upTo && maxEntries > 0; ++it, --maxEntries) {
+        out->push_back(*it);
+    }
+}
+
+void SharedOplogReader::publish(const UUID& oplogUUID,
+                                const RecordId& prevId,
+                                const RecordId& id,
+                                const BSONObj& obj) {
+    invariant(obj.isOwned());
+    invariant(prevId < id);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_oplogUUID != oplogUUID) {
+        _reset(lk, oplogUUID, prevId);
+    } else if (!_entries.empty() && prevId != _entries.back().id) {
+        if (id <= _entries.back().id) {
+            // Another scan got here first.
+            return;
+        }
+        // Nobody published the entries since the end of the window, so it can't be extended.
+        // Start over from this entry, as it is now the head of the oplog as far as we know.
+        _reset(lk, oplogUUID, prevId);
+    } else if (_entries.empty()) {
+        _firstPrevId = prevId;
+    }
+
+    _entries.push_back({id, obj});
+    _bytes += obj.objsize();
+
+    const auto maxBytes =
+        static_cast<size_t>(internalChangeStreamSharedOplogReaderBufferBytes.load());
+    while (_bytes > maxBytes && !_entries.empty()) {
+        _bytes -= _entries.front().obj.objsize();
+        _firstPrevId = _entries.front().id;
+        _entries.pop_front();
+    }
+}
+
+size_t SharedOplogReader::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+void SharedOplogReader::_reset(WithLock, const UUID& oplogUUID, const RecordId& prevId) {
+    _oplogUUID = oplogUUID;
+    _firstPrevId = prevId;
+    _entries.clear();
+    _bytes = 0;
+}
+
+}  // namespace mongo
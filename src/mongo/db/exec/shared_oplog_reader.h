@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * An in-memory window over the most recent entries of the oplog, shared by all the tailing
+ * change stream scans of the oplog on this node.
+ *
+ * Without it, every open change stream reads, copies and filters the same oplog entries from the
+ * storage engine. With it, the scan at the head of the oplog publishes each entry it reads, and
+ * the scans trailing it take the entries from here instead of reading them again. Each scan still
+ * applies its own filter and keeps its own position, so the streams remain independent.
+ *
+ * The window only ever holds a contiguous run of the oplog: an entry is published along with the
+ * id of the entry that precedes it, and is only accepted if that id is the last one in the window.
+ * The oldest entries are evicted once the window exceeds
+ * 'internalChangeStreamSharedOplogReaderBufferBytes'.
+ */
+class SharedOplogReader {
+    SharedOplogReader(const SharedOplogReader&) = delete;
+    SharedOplogReader& operator=(const SharedOplogReader&) = delete;
+
+public:
+    struct Entry {
+        RecordId id;
+        BSONObj obj;
+    };
+
+    SharedOplogReader() = default;
+
+    static SharedOplogReader& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns whether the window is enabled, that is, whether
+     * 'internalChangeStreamSharedOplogReaderBufferBytes' is non-zero.
+     */
+    static bool isEnabled();
+
+    /**
+     * Appends to 'out' up to 'maxEntries' of the entries that follow 'after' in the oplog
+     * identified by 'oplogUUID', stopping before the first entry past 'upTo'. Appends nothing if
+     * 'after' is not in the window.
+     */
+    void getEntriesAfter(const UUID& oplogUUID,
+                         const RecordId& after,
+                         const RecordId& upTo,
+                         size_t maxEntries,
+                         std::deque<Entry>* out) const;
+
+    /**
+     * Adds the owned oplog entry 'obj', which a forward scan of the oplog identified by
+     * 'oplogUUID' read directly after the entry 'prevId', to the window.
+     */
+    void publish(const UUID& oplogUUID,
+                 const RecordId& prevId,
+                 const RecordId& id,
+                 const BSONObj& obj);
+
+    /**
+     * Returns the number of entries in the window.
+     */
+    size_t size() const;
+
+private:
+    void _reset(WithLock, const UUID& oplogUUID, const RecordId& prevId);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("SharedOplogReader::_mutex");
+
+    // The oplog the window belongs to. Changes if the oplog is recreated.
+    boost::optional<UUID> _oplogUUID;
+
+    // The id of the oplog entry immediately preceding the first entry in '_entries'.
+    RecordId _firstPrevId;
+
+    // Consecutive oplog entries, in increasing id order.
+    std::deque<Entry> _entries;
+
+    // The total size of the entries in '_entries'.
+    size_t _bytes = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/shared_oplog_reader.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+class SharedOplogReaderTest : public unittest::Test {
+public:
+    void setUp() override {
+        _originalBufferBytes = internalChangeStreamSharedOplogReaderBufferBytes.load();
+        internalChangeStreamSharedOplogReaderBufferBytes.store(1024 * 1024);
+    }
+
+    void tearDown() override {
+        internalChangeStreamSharedOplogReaderBufferBytes.store(_originalBufferBytes);
+    }
+
+protected:
+    static BSONObj makeEntry(long long id) {
+        return BSON("ts" << Timestamp(1, id) << "op"
+                         << "n"
+                         << "o" << BSONObj());
+    }
+
+    // Publishes the entries with ids in (from, to], in order.
+    void publishRange(long long from, long long to) {
+        for (auto id = from + 1; id <= to; ++id) {
+            _reader.publish(_oplogUUID, RecordId(id - 1), RecordId(id), makeEntry(id));
+        }
+    }
+
+    std::vector<long long> entriesAfter(long long after,
+                                        size_t maxEntries = 100,
+                                        long long upTo = std::numeric_limits<long long>::max()) {
+        std::deque<SharedOplogReader::Entry> entries;
+        _reader.getEntriesAfter(_oplogUUID, RecordId(after), RecordId(upTo), maxEntries, &entries);
+        std::vector<long long> ids;
+        for (const auto& entry : entries) {
+            ASSERT_BSONOBJ_EQ(makeEntry(entry.id.repr()), entry.obj);
+            ids.push_back(entry.id.repr());
+        }
+        return ids;
+    }
+
+    const UUID _oplogUUID = UUID::gen();
+    SharedOplogReader _reader;
+
+private:
+    long long _originalBufferBytes = 0;
+};
+
+TEST_F(SharedOplogReaderTest, ReturnsEntriesFollowingAnEntryInTheWindow) {
+    publishRange(10, 15);
+    ASSERT_EQ(5U, _reader.size());
+
+    ASSERT(entriesAfter(10) == std::vector<long long>({11, 12, 13, 14, 15}));
+    ASSERT(entriesAfter(12) == std::vector<long long>({13, 14, 15}));
+    ASSERT(entriesAfter(12, 2) == std::vector<long long>({13, 14}));
+    ASSERT(entriesAfter(15).empty());
+}
+
+TEST_F(SharedOplogReaderTest, ReturnsOnlyEntriesUpToTheGivenEntry) {
+    publishRange(10, 15);
+    ASSERT(entriesAfter(10, 100, 12) == std::vector<long long>({11, 12}));
+    ASSERT(entriesAfter(12, 100, 12).empty());
+}
+
+TEST_F(SharedOplogReaderTest, ReturnsNothingForEntriesOutsideTheWindow) {
+    publishRange(10, 15);
+    ASSERT(entriesAfter(9).empty());
+    ASSERT(entriesAfter(16).empty());
+
+    std::deque<SharedOplogReader::Entry> entries;
+    _reader.getEntriesAfter(UUID::gen(), RecordId(10), RecordId(15), 100, &entries);
+    ASSERT(entries.empty());
+}
+
+TEST_F(SharedOplogReaderTest, IgnoresEntriesAlreadyPublished) {
+    publishRange(10, 15);
+    publishRange(12, 14);
+    ASSERT_EQ(5U, _reader.size());
+    ASSERT(entriesAfter(10) == std::vector<long long>({11, 12, 13, 14, 15}));
+}
+
+TEST_F(SharedOplogReaderTest, StartsOverOnAGap) {
+    publishRange(10, 15);
+    _reader.publish(_oplogUUID, RecordId(20), RecordId(21), makeEntry(21));
+    ASSERT_EQ(1U, _reader.size());
+    ASSERT(entriesAfter(10).empty());
+    ASSERT(entriesAfter(20) == std::vector<long long>({21}));
+}
+
+TEST_F(SharedOplogReaderTest, StartsOverWhenTheOplogChanges) {
+    publishRange(10, 15);
+    const auto newOplogUUID = UUID::gen();
+    _reader.publish(newOplogUUID, RecordId(1), RecordId(2), makeEntry(2));
+    ASSERT_EQ(1U, _reader.size());
+    ASSERT(entriesAfter(10).empty());
+}
+
+TEST_F(SharedOplogReaderTest, EvictsTheOldestEntriesOverTheSizeLimit) {
+    const auto entrySize = makeEntry(0).objsize();
+    internalChangeStreamSharedOplogReaderBufferBytes.store(3 * entrySize);
+
+    publishRange(10, 15);
+    ASSERT_EQ(3U, _reader.size());
+    ASSERT(entriesAfter(10).empty());
+    ASSERT(entriesAfter(12) == std::vector<long long>({13, 14, 15}));
+    ASSERT(entriesAfter(13) == std::vector<long long>({14, 15}));
+}
+
+}  // namespace
+}  // namespace mongo
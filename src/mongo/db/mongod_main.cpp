@@ -61,6 +61,7 @@
 #include "mongo/db/catalog/health_log.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/index_key_validate.h"
+#include "mongo/db/catalog/lazy_collection_initializer.h"
 #include "mongo/db/client.h"
 #include "mongo/db/client_metadata_propagation_egress_hook.h"
 #include "mongo/db/clientcursor.h"
@@ -478,6 +479,10 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
         exitCleanly(EXIT_CLEAN);
     }
 
+    // Collections left uninitialized by startup recovery are initialized in the background while
+    // the server continues starting up, or on first use, whichever comes first.
+    startLazyCollectionInitializer(serviceContext);
+
     // Start up health log writer thread.
     HealthLog::get(startupOpCtx.get()).startup();
 
@@ -1287,6 +1292,9 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
     LOGV2(4784928, "Shutting down the TTL monitor");
     shutdownTTLMonitor(serviceContext);
 
+    LOGV2(5160004, "Shutting down the lazy collection initializer");
+    shutdownLazyCollectionInitializer(serviceContext);
+
     // We should always be able to acquire the global lock at shutdown.
     // An OperationContext is not necessary to call lockGlobal() during shutdown, as it's only used
     // to check that lockGlobal() is not called after a transaction timestamp has been set.
@@ -36,12 +36,18 @@
 namespace mongo {
 namespace {
 const auto getOpObserverTimes = OperationContext::declareDecoration<OpObserver::Times>();
+const auto getReservedDeleteSlot =
+    OperationContext::declareDecoration<OpObserver::ReservedDeleteSlot>();
 }  // namespace
 
 auto OpObserver::Times::get(OperationContext* const opCtx) -> Times& {
     return getOpObserverTimes(opCtx);
 }
 
+auto OpObserver::ReservedDeleteSlot::get(OperationContext* const opCtx) -> ReservedDeleteSlot& {
+    return getReservedDeleteSlot(opCtx);
+}
+
 OpObserver::ReservedTimes::ReservedTimes(OperationContext* const opCtx)
     : _times(Times::get(opCtx)) {
     // Every time that a `ReservedTimes` scope object is instantiated, we have to track if there was
@@ -36,6 +36,7 @@
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/commit_quorum_options.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/repl/optime.h"
 #include "mongo/db/repl/rollback.h"
 
 namespace mongo {
@@ -406,6 +407,7 @@ public:
                                              const repl::OpTime& newCommitPoint) = 0;
 
     struct Times;
+    struct ReservedDeleteSlot;
 
 protected:
     class ReservedTimes;
@@ -429,6 +431,19 @@ private:
     int _recursionDepth = 0;
 };
 
+/**
+ * This struct is a decoration for `OperationContext` which lets a caller that groups several
+ * replicated deletes in one WriteUnitOfWork choose the oplog slot of the next delete. The caller
+ * reserves the slots for the whole group up front and timestamps the storage writes of each delete
+ * with its slot, so that the data and oplog writes of every delete share one timestamp. The slot is
+ * consumed by the first delete that is logged after it is set.
+ */
+struct OpObserver::ReservedDeleteSlot {
+    static ReservedDeleteSlot& get(OperationContext*);
+
+    boost::optional<repl::OpTime> slot;
+};
+
 /**
  * This class is an RAII object to manage the state of the `OpObserver::Times` decoration on an
  * operation context. Upon destruction the list of times in the decoration on the operation context
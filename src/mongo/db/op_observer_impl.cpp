@@ -230,6 +230,14 @@ OpTimeBundle replLogDelete(OperationContext* opCtx,
     oplogEntry.setOpType(repl::OpTypeEnum::kDelete);
     oplogEntry.setObject(documentKeyDecoration(opCtx).get().getShardKeyAndId());
     oplogEntry.setFromMigrateIfTrue(fromMigrate);
+    // A caller grouping several deletes in one WriteUnitOfWork may have reserved the slot for this
+    // delete and already timestamped its storage writes with it.
+    auto& reservedSlot = OpObserver::ReservedDeleteSlot::get(opCtx).slot;
+    if (reservedSlot) {
+        invariant(!deletedDoc);
+        oplogEntry.setOpTime(*reservedSlot);
+        reservedSlot = boost::none;
+    }
     // oplogLink could have been changed to include preImageOpTime by the previous no-op write.
     repl::appendOplogEntryChainInfo(opCtx, &oplogEntry, &oplogLink, stmtId);
     opTimes.writeOpTime = logOperation(opCtx, &oplogEntry);
@@ -30,7 +30,9 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
 #include "mongo/s/query/sharded_agg_test_fixture.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -104,6 +106,44 @@ TEST_F(DispatchShardPipelineTest, DoesSplitPipelineIfMatchSpansTwoShards) {
     future.default_timed_get();
 }
 
+TEST_F(DispatchShardPipelineTest, PartitionsGroupByExchangeOnlyIfCallerIsEligible) {
+    // Sharded by {_id: 1}, [MinKey, 0) on shard "0", [0, MaxKey) on shard "1".
+    setupNShards(2);
+    loadRoutingTableWithTwoChunksAndTwoShards(kTestAggregateNss);
+    internalQueryEnableHashPartitionedGroup.store(true);
+    ON_BLOCK_EXIT([] { internalQueryEnableHashPartitionedGroup.store(false); });
+
+    auto stages = std::vector{
+        fromjson("{$match: {_id: {$gte: -10}}}"),
+        fromjson("{$group: {_id: '$username', high_scores: {$push: '$score'}}}"),
+    };
+    const Document serializedCommand =
+        AggregationRequest(expCtx()->ns, stages).serializeToCommandObj();
+    const bool hasChangeStream = false;
+
+    for (bool eligibleForGroupExchange : {false, true}) {
+        auto pipeline =
+            Pipeline::create({parseStage(stages[0]), parseStage(stages[1])}, expCtx());
+        auto future = launchAsync([&] {
+            auto results = sharded_agg_helpers::dispatchShardPipeline(
+                serializedCommand, hasChangeStream, std::move(pipeline), eligibleForGroupExchange);
+            ASSERT_EQ(results.remoteCursors.size(), 2UL);
+            ASSERT_EQ(bool(results.exchangeSpec), eligibleForGroupExchange);
+        });
+
+        for (int i = 0; i < 2; ++i) {
+            onCommand([&](const executor::RemoteCommandRequest& request) {
+                ASSERT_EQ(request.cmdObj.hasField(AggregationRequest::kExchangeName),
+                          eligibleForGroupExchange);
+                return CursorResponse(kTestAggregateNss, CursorId{0}, std::vector<BSONObj>{})
+                    .toBSON(CursorResponse::ResponseType::InitialResponse);
+            });
+        }
+
+        future.default_timed_get();
+    }
+}
+
 TEST_F(DispatchShardPipelineTest, DispatchShardPipelineRetriesOnNetworkError) {
     // Sharded by {_id: 1}, [MinKey, 0) on shard "0", [0, MaxKey) on shard "1".
     setupNShards(2);
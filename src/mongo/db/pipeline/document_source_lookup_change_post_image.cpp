@@ -32,6 +32,9 @@
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/query/find_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -52,19 +55,121 @@ Value assertFieldHasType(const Document& fullDoc, StringData fieldName, BSONType
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceLookupChangePostImage::doGetNext() {
-    auto input = pSource->getNext();
-    if (!input.isAdvanced()) {
-        return input;
+    if (_buffer.empty()) {
+        bufferInputs();
+        lookupPostImages();
     }
-    auto opTypeVal = assertFieldHasType(
-        input.getDocument(), DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
-    if (opTypeVal.getString() != DocumentSourceChangeStream::kUpdateOpType) {
-        return input;
+
+    auto next = std::move(_buffer.front());
+    _buffer.pop_front();
+    return next;
+}
+
+void DocumentSourceLookupChangePostImage::bufferInputs() {
+    const size_t batchSize = internalChangeStreamPostImageLookupBatchSize.load();
+
+    // Once we have an event, we must not wait for further events to become available before
+    // returning it, so we temporarily stop the input from waiting for inserts.
+    auto& awaitData = awaitDataState(pExpCtx->opCtx);
+    const auto originalAwaitData = awaitData;
+    ON_BLOCK_EXIT([&] { awaitData = originalAwaitData; });
+
+    do {
+        auto input = pSource->getNext();
+        if (!input.isAdvanced()) {
+            _buffer.push_back(std::move(input));
+            return;
+        }
+        auto opTypeVal = assertFieldHasType(
+            input.getDocument(), DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
+        _buffer.push_back(std::move(input));
+
+        // The input may throw once it has returned an invalidate, so don't read past one.
+        if (opTypeVal.getString() == DocumentSourceChangeStream::kInvalidateOpType) {
+            return;
+        }
+        awaitData.shouldWaitForInserts = false;
+        awaitData.waitForInsertsDeadline = Date_t();
+    } while (_buffer.size() < batchSize);
+}
+
+void DocumentSourceLookupChangePostImage::lookupPostImages() {
+    struct LookupGroup {
+        NamespaceString nss;
+        UUID uuid;
+        Timestamp clusterTime;
+        std::vector<size_t> positions;
+        std::vector<Document> documentKeys;
+    };
+
+    // Group the update events by the collection whose documents they updated.
+    std::vector<LookupGroup> groups;
+    for (size_t position = 0; position < _buffer.size(); ++position) {
+        if (!_buffer[position].isAdvanced()) {
+            continue;
+        }
+        const auto& updateOp = _buffer[position].getDocument();
+        if (updateOp[DocumentSourceChangeStream::kOperationTypeField].getString() !=
+            DocumentSourceChangeStream::kUpdateOpType) {
+            continue;
+        }
+
+        // Make sure we have a well-formed input.
+        auto nss = assertValidNamespace(updateOp);
+
+        auto documentKey = assertFieldHasType(updateOp,
+                                              DocumentSourceChangeStream::kDocumentKeyField,
+                                              BSONType::Object)
+                               .getDocument();
+
+        // Extract the UUID from resume token and do change stream lookups by UUID.
+        auto resumeToken =
+            ResumeToken::parse(updateOp[DocumentSourceChangeStream::kIdField].getDocument());
+        invariant(resumeToken.getData().uuid);
+        const auto& uuid = *resumeToken.getData().uuid;
+
+        auto group = std::find_if(groups.begin(), groups.end(), [&](const LookupGroup& group) {
+            return group.uuid == uuid && group.nss == nss;
+        });
+        if (group == groups.end()) {
+            group = groups.insert(groups.end(),
+                                  LookupGroup{nss, uuid, resumeToken.getData().clusterTime});
+        }
+        group->clusterTime = std::max(group->clusterTime, resumeToken.getData().clusterTime);
+        group->positions.push_back(position);
+        group->documentKeys.push_back(std::move(documentKey));
     }
 
-    MutableDocument output(input.releaseDocument());
-    output[kFullDocumentFieldName] = lookupPostImage(output.peek());
-    return output.freeze();
+    for (auto&& group : groups) {
+        // Reading after the latest of the updates is also after each of the others.
+        const auto readConcern = pExpCtx->inMongos
+            ? boost::optional<BSONObj>(BSON("level"
+                                            << "majority"
+                                            << "afterClusterTime" << group.clusterTime))
+            : boost::none;
+
+        // Update lookup queries sent from mongoS to shards are allowed to use speculative majority
+        // reads.
+        const auto allowSpeculativeMajorityRead = pExpCtx->inMongos;
+        auto lookedUpDocs =
+            pExpCtx->mongoProcessInterface->lookupDocuments(pExpCtx,
+                                                            group.nss,
+                                                            group.uuid,
+                                                            group.documentKeys,
+                                                            readConcern,
+                                                            allowSpeculativeMajorityRead);
+        invariant(lookedUpDocs.size() == group.positions.size());
+
+        for (size_t i = 0; i < group.positions.size(); ++i) {
+            auto& result = _buffer[group.positions[i]];
+            MutableDocument output(result.releaseDocument());
+            // Even if the lookup itself succeeded, it may not have returned any results if the
+            // document was deleted in the time since the update op.
+            output[kFullDocumentFieldName] =
+                lookedUpDocs[i] ? Value(*lookedUpDocs[i]) : Value(BSONNULL);
+            result = output.freeze();
+        }
+    }
 }
 
 NamespaceString DocumentSourceLookupChangePostImage::assertValidNamespace(
@@ -88,41 +193,4 @@ NamespaceString DocumentSourceLookupChangePostImage::assertValidNamespace(
     return nss;
 }
 
-Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updateOp) const {
-    // Make sure we have a well-formed input.
-    auto nss = assertValidNamespace(updateOp);
-
-    auto documentKey = assertFieldHasType(updateOp,
-                                          DocumentSourceChangeStream::kDocumentKeyField,
-                                          BSONType::Object)
-                           .getDocument();
-
-    // Extract the UUID from resume token and do change stream lookups by UUID.
-    auto resumeToken =
-        ResumeToken::parse(updateOp[DocumentSourceChangeStream::kIdField].getDocument());
-
-    const auto readConcern = pExpCtx->inMongos
-        ? boost::optional<BSONObj>(BSON("level"
-                                        << "majority"
-                                        << "afterClusterTime" << resumeToken.getData().clusterTime))
-        : boost::none;
-
-
-    // Update lookup queries sent from mongoS to shards are allowed to use speculative majority
-    // reads.
-    const auto allowSpeculativeMajorityRead = pExpCtx->inMongos;
-    invariant(resumeToken.getData().uuid);
-    auto lookedUpDoc =
-        pExpCtx->mongoProcessInterface->lookupSingleDocument(pExpCtx,
-                                                             nss,
-                                                             *resumeToken.getData().uuid,
-                                                             documentKey,
-                                                             readConcern,
-                                                             allowSpeculativeMajorityRead);
-
-    // Check whether the lookup returned any documents. Even if the lookup itself succeeded, it may
-    // not have returned any results if the document was deleted in the time since the update op.
-    return (lookedUpDoc ? Value(*lookedUpDoc) : Value(BSONNULL));
-}
-
 }  // namespace mongo
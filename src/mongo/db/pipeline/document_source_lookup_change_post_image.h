@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 
@@ -36,7 +38,9 @@ namespace mongo {
 
 /**
  * Part of the change stream API machinery used to look up the post-image of a document. Uses the
- * "documentKey" field of the input to look up the new version of the document.
+ * "documentKey" field of the input to look up the new version of the document. Events which are
+ * already available from the input are buffered, up to the post-image lookup batch size, so that
+ * the post-images of all the updates to the same collection among them are looked up together.
  */
 class DocumentSourceLookupChangePostImage final : public DocumentSource {
 public:
@@ -115,10 +119,18 @@ private:
     GetNextResult doGetNext() final;
 
     /**
-     * Uses the "documentKey" field from 'updateOp' to look up the current version of the document.
-     * Returns Value(BSONNULL) if the document couldn't be found.
+     * Fills '_buffer' with the next result from the input and any further events that are already
+     * available, stopping at the first result which is not an event, after an invalidate or once
+     * the batch size is reached.
      */
-    Value lookupPostImage(const Document& updateOp) const;
+    void bufferInputs();
+
+    /**
+     * Uses the "documentKey" field of each update event in '_buffer' to look up the current
+     * version of the document, and sets it as the "fullDocument" of the event, or BSONNULL if the
+     * document couldn't be found. Does one lookup for each collection with updates in '_buffer'.
+     */
+    void lookupPostImages();
 
     /**
      * Throws a AssertionException if the namespace found in 'inputDoc' doesn't match the one on the
@@ -126,6 +138,9 @@ private:
      * function verifies that the only the database names match.
      */
     NamespaceString assertValidNamespace(const Document& inputDoc) const;
+
+    // Results from the input which are ready to be returned, in order.
+    std::deque<GetNextResult> _buffer;
 };
 
 }  // namespace mongo
@@ -45,6 +45,8 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/process_interface/stub_lookup_single_document_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -54,6 +56,34 @@ using std::vector;
 
 using MockMongoInterface = StubLookupSingleDocumentProcessInterface;
 
+/**
+ * A mock MongoProcessInterface which records the number of document keys in each lookup, and
+ * finds a document for every key except {_id: "deleted"}.
+ */
+class BatchRecordingMongoInterface final : public StubMongoProcessInterface {
+public:
+    std::vector<boost::optional<Document>> lookupDocuments(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const std::vector<Document>& documentKeys,
+        boost::optional<BSONObj> readConcern,
+        bool allowSpeculativeMajorityRead) final {
+        lookupBatchSizes.push_back(documentKeys.size());
+        std::vector<boost::optional<Document>> lookedUpDocuments;
+        for (auto&& documentKey : documentKeys) {
+            if (documentKey["_id"].getType() == BSONType::String) {
+                lookedUpDocuments.push_back(boost::none);
+            } else {
+                lookedUpDocuments.push_back(Document{{"_id", documentKey["_id"]}, {"x", 1}});
+            }
+        }
+        return lookedUpDocuments;
+    }
+
+    std::vector<size_t> lookupBatchSizes;
+};
+
 // This provides access to getExpCtx(), but we'll use a different name for this test suite.
 class DocumentSourceLookupChangePostImageTest : public AggregationContextFixture {
 public:
@@ -334,5 +364,54 @@ TEST_F(DocumentSourceLookupChangePostImageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceLookupChangePostImageTest, ShouldLookUpAvailableUpdatesTogether) {
+    auto expCtx = getExpCtx();
+    const auto originalBatchSize = internalChangeStreamPostImageLookupBatchSize.load();
+    internalChangeStreamPostImageLookupBatchSize.store(3);
+    ON_BLOCK_EXIT([&] { internalChangeStreamPostImageLookupBatchSize.store(originalBatchSize); });
+
+    auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+
+    auto makeEvent = [&](ImplicitValue id, StringData opType) {
+        return Document{{"_id", makeResumeToken(id)},
+                        {"documentKey", Document{{"_id", id}}},
+                        {"operationType", opType},
+                        {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}};
+    };
+
+    // The first batch is limited by the batch size, the second one by the pause.
+    auto mockLocalSource =
+        DocumentSourceMock::createForTest({makeEvent(0, "update"_sd),
+                                           makeEvent(1, "insert"_sd),
+                                           makeEvent(0, "update"_sd),
+                                           makeEvent("deleted"_sd, "update"_sd),
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           makeEvent(2, "update"_sd)},
+                                          expCtx);
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    auto mongoInterface = std::make_shared<BatchRecordingMongoInterface>();
+    expCtx->mongoProcessInterface = mongoInterface;
+
+    auto expectPostImage = [&](Value expectedPostImage) {
+        auto next = lookupChangeStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_VALUE_EQ(next.getDocument()["fullDocument"], expectedPostImage);
+    };
+
+    expectPostImage(Value(Document{{"_id", 0}, {"x", 1}}));
+    ASSERT(mongoInterface->lookupBatchSizes == (std::vector<size_t>{2}));
+    expectPostImage(Value());
+    expectPostImage(Value(Document{{"_id", 0}, {"x", 1}}));
+
+    expectPostImage(Value(BSONNULL));
+    ASSERT_TRUE(lookupChangeStage->getNext().isPaused());
+    ASSERT(mongoInterface->lookupBatchSizes == (std::vector<size_t>{2, 1}));
+
+    expectPostImage(Value(Document{{"_id", 2}, {"x", 1}}));
+    ASSERT(mongoInterface->lookupBatchSizes == (std::vector<size_t>{2, 1, 1}));
+    ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -369,6 +369,24 @@ boost::optional<Document> CommonMongodProcessInterface::lookupSingleDocument(
     return lookedUpDocument;
 }
 
+std::vector<boost::optional<Document>> CommonMongodProcessInterface::lookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const std::vector<Document>& documentKeys,
+    boost::optional<BSONObj> readConcern,
+    bool allowSpeculativeMajorityRead) {
+    // Each lookup on mongod is a local point read on the _id index, so there is no round trip to
+    // amortize by combining them into a single query.
+    std::vector<boost::optional<Document>> lookedUpDocuments;
+    lookedUpDocuments.reserve(documentKeys.size());
+    for (auto&& documentKey : documentKeys) {
+        lookedUpDocuments.push_back(lookupSingleDocument(
+            expCtx, nss, collectionUUID, documentKey, readConcern, allowSpeculativeMajorityRead));
+    }
+    return lookedUpDocuments;
+}
+
 BackupCursorState CommonMongodProcessInterface::openBackupCursor(
     OperationContext* opCtx, const StorageEngine::BackupOptions& options) {
     auto backupCursorHooks = BackupCursorHooks::get(opCtx->getServiceContext());
@@ -358,6 +358,20 @@ public:
         boost::optional<BSONObj> readConcern,
         bool allowSpeculativeMajorityRead = false) = 0;
 
+    /**
+     * Looks up the documents with each of the document keys in 'documentKeys', all of which belong
+     * to the collection 'nss'. Returns one entry per document key, in the same order, which is
+     * boost::none if no document with that key was found. Throws under the same conditions as
+     * lookupSingleDocument().
+     */
+    virtual std::vector<boost::optional<Document>> lookupDocuments(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID,
+        const std::vector<Document>& documentKeys,
+        boost::optional<BSONObj> readConcern,
+        bool allowSpeculativeMajorityRead = false) = 0;
+
     /**
      * Returns a vector of all idle (non-pinned) local cursors.
      */
@@ -33,7 +33,9 @@
 
 #include "mongo/db/pipeline/process_interface/mongos_process_interface.h"
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/index/index_descriptor.h"
@@ -100,6 +102,111 @@ bool supportsUniqueKey(const boost::intrusive_ptr<ExpressionContext>& expCtx,
         CollatorInterface::collatorsMatch(collation.get(), expCtx->getCollator());
 }
 
+/**
+ * Dispatches a find with the filter 'filterObj' on the collection 'nss' to every shard which may
+ * own a matching document, and returns the documents found across the cluster. Any fields in
+ * 'findOptions' are appended to the find command. Throws if a shard cursor was left open.
+ */
+std::vector<BSONObj> findOnTargetedShards(const intrusive_ptr<ExpressionContext>& expCtx,
+                                          const NamespaceString& nss,
+                                          UUID collectionUUID,
+                                          const BSONObj& filterObj,
+                                          const BSONObj& findOptions,
+                                          const boost::optional<BSONObj>& readConcern,
+                                          bool allowSpeculativeMajorityRead) {
+    auto foreignExpCtx = expCtx->copyWith(nss, collectionUUID);
+
+    // Create the find command to be dispatched to the shard(s) in order to return the post-image.
+    BSONObjBuilder cmdBuilder;
+    bool findCmdIsByUuid(foreignExpCtx->uuid);
+    if (findCmdIsByUuid) {
+        foreignExpCtx->uuid->appendToBuilder(&cmdBuilder, "find");
+    } else {
+        cmdBuilder.append("find", nss.coll());
+    }
+    cmdBuilder.append("filter", filterObj);
+    cmdBuilder.appendElements(findOptions);
+    if (readConcern) {
+        cmdBuilder.append(repl::ReadConcernArgs::kReadConcernFieldName, *readConcern);
+    }
+    if (allowSpeculativeMajorityRead) {
+        cmdBuilder.append("allowSpeculativeMajorityRead", true);
+    }
+
+    auto findCmd = cmdBuilder.obj();
+    auto catalogCache = Grid::get(expCtx->opCtx)->catalogCache();
+    auto shardResults = sharded_agg_helpers::shardVersionRetry(
+        expCtx->opCtx,
+        catalogCache,
+        foreignExpCtx->ns,
+        str::stream() << "Looking up document matching " << redact(filterObj),
+        [&]() -> std::vector<RemoteCursor> {
+            // Verify that the collection exists, with the correct UUID.
+            auto routingInfo = uassertStatusOK(getCollectionRoutingInfo(foreignExpCtx));
+
+            // Finalize the 'find' command object based on the routing table information.
+            if (findCmdIsByUuid && routingInfo.cm()) {
+                // Find by UUID and shard versioning do not work together (SERVER-31946).  In
+                // the sharded case we've already checked the UUID, so find by namespace is
+                // safe.  In the unlikely case that the collection has been deleted and a new
+                // collection with the same name created through a different mongos or the
+                // collection had its shard key refined, the shard version will be detected as
+                // stale, as shard versions contain an 'epoch' field unique to the collection.
+                findCmd = findCmd.addField(BSON("find" << nss.coll()).firstElement());
+                findCmdIsByUuid = false;
+            }
+
+            // Build the versioned requests to be dispatched to the shards. Typically, only a
+            // single shard will be targeted here; however, in certain cases where only the _id
+            // is present, we may need to scatter-gather the query to all shards in order to
+            // find the document.
+            auto requests = getVersionedRequestsForTargetedShards(expCtx->opCtx,
+                                                                  nss,
+                                                                  routingInfo,
+                                                                  findCmd,
+                                                                  filterObj,
+                                                                  CollationSpec::kSimpleSpec);
+
+            // Dispatch the requests. The 'establishCursors' method conveniently prepares the
+            // result into a vector of cursor responses for us.
+            return establishCursors(
+                expCtx->opCtx,
+                Grid::get(expCtx->opCtx)->getExecutorPool()->getArbitraryExecutor(),
+                nss,
+                ReadPreferenceSetting::get(expCtx->opCtx),
+                std::move(requests),
+                false);
+        });
+
+    // Iterate all shard results and build a single composite batch.
+    std::vector<BSONObj> finalBatch;
+    for (auto&& shardResult : shardResults) {
+        auto& shardCursor = shardResult.getCursorResponse();
+        finalBatch.insert(
+            finalBatch.end(), shardCursor.getBatch().begin(), shardCursor.getBatch().end());
+        // The cursor should be exhausted.
+        uassert(ErrorCodes::ChangeStreamFatalError,
+                str::stream() << "Shard cursor was unexpectedly open after lookup: "
+                              << shardResult.getHostAndPort()
+                              << ", id: " << shardCursor.getCursorId(),
+                shardCursor.getCursorId() == 0);
+    }
+    return finalBatch;
+}
+
+/**
+ * Returns true if every field of 'documentKey' has the same value in 'doc'.
+ */
+bool documentHasKey(const BSONObj& doc, const BSONObj& documentKey) {
+    for (auto&& keyElem : documentKey) {
+        auto docElem = dotted_path_support::extractElementAtPath(doc, keyElem.fieldNameStringData());
+        if (docElem.eoo() || docElem.woCompare(keyElem, 0) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace
 
 std::unique_ptr<Pipeline, PipelineDeleter> MongosProcessInterface::attachCursorSourceToPipeline(
@@ -120,98 +227,117 @@ boost::optional<Document> MongosProcessInterface::lookupSingleDocument(
     const Document& filter,
     boost::optional<BSONObj> readConcern,
     bool allowSpeculativeMajorityRead) {
-    auto foreignExpCtx = expCtx->copyWith(nss, collectionUUID);
+    try {
+        auto finalBatch = findOnTargetedShards(expCtx,
+                                               nss,
+                                               collectionUUID,
+                                               filter.toBson(),
+                                               BSONObj(),
+                                               readConcern,
+                                               allowSpeculativeMajorityRead);
+
+        // We enforce the requirement that only a single document should have been returned from
+        // across the cluster.
+        uassert(ErrorCodes::ChangeStreamFatalError,
+                str::stream() << "found more than one document matching " << filter.toString()
+                              << " [" << finalBatch.begin()->toString() << ", "
+                              << std::next(finalBatch.begin())->toString() << "]",
+                finalBatch.size() <= 1u);
 
-    // Create the find command to be dispatched to the shard(s) in order to return the post-image.
-    auto filterObj = filter.toBson();
-    BSONObjBuilder cmdBuilder;
-    bool findCmdIsByUuid(foreignExpCtx->uuid);
-    if (findCmdIsByUuid) {
-        foreignExpCtx->uuid->appendToBuilder(&cmdBuilder, "find");
-    } else {
-        cmdBuilder.append("find", nss.coll());
+        return (!finalBatch.empty() ? Document(finalBatch.front()) : boost::optional<Document>{});
+    } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+        // If it's an unsharded collection which has been deleted and re-created, we may get a
+        // NamespaceNotFound error when looking up by UUID.
+        return boost::none;
     }
-    cmdBuilder.append("filter", filterObj);
-    if (readConcern) {
-        cmdBuilder.append(repl::ReadConcernArgs::kReadConcernFieldName, *readConcern);
+}
+
+std::vector<boost::optional<Document>> MongosProcessInterface::lookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const std::vector<Document>& documentKeys,
+    boost::optional<BSONObj> readConcern,
+    bool allowSpeculativeMajorityRead) {
+    std::vector<boost::optional<Document>> lookedUpDocuments;
+    if (documentKeys.size() <= 1u) {
+        for (auto&& documentKey : documentKeys) {
+            lookedUpDocuments.push_back(lookupSingleDocument(expCtx,
+                                                             nss,
+                                                             collectionUUID,
+                                                             documentKey,
+                                                             readConcern,
+                                                             allowSpeculativeMajorityRead));
+        }
+        return lookedUpDocuments;
     }
-    if (allowSpeculativeMajorityRead) {
-        cmdBuilder.append("allowSpeculativeMajorityRead", true);
+
+    // The same document may have been updated several times, so only ask for each key once.
+    std::vector<BSONObj> uniqueKeys;
+    std::vector<size_t> uniqueKeyIndexes;
+    auto uniqueKeyMap = SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<size_t>();
+    BSONArrayBuilder orBuilder;
+    for (auto&& documentKey : documentKeys) {
+        auto keyObj = documentKey.toBson();
+        auto inserted = uniqueKeyMap.emplace(keyObj, uniqueKeys.size());
+        if (inserted.second) {
+            orBuilder.append(keyObj);
+            uniqueKeys.push_back(std::move(keyObj));
+        }
+        uniqueKeyIndexes.push_back(inserted.first->second);
     }
 
+    // Look up all the keys with a single query, which is targeted at every shard owning at least
+    // one of them. Ask for a single batch so that no cursor is left open on the shards.
+    std::vector<BSONObj> finalBatch;
     try {
-        auto findCmd = cmdBuilder.obj();
-        auto catalogCache = Grid::get(expCtx->opCtx)->catalogCache();
-        auto shardResults = sharded_agg_helpers::shardVersionRetry(
-            expCtx->opCtx,
-            catalogCache,
-            foreignExpCtx->ns,
-            str::stream() << "Looking up document matching " << redact(filter.toBson()),
-            [&]() -> std::vector<RemoteCursor> {
-                // Verify that the collection exists, with the correct UUID.
-                auto routingInfo = uassertStatusOK(getCollectionRoutingInfo(foreignExpCtx));
-
-                // Finalize the 'find' command object based on the routing table information.
-                if (findCmdIsByUuid && routingInfo.cm()) {
-                    // Find by UUID and shard versioning do not work together (SERVER-31946).  In
-                    // the sharded case we've already checked the UUID, so find by namespace is
-                    // safe.  In the unlikely case that the collection has been deleted and a new
-                    // collection with the same name created through a different mongos or the
-                    // collection had its shard key refined, the shard version will be detected as
-                    // stale, as shard versions contain an 'epoch' field unique to the collection.
-                    findCmd = findCmd.addField(BSON("find" << nss.coll()).firstElement());
-                    findCmdIsByUuid = false;
-                }
-
-                // Build the versioned requests to be dispatched to the shards. Typically, only a
-                // single shard will be targeted here; however, in certain cases where only the _id
-                // is present, we may need to scatter-gather the query to all shards in order to
-                // find the document.
-                auto requests = getVersionedRequestsForTargetedShards(expCtx->opCtx,
-                                                                      nss,
-                                                                      routingInfo,
-                                                                      findCmd,
-                                                                      filterObj,
-                                                                      CollationSpec::kSimpleSpec);
-
-                // Dispatch the requests. The 'establishCursors' method conveniently prepares the
-                // result into a vector of cursor responses for us.
-                return establishCursors(
-                    expCtx->opCtx,
-                    Grid::get(expCtx->opCtx)->getExecutorPool()->getArbitraryExecutor(),
-                    nss,
-                    ReadPreferenceSetting::get(expCtx->opCtx),
-                    std::move(requests),
-                    false);
-            });
-
-        // Iterate all shard results and build a single composite batch. We also enforce the
-        // requirement that only a single document should have been returned from across the
-        // cluster.
-        std::vector<BSONObj> finalBatch;
-        for (auto&& shardResult : shardResults) {
-            auto& shardCursor = shardResult.getCursorResponse();
-            finalBatch.insert(
-                finalBatch.end(), shardCursor.getBatch().begin(), shardCursor.getBatch().end());
-            // We should have at most 1 result, and the cursor should be exhausted.
-            uassert(ErrorCodes::ChangeStreamFatalError,
-                    str::stream() << "Shard cursor was unexpectedly open after lookup: "
-                                  << shardResult.getHostAndPort()
-                                  << ", id: " << shardCursor.getCursorId(),
-                    shardCursor.getCursorId() == 0);
+        finalBatch = findOnTargetedShards(
+            expCtx,
+            nss,
+            collectionUUID,
+            BSON("$or" << orBuilder.arr()),
+            BSON("batchSize" << static_cast<long long>(uniqueKeys.size() + 1) << "singleBatch"
+                             << true),
+            readConcern,
+            allowSpeculativeMajorityRead);
+    } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+        lookedUpDocuments.resize(documentKeys.size());
+        return lookedUpDocuments;
+    }
+
+    std::vector<boost::optional<Document>> uniqueResults(uniqueKeys.size());
+    for (auto&& doc : finalBatch) {
+        for (size_t i = 0; i < uniqueKeys.size(); ++i) {
+            if (!documentHasKey(doc, uniqueKeys[i])) {
+                continue;
+            }
             uassert(ErrorCodes::ChangeStreamFatalError,
-                    str::stream() << "found more than one document matching " << filter.toString()
-                                  << " [" << finalBatch.begin()->toString() << ", "
-                                  << std::next(finalBatch.begin())->toString() << "]",
-                    finalBatch.size() <= 1u);
+                    str::stream() << "found more than one document matching " << uniqueKeys[i]
+                                  << " [" << uniqueResults[i]->toString() << ", " << doc << "]",
+                    !uniqueResults[i]);
+            uniqueResults[i] = Document(doc);
         }
+    }
 
-        return (!finalBatch.empty() ? Document(finalBatch.front()) : boost::optional<Document>{});
-    } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
-        // If it's an unsharded collection which has been deleted and re-created, we may get a
-        // NamespaceNotFound error when looking up by UUID.
-        return boost::none;
+    // A key without a result either belongs to a document which has since been deleted, or its
+    // document was not recognized above, e.g. because the batch was truncated by the shard or the
+    // key only matches under the collection's collation. Look those up individually, so that the
+    // results are the same as without batching.
+    for (size_t i = 0; i < uniqueKeys.size(); ++i) {
+        if (!uniqueResults[i]) {
+            uniqueResults[i] = lookupSingleDocument(expCtx,
+                                                    nss,
+                                                    collectionUUID,
+                                                    Document(uniqueKeys[i]),
+                                                    readConcern,
+                                                    allowSpeculativeMajorityRead);
+        }
+    }
+
+    for (auto uniqueKeyIndex : uniqueKeyIndexes) {
+        lookedUpDocuments.push_back(uniqueResults[uniqueKeyIndex]);
     }
+    return lookedUpDocuments;
 }
 
 BSONObj MongosProcessInterface::_reportCurrentOpForClient(
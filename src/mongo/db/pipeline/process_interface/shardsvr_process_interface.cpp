@@ -42,10 +42,13 @@
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/s/database_sharding_state.h"
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/cluster_commands_helpers.h"
+#include "mongo/s/database_version_helpers.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/write_ops/cluster_write.h"
 
@@ -354,7 +357,106 @@ void ShardServerProcessInterface::dropCollection(OperationContext* opCtx,
 std::unique_ptr<Pipeline, PipelineDeleter>
 ShardServerProcessInterface::attachCursorSourceToPipeline(Pipeline* ownedPipeline,
                                                           bool allowTargetingShards) {
-    return sharded_agg_helpers::attachCursorToPipeline(ownedPipeline, allowTargetingShards);
+    if (!allowTargetingShards || !_isCoLocatedRead(*ownedPipeline)) {
+        return sharded_agg_helpers::attachCursorToPipeline(ownedPipeline, allowTargetingShards);
+    }
+
+    // Check the pinned database and shard versions before handing over the pipeline, so that it
+    // can still be targeted if this shard is no longer the primary shard of the database or its
+    // filtering metadata no longer matches.
+    auto expCtx = ownedPipeline->getContext();
+    try {
+        AutoGetCollectionForRead autoColl(expCtx->opCtx, expCtx->ns);
+        auto dss = DatabaseShardingState::get(expCtx->opCtx, expCtx->ns.db());
+        {
+            auto dssLock = DatabaseShardingState::DSSLock::lockShared(expCtx->opCtx, dss);
+            dss->checkDbVersion(expCtx->opCtx, dssLock);
+        }
+        CollectionShardingState::get(expCtx->opCtx, expCtx->ns)
+            ->checkShardVersionOrThrow(expCtx->opCtx);
+    } catch (const ExceptionFor<ErrorCodes::StaleDbVersion>& ex) {
+        LOGV2_DEBUG(5183001,
+                    3,
+                    "Targeting pipeline on {namespace} because the database version of this shard "
+                    "is stale: {error}",
+                    "Targeting pipeline because the database version of this shard is stale",
+                    "namespace"_attr = expCtx->ns,
+                    "error"_attr = redact(ex.toStatus()));
+        _staleCoLocatedDbs.insert(expCtx->ns.db().toString());
+        return sharded_agg_helpers::attachCursorToPipeline(ownedPipeline, allowTargetingShards);
+    } catch (const ExceptionForCat<ErrorCategory::StaleShardVersionError>& ex) {
+        LOGV2_DEBUG(5183000,
+                    3,
+                    "Targeting pipeline on {namespace} because the shard version of its local "
+                    "collection is stale: {error}",
+                    "Targeting pipeline because the shard version of its local collection is stale",
+                    "namespace"_attr = expCtx->ns,
+                    "error"_attr = redact(ex.toStatus()));
+        _staleCoLocatedNamespaces.insert(expCtx->ns.ns());
+        return sharded_agg_helpers::attachCursorToPipeline(ownedPipeline, allowTargetingShards);
+    }
+
+    return attachCursorSourceToPipelineForLocalRead(ownedPipeline);
+}
+
+bool ShardServerProcessInterface::_isCoLocatedRead(const Pipeline& pipeline) {
+    const auto& expCtx = pipeline.getContext();
+    auto opCtx = expCtx->opCtx;
+    const auto& nss = expCtx->ns;
+    // Without a shard version, the local read could neither filter out orphaned documents nor
+    // notice that the collection was sharded or its chunks moved.
+    if (!_opIsVersioned || internalQueryDisableCoLocatedSubpipelineReads.load() ||
+        nss.db() == "local" || nss.isCollectionlessAggregateNS() ||
+        _staleCoLocatedDbs.count(nss.db()) || _staleCoLocatedNamespaces.count(nss.ns())) {
+        return false;
+    }
+
+    auto swRoutingInfo = Grid::get(opCtx)->catalogCache()->getCollectionRoutingInfo(opCtx, nss);
+    if (!swRoutingInfo.isOK()) {
+        return false;
+    }
+    const auto& routingInfo = swRoutingInfo.getValue();
+    const auto shardId = ShardingState::get(opCtx)->shardId();
+    auto& oss = OperationShardingState::get(opCtx);
+
+    // An unsharded collection lives on the primary shard of its database and is versioned by the
+    // database version, which is pinned alongside the UNSHARDED shard version.
+    if (!routingInfo.cm()) {
+        if (routingInfo.db().primaryId() != shardId) {
+            return false;
+        }
+        const auto dbVersion = routingInfo.db().databaseVersion();
+        const auto pinnedDbVersion = oss.getDbVersion(nss.db());
+        if (pinnedDbVersion && !databaseVersion::equal(*pinnedDbVersion, dbVersion)) {
+            return false;
+        }
+        if (oss.hasShardVersion(nss)) {
+            return oss.getShardVersion(nss) == ChunkVersion::UNSHARDED();
+        }
+        oss.initializeClientRoutingVersions(
+            nss,
+            ChunkVersion::UNSHARDED(),
+            pinnedDbVersion ? boost::none : boost::make_optional(dbVersion));
+        return true;
+    }
+
+    ChunkVersion shardVersion;
+    try {
+        const auto targetedShards = getTargetedShardsForQuery(
+            expCtx, routingInfo, pipeline.getInitialQuery(), expCtx->getCollatorBSON());
+        if (targetedShards.size() != 1 || *targetedShards.begin() != shardId) {
+            return false;
+        }
+        shardVersion = routingInfo.cm()->getVersion(shardId);
+    } catch (const ExceptionFor<ErrorCodes::ShardInvalidatedForTargeting>&) {
+        return false;
+    }
+
+    if (oss.hasShardVersion(nss)) {
+        return oss.getShardVersion(nss) == shardVersion;
+    }
+    oss.initializeClientRoutingVersions(nss, shardVersion, boost::none);
+    return true;
 }
 
 void ShardServerProcessInterface::setExpectedShardVersion(
@@ -33,6 +33,7 @@
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/process_interface/common_mongod_process_interface.h"
 #include "mongo/s/catalog_cache.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -122,7 +123,8 @@ public:
      * If 'allowTargetingShards' is true, splits the pipeline and dispatch half to the shards,
      * leaving the merging half executing in this process after attaching a $mergeCursors. Will
      * retry on network errors and also on StaleConfig errors to avoid restarting the entire
-     * operation.
+     * operation. If this shard is the only one owning the documents the pipeline reads from a
+     * sharded collection, the whole pipeline instead runs against the local collection.
      */
     std::unique_ptr<Pipeline, PipelineDeleter> attachCursorSourceToPipeline(
         Pipeline* pipeline, bool allowTargetingShards) final;
@@ -149,6 +151,24 @@ private:
     // of the original operation so that we can decide whether we should version sub-operations
     // across the entire lifetime of the pipeline that owns this MongoProcessInterface.
     bool _opIsVersioned = false;
+
+    /**
+     * Returns true if this shard is the only shard owning the documents which 'pipeline' reads,
+     * either as the primary shard of the database of an unsharded collection or as the only shard
+     * targeted in a sharded collection, so that it can run against the local collection rather
+     * than being targeted through the routing table. Only versioned operations read locally. The
+     * first time this returns true for a namespace, the versions this shard knows for it are pinned
+     * on the operation: the shard version, and for an unsharded collection also the database
+     * version. The local reads are checked against them.
+     */
+    bool _isCoLocatedRead(const Pipeline& pipeline);
+
+    // Namespaces for which a local read failed with a stale shard version. Since the version pinned
+    // for them cannot change for the rest of the operation, their pipelines are always targeted.
+    StringSet _staleCoLocatedNamespaces;
+
+    // Databases for which a local read failed with a stale database version, for the same reason.
+    StringSet _staleCoLocatedDbs;
 };
 
 }  // namespace mongo
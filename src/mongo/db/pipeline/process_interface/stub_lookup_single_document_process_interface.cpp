@@ -82,4 +82,19 @@ boost::optional<Document> StubLookupSingleDocumentProcessInterface::lookupSingle
     return lookedUpDocument;
 }
 
+std::vector<boost::optional<Document>> StubLookupSingleDocumentProcessInterface::lookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const std::vector<Document>& documentKeys,
+    boost::optional<BSONObj> readConcern,
+    bool allowSpeculativeMajorityRead) {
+    std::vector<boost::optional<Document>> lookedUpDocuments;
+    for (auto&& documentKey : documentKeys) {
+        lookedUpDocuments.push_back(lookupSingleDocument(
+            expCtx, nss, collectionUUID, documentKey, readConcern, allowSpeculativeMajorityRead));
+    }
+    return lookedUpDocuments;
+}
+
 }  // namespace mongo
@@ -32,10 +32,14 @@
 
 #include "sharded_agg_helpers.h"
 
+#include <limits>
+#include <numeric>
+
 #include "mongo/db/curop.h"
 #include "mongo/db/logical_clock.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
+#include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -564,6 +568,25 @@ boost::optional<ShardedExchangePolicy> walkPipelineBackwardsTrackingShardKey(
     return ShardedExchangePolicy{std::move(exchangeSpec), std::move(consumerShards)};
 }
 
+/**
+ * Builds the range boundaries over the hashed group key which split the 64-bit hash space into
+ * 'numConsumers' ranges of equal width. The i-th range is assigned to the i-th consumer.
+ */
+std::vector<BSONObj> buildHashedGroupKeyBoundaries(size_t numConsumers) {
+    std::vector<BSONObj> boundaries;
+    boundaries.emplace_back(BSON("_id" << MINKEY));
+
+    const auto rangeWidth = std::numeric_limits<uint64_t>::max() / numConsumers;
+    for (size_t idx = 1; idx < numConsumers; ++idx) {
+        const auto splitPoint = static_cast<long long>(
+            static_cast<uint64_t>(std::numeric_limits<long long>::min()) + idx * rangeWidth);
+        boundaries.emplace_back(BSON("_id" << splitPoint));
+    }
+
+    boundaries.emplace_back(BSON("_id" << MAXKEY));
+    return boundaries;
+}
+
 /**
  * Non-correlated pipeline caching is only supported locally. When the
  * DocumentSourceSequentialDocumentCache stage has been moved to the shards pipeline, abandon the
@@ -674,6 +697,82 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
     return walkPipelineBackwardsTrackingShardKey(opCtx, mergePipeline, *routingInfo.cm());
 }
 
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx,
+    const SplitPipeline& splitPipeline,
+    const std::set<ShardId>& shardIds) {
+    if (!internalQueryEnableHashPartitionedGroup.load() || internalQueryDisableExchange.load()) {
+        return boost::none;
+    }
+
+    // There is nothing to gain from partitioning the merge when a single shard was targeted, and
+    // the exchange cannot fan out to more consumers than it supports.
+    if (shardIds.size() < 2 || shardIds.size() > Exchange::kMaxNumberConsumers) {
+        return boost::none;
+    }
+
+    // The consumers would have to join the transaction from a cursor they did not open.
+    if (TransactionRouter::get(opCtx)) {
+        return boost::none;
+    }
+
+    // The shards must stream their partial groups in an arbitrary order; a sorted merge relies on
+    // a single merger seeing every stream.
+    if (splitPipeline.shardCursorsSortSpec) {
+        return boost::none;
+    }
+
+    const auto* mergePipeline = splitPipeline.mergePipeline.get();
+    const auto& sources = mergePipeline->getSources();
+    if (sources.empty()) {
+        return boost::none;
+    }
+
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(sources.front().get());
+    if (!groupStage || !groupStage->doingMerge()) {
+        return boost::none;
+    }
+
+    // The exchange hashes the binary value of the group key, so two keys which only compare equal
+    // under a non-simple collation could be routed to different consumers.
+    if (mergePipeline->getContext()->getCollator()) {
+        return boost::none;
+    }
+
+    // Every consumer finalizes a disjoint set of groups and the results are simply unioned on the
+    // merger, so each stage after the $group must produce the same output when it runs on every
+    // partition separately.
+    for (auto it = std::next(sources.begin()); it != sources.end(); ++it) {
+        const auto& stage = *it;
+        const auto constraints = stage->constraints(Pipeline::SplitState::kSplitForMerge);
+        if (stage->distributedPlanLogic() || constraints.writesPersistentData() ||
+            constraints.hostRequirement != StageConstraints::HostTypeRequirement::kNone) {
+            return boost::none;
+        }
+    }
+
+    const auto numConsumers = shardIds.size();
+    std::vector<int> consumerIds(numConsumers);
+    std::iota(consumerIds.begin(), consumerIds.end(), 0);
+
+    ExchangeSpec exchangeSpec;
+    exchangeSpec.setPolicy(ExchangePolicyEnum::kKeyRange);
+    exchangeSpec.setKey(BSON("_id"
+                             << "hashed"));
+    exchangeSpec.setBoundaries(buildHashedGroupKeyBoundaries(numConsumers));
+    exchangeSpec.setConsumers(numConsumers);
+    exchangeSpec.setConsumerIds(std::move(consumerIds));
+
+    LOGV2_DEBUG(5181000,
+                3,
+                "Hash-partitioning the $group merge across {numConsumers} shards",
+                "Hash-partitioning the $group merge across shards",
+                "numConsumers"_attr = numConsumers);
+
+    return ShardedExchangePolicy{std::move(exchangeSpec),
+                                 std::vector<ShardId>(shardIds.begin(), shardIds.end())};
+}
+
 SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
     auto& expCtx = pipeline->getContext();
     // Re-brand 'pipeline' as the merging pipeline. We will move stages one by one from the merging
@@ -764,7 +863,8 @@ BSONObj createCommandForTargetedShards(const boost::intrusive_ptr<ExpressionCont
 DispatchShardPipelineResults dispatchShardPipeline(
     Document serializedCommand,
     bool hasChangeStream,
-    std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
+    bool eligibleForGroupExchange) {
     auto expCtx = pipeline->getContext();
 
     // The process is as follows:
@@ -824,6 +924,9 @@ DispatchShardPipelineResults dispatchShardPipeline(
         splitPipelines = splitPipeline(std::move(pipeline));
 
         exchangeSpec = checkIfEligibleForExchange(opCtx, splitPipelines->mergePipeline.get());
+        if (!exchangeSpec && eligibleForGroupExchange) {
+            exchangeSpec = checkIfEligibleForGroupExchange(opCtx, *splitPipelines, shardIds);
+        }
     }
 
     // Generate the command object for the targeted shards.
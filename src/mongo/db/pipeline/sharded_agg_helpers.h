@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <set>
+
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/s/async_requests_sender.h"
 #include "mongo/s/catalog_cache.h"
@@ -105,6 +107,17 @@ struct DispatchShardPipelineResults {
 boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationContext* opCtx,
                                                                   const Pipeline* mergePipeline);
 
+/**
+ * If the merging half of 'splitPipeline' begins with a $group which merges the partial groups from
+ * the shards, returns an $exchange policy which hash-partitions those partial groups by their
+ * group key across 'shardIds'. Each of those shards then finalizes a disjoint set of groups, and
+ * the rest of the merging pipeline runs on each of them in parallel.
+ */
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx,
+    const SplitPipeline& splitPipeline,
+    const std::set<ShardId>& shardIds);
+
 /**
  * Split the current Pipeline into a Pipeline for each shard, and a Pipeline that combines the
  * results within a merging process. This call also performs optimizations with the aim of reducing
@@ -120,11 +133,16 @@ SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline)
  * Targets shards for the pipeline and returns a struct with the remote cursors or results, and
  * the pipeline that will need to be executed to merge the results from the remotes. If a stale
  * shard version is encountered, refreshes the routing table and tries again.
+ *
+ * If 'eligibleForGroupExchange' is true, the shard pipelines may be partitioned by the key of a
+ * merging $group, see checkIfEligibleForGroupExchange(). Only callers which dispatch the exchange
+ * consumers for the returned 'exchangeSpec' may set it.
  */
 DispatchShardPipelineResults dispatchShardPipeline(
     Document serializedCommand,
     bool hasChangeStream,
-    std::unique_ptr<Pipeline, PipelineDeleter> pipeline);
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
+    bool eligibleForGroupExchange = false);
 
 BSONObj createPassthroughCommandForShard(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
@@ -315,6 +315,13 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         }
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsTested);
+            if (spec->docsFromSharedOplogReader > 0) {
+                bob->appendNumber("docsFromSharedOplogReader", spec->docsFromSharedOplogReader);
+            }
+            if (spec->oplogSeeksPastIrrelevantEntries > 0) {
+                bob->appendNumber("oplogSeeksPastIrrelevantEntries",
+                                  spec->oplogSeeksPastIrrelevantEntries);
+            }
         }
     } else if (STAGE_COUNT == stats.stageType) {
         CountStats* spec = static_cast<CountStats*>(stats.specific.get());
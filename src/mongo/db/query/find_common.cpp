@@ -34,10 +34,12 @@
 #include "mongo/db/query/find_common.h"
 
 #include "mongo/bson/bsonobj.h"
+#include "mongo/db/client.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/query_request.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 
@@ -95,4 +97,24 @@ void FindCommon::waitInFindBeforeMakingBatch(OperationContext* opCtx, const Cano
                                                      /* checkForInterrupt = */ false,
                                                      cq.nss());
 }
+
+void FindCommon::allowReadSnapshotReuseIfEligible(OperationContext* opCtx, bool isTailable) {
+    if (isTailable || opCtx->inMultiDocumentTransaction() ||
+        opCtx->getClient()->isInDirectClient()) {
+        return;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    const auto level = readConcernArgs.getLevel();
+    if (level != repl::ReadConcernLevel::kLocalReadConcern &&
+        level != repl::ReadConcernLevel::kAvailableReadConcern) {
+        return;
+    }
+    if (readConcernArgs.getArgsOpTime() || readConcernArgs.getArgsAfterClusterTime() ||
+        readConcernArgs.getArgsAtClusterTime()) {
+        return;
+    }
+
+    opCtx->recoveryUnit()->allowReadSnapshotReuse(opCtx->getClient());
+}
 }  // namespace mongo
@@ -128,6 +128,14 @@ public:
      * failpoint is active.
      */
     static void waitInFindBeforeMakingBatch(OperationContext* opCtx, const CanonicalQuery& cq);
+
+    /**
+     * Lets the storage engine run this find or getMore on the snapshot left open by the previous
+     * read from the same client, when the operation's read concern tolerates a slightly stale
+     * snapshot: level "local" or "available" without afterOpTime or afterClusterTime, outside of
+     * multi-document transactions and DBDirectClient, and on a non-tailable cursor.
+     */
+    static void allowReadSnapshotReuseIfEligible(OperationContext* opCtx, bool isTailable);
 };
 
 }  // namespace mongo
@@ -46,8 +46,10 @@ AllDatabaseCloner::AllDatabaseCloner(InitialSyncSharedData* sharedData,
                                      const HostAndPort& source,
                                      DBClientConnection* client,
                                      StorageInterface* storageInterface,
-                                     ThreadPool* dbPool)
+                                     ThreadPool* dbPool,
+                                     CreateClientFn createClientFn)
     : BaseCloner("AllDatabaseCloner"_sd, sharedData, source, client, storageInterface, dbPool),
+      _createClientFn(std::move(createClientFn)),
       _connectStage("connect", this, &AllDatabaseCloner::connectStage),
       _getInitialSyncIdStage("getInitialSyncId", this, &AllDatabaseCloner::getInitialSyncIdStage),
       _listDatabasesStage("listDatabases", this, &AllDatabaseCloner::listDatabasesStage) {}
@@ -119,6 +121,18 @@ BaseCloner::AfterStageBehavior AllDatabaseCloner::connectStage() {
     return kContinueNormally;
 }
 
+std::unique_ptr<DBClientConnection> AllDatabaseCloner::makeConnectedClient() {
+    auto client = _createClientFn();
+    client->setHandshakeValidationHook(
+        [this](const executor::RemoteCommandResponse& isMasterReply) {
+            return ensurePrimaryOrSecondary(isMasterReply);
+        });
+    uassertStatusOK(client->connect(getSource(), StringData()));
+    uassertStatusOK(replAuthenticate(client.get())
+                        .withContext(str::stream() << "Failed to authenticate to " << getSource()));
+    return client;
+}
+
 BaseCloner::AfterStageBehavior AllDatabaseCloner::getInitialSyncIdStage() {
     auto wireVersion = static_cast<WireVersion>(getClient()->getMaxWireVersion());
     {
@@ -189,12 +203,17 @@ void AllDatabaseCloner::postStage() {
     for (const auto& dbName : _databases) {
         {
             stdx::lock_guard<Latch> lk(_mutex);
+            DatabaseCloner::CreateClientFn createClientFn;
+            if (_createClientFn) {
+                createClientFn = [this] { return makeConnectedClient(); };
+            }
             _currentDatabaseCloner = std::make_unique<DatabaseCloner>(dbName,
                                                                       getSharedData(),
                                                                       getSource(),
                                                                       getClient(),
                                                                       getStorageInterface(),
-                                                                      getDBPool());
+                                                                      getDBPool(),
+                                                                      std::move(createClientFn));
         }
         auto dbStatus = _currentDatabaseCloner->run();
         if (dbStatus.isOK()) {
@@ -48,11 +48,21 @@ public:
         void append(BSONObjBuilder* builder) const;
     };
 
+    /**
+     * Returns a new, unconnected client for the cloners.
+     */
+    using CreateClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
+
+    /**
+     * If 'createClientFn' is provided, the DatabaseCloners may use it to open extra connections to
+     * the sync source so that they can clone several collections at the same time.
+     */
     AllDatabaseCloner(InitialSyncSharedData* sharedData,
                       const HostAndPort& source,
                       DBClientConnection* client,
                       StorageInterface* storageInterface,
-                      ThreadPool* dbPool);
+                      ThreadPool* dbPool,
+                      CreateClientFn createClientFn = {});
 
     virtual ~AllDatabaseCloner() = default;
 
@@ -102,6 +112,12 @@ private:
      */
     AfterStageBehavior connectStage();
 
+    /**
+     * Opens a new connection to the sync source with '_createClientFn', performing the same
+     * handshake validation and authentication as connectStage().
+     */
+    std::unique_ptr<DBClientConnection> makeConnectedClient();
+
     /**
      * Stage function that gets the wire version and initial sync ID.
      */
@@ -132,6 +148,7 @@ private:
     // (X)  Access only allowed from the main flow of control called from run() or constructor.
     // (MX) Write access with mutex from main flow of control, read access with mutex from other
     //      threads, read access allowed from main flow without mutex.
+    const CreateClientFn _createClientFn;                    // (R)
     ConnectStage _connectStage;                              // (R)
     ConnectStage _getInitialSyncIdStage;                     // (R)
     ClonerStage<AllDatabaseCloner> _listDatabasesStage;      // (R)
@@ -109,10 +109,62 @@ Status CollectionBulkLoaderImpl::init(const std::vector<BSONObj>& secondaryIndex
             _idIndexBlock.reset();
         }
 
+        // Documents of internal and system collections are observed by the OpObserver when
+        // inserted, so only user collections are appended in bulk.
+        if (collectionBulkLoaderUseRecordStoreBulkLoad &&
+            (_idIndexBlock || _secondaryIndexesBlock) && !_nss.isOnInternalDb() &&
+            !_nss.isSystem()) {
+            _recordStoreBulkLoader = coll->getRecordStore()->makeBulkLoader(_opCtx.get());
+            LOGV2_DEBUG(5162001,
+                        2,
+                        "Initialized collection bulk loader",
+                        "namespace"_attr = _nss.ns(),
+                        "recordStoreBulkLoad"_attr = bool(_recordStoreBulkLoader));
+        }
+
         return Status::OK();
     });
 }
 
+Status CollectionBulkLoaderImpl::_insertDocumentsWithRecordStoreBulkLoader(
+    const std::vector<BSONObj>::const_iterator begin,
+    const std::vector<BSONObj>::const_iterator end) {
+    try {
+        auto iter = begin;
+        while (iter != end) {
+            WriteUnitOfWork wunit(_opCtx.get());
+            int bytesInBlock = 0;
+            while (iter != end && bytesInBlock < collectionBulkLoaderBatchSizeInBytes) {
+                const auto& doc = *iter++;
+                bytesInBlock += doc.objsize();
+
+                RecordId loc;
+                auto status = _collection->insertDocumentForBulkLoader(
+                    _opCtx.get(),
+                    doc,
+                    [&](const RecordId& location) {
+                        loc = location;
+                        return Status::OK();
+                    },
+                    _recordStoreBulkLoader.get());
+                if (!status.isOK()) {
+                    return status;
+                }
+
+                status = _addDocumentToIndexBlocks(doc, loc);
+                if (!status.isOK()) {
+                    return status;
+                }
+            }
+            wunit.commit();
+        }
+    } catch (const WriteConflictException&) {
+        return Status(ErrorCodes::WriteConflict,
+                      str::stream() << "Write conflict while bulk loading " << _nss.ns());
+    }
+    return Status::OK();
+}
+
 Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
     const std::vector<BSONObj>::const_iterator begin,
     const std::vector<BSONObj>::const_iterator end) {
@@ -201,7 +253,9 @@ Status CollectionBulkLoaderImpl::insertDocuments(const std::vector<BSONObj>::con
                                                  const std::vector<BSONObj>::const_iterator end) {
     return _runTaskReleaseResourcesOnFailure([&] {
         UnreplicatedWritesBlock uwb(_opCtx.get());
-        if (_idIndexBlock || _secondaryIndexesBlock) {
+        if (_recordStoreBulkLoader) {
+            return _insertDocumentsWithRecordStoreBulkLoader(begin, end);
+        } else if (_idIndexBlock || _secondaryIndexesBlock) {
             return _insertDocumentsForUncappedCollection(begin, end);
         } else {
             return _insertDocumentsForCappedCollection(begin, end);
@@ -219,6 +273,15 @@ Status CollectionBulkLoaderImpl::commit() {
                     "namespace"_attr = _nss.ns());
         UnreplicatedWritesBlock uwb(_opCtx.get());
 
+        // Finish the bulk load first, so the documents are accessible to regular cursors when
+        // duplicates are deleted below.
+        if (_recordStoreBulkLoader) {
+            WriteUnitOfWork wunit(_opCtx.get());
+            _recordStoreBulkLoader->finish(_opCtx.get());
+            wunit.commit();
+            _recordStoreBulkLoader.reset();
+        }
+
         // Commit before deleting dups, so the dups will be removed from secondary indexes when
         // deleted.
         if (_secondaryIndexesBlock) {
@@ -331,6 +394,8 @@ Status CollectionBulkLoaderImpl::commit() {
 
 void CollectionBulkLoaderImpl::_releaseResources() {
     invariant(&cc() == _opCtx->getClient());
+    _recordStoreBulkLoader.reset();
+
     if (_secondaryIndexesBlock) {
         _secondaryIndexesBlock->abortIndexBuild(
             _opCtx.get(), _collection, MultiIndexBlock::kNoopOnCleanUpFn);
@@ -97,6 +97,16 @@ private:
     Status _insertDocumentsForUncappedCollection(const std::vector<BSONObj>::const_iterator begin,
                                                  const std::vector<BSONObj>::const_iterator end);
 
+    /**
+     * For uncapped collections whose RecordStore supports bulk loading, documents are appended
+     * through '_recordStoreBulkLoader' in batches of the same size, with their index keys. These
+     * writes cannot be rolled back, so a WriteConflictException fails the load instead of
+     * retrying the batch.
+     */
+    Status _insertDocumentsWithRecordStoreBulkLoader(
+        const std::vector<BSONObj>::const_iterator begin,
+        const std::vector<BSONObj>::const_iterator end);
+
     /**
      * Adds document and associated RecordId to index blocks after inserting into RecordStore.
      */
@@ -109,6 +119,7 @@ private:
     NamespaceString _nss;
     std::unique_ptr<MultiIndexBlock> _idIndexBlock;
     std::unique_ptr<MultiIndexBlock> _secondaryIndexesBlock;
+    std::unique_ptr<RecordStoreBulkLoader> _recordStoreBulkLoader;
     BSONObj _idIndexSpec;
     Stats _stats;
 };
@@ -31,12 +31,16 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/database_cloner_common.h"
 #include "mongo/db/repl/database_cloner_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -47,9 +51,11 @@ DatabaseCloner::DatabaseCloner(const std::string& dbName,
                                const HostAndPort& source,
                                DBClientConnection* client,
                                StorageInterface* storageInterface,
-                               ThreadPool* dbPool)
+                               ThreadPool* dbPool,
+                               CreateClientFn createClientFn)
     : BaseCloner("DatabaseCloner"_sd, sharedData, source, client, storageInterface, dbPool),
       _dbName(dbName),
+      _createClientFn(std::move(createClientFn)),
       _listCollectionsStage("listCollections", this, &DatabaseCloner::listCollectionsStage) {
     invariant(!dbName.empty());
     _stats.dbname = dbName;
@@ -126,20 +132,45 @@ void DatabaseCloner::postStage() {
             _stats.collectionStats.back().ns = coll.first.ns();
         }
     }
-    for (const auto& coll : _collections) {
-        auto& sourceNss = coll.first;
-        auto& collectionOptions = coll.second;
+
+    size_t numCloners = _createClientFn
+        ? std::min(_collections.size(),
+                   static_cast<size_t>(initialSyncMaxConcurrentCollectionCloners))
+        : 1;
+    if (numCloners > 1) {
+        runCollectionClonersConcurrently(numCloners);
+    } else {
+        runCollectionCloners(getClient());
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    // Abort the database cloner if a collection clone failed.
+    if (_collectionCloneFailed)
+        return;
+    _stats.end = getSharedData()->getClock()->now();
+}
+
+void DatabaseCloner::runCollectionCloners(DBClientConnection* client) {
+    while (true) {
+        size_t index;
+        CollectionCloner* collectionCloner;
         {
             stdx::lock_guard<Latch> lk(_mutex);
-            _currentCollectionCloner = std::make_unique<CollectionCloner>(sourceNss,
-                                                                          collectionOptions,
-                                                                          getSharedData(),
-                                                                          getSource(),
-                                                                          getClient(),
-                                                                          getStorageInterface(),
-                                                                          getDBPool());
+            if (_collectionCloneFailed || _nextCollection == _collections.size())
+                return;
+            index = _nextCollection++;
+            auto& cloner = _currentCollectionCloners[index];
+            cloner = std::make_unique<CollectionCloner>(_collections[index].first,
+                                                        _collections[index].second,
+                                                        getSharedData(),
+                                                        getSource(),
+                                                        client,
+                                                        getStorageInterface(),
+                                                        getDBPool());
+            collectionCloner = cloner.get();
         }
-        auto collStatus = _currentCollectionCloner->run();
+        auto& sourceNss = _collections[index].first;
+        auto collStatus = collectionCloner->run();
         if (collStatus.isOK()) {
             LOGV2_DEBUG(21148,
                         1,
@@ -161,23 +192,90 @@ void DatabaseCloner::postStage() {
         }
         {
             stdx::lock_guard<Latch> lk(_mutex);
-            _stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
-            _currentCollectionCloner = nullptr;
-            // Abort the database cloner if the collection clone failed.
-            if (!collStatus.isOK())
+            _stats.collectionStats[index] = collectionCloner->getStats();
+            _currentCollectionCloners.erase(index);
+            if (!collStatus.isOK()) {
+                _collectionCloneFailed = true;
                 return;
+            }
             _stats.clonedCollections++;
         }
     }
-    stdx::lock_guard<Latch> lk(_mutex);
-    _stats.end = getSharedData()->getClock()->now();
+}
+
+void DatabaseCloner::runCollectionClonersConcurrently(size_t numCloners) {
+    LOGV2_DEBUG(5169000,
+                1,
+                "Cloning collections of database {dbName} with {numCloners} concurrent cloners",
+                "Cloning collections concurrently",
+                "dbName"_attr = _dbName,
+                "numCloners"_attr = numCloners);
+
+    std::vector<stdx::thread> threads;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _numExtraClonerThreads = numCloners - 1;
+    }
+    for (size_t i = 1; i < numCloners; ++i) {
+        threads.emplace_back([this, i] {
+            const std::string threadName = str::stream()
+                << "DatabaseCloner-" << _dbName << "-" << i;
+            Client::initThread(threadName);
+            std::unique_ptr<DBClientConnection> client;
+            try {
+                client = _createClientFn();
+                {
+                    stdx::lock_guard<Latch> lk(_mutex);
+                    _extraClients.push_back(client.get());
+                }
+                runCollectionCloners(client.get());
+            } catch (const DBException& e) {
+                LOGV2_ERROR(5169001,
+                            "Failed to start collection cloner for database {dbName}: {error}",
+                            "Failed to start collection cloner",
+                            "dbName"_attr = _dbName,
+                            "error"_attr = e.toStatus());
+                setInitialSyncFailedStatus(e.toStatus());
+                stdx::lock_guard<Latch> lk(_mutex);
+                _collectionCloneFailed = true;
+            }
+            stdx::lock_guard<Latch> lk(_mutex);
+            _extraClients.erase(
+                std::remove(_extraClients.begin(), _extraClients.end(), client.get()),
+                _extraClients.end());
+            if (--_numExtraClonerThreads == 0)
+                _extraClonerThreadsDoneCond.notify_all();
+        });
+    }
+
+    // The calling thread clones over the shared connection, which is the one that gets shut down
+    // when initial sync is canceled.
+    runCollectionCloners(getClient());
+
+    // Wait for the other threads, shutting their connections down once initial sync has failed.
+    stdx::unique_lock<Latch> lk(_mutex);
+    while (!_extraClonerThreadsDoneCond.wait_for(
+        lk, Milliseconds(100).toSystemDuration(), [&] { return _numExtraClonerThreads == 0; })) {
+        lk.unlock();
+        bool shouldExit = mustExit();
+        lk.lock();
+        if (shouldExit) {
+            for (auto* client : _extraClients) {
+                client->shutdownAndDisallowReconnect();
+            }
+        }
+    }
+    lk.unlock();
+    for (auto& thread : threads) {
+        thread.join();
+    }
 }
 
 DatabaseCloner::Stats DatabaseCloner::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     DatabaseCloner::Stats stats = _stats;
-    if (_currentCollectionCloner) {
-        stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
+    for (const auto& [index, collectionCloner] : _currentCollectionCloners) {
+        stats.collectionStats[index] = collectionCloner->getStats();
     }
     return stats;
 }
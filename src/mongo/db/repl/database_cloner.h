@@ -29,10 +29,13 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
 #include "mongo/db/repl/collection_cloner.h"
+#include "mongo/stdx/condition_variable.h"
 
 namespace mongo {
 namespace repl {
@@ -52,12 +55,23 @@ public:
         void append(BSONObjBuilder* builder) const;
     };
 
+    /**
+     * Returns a new connection to the sync source, already connected and authenticated.
+     */
+    using CreateClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
+
+    /**
+     * When 'createClientFn' is provided, up to 'initialSyncMaxConcurrentCollectionCloners'
+     * collections are cloned at the same time. The first collection cloner uses 'client' and
+     * each of the others uses its own connection obtained from 'createClientFn'.
+     */
     DatabaseCloner(const std::string& dbName,
                    InitialSyncSharedData* sharedData,
                    const HostAndPort& source,
                    DBClientConnection* client,
                    StorageInterface* storageInterface,
-                   ThreadPool* dbPool);
+                   ThreadPool* dbPool,
+                   CreateClientFn createClientFn = {});
 
     virtual ~DatabaseCloner() = default;
 
@@ -91,6 +105,19 @@ private:
      */
     void postStage() final;
 
+    /**
+     * Runs CollectionCloners over 'client' until no collections are left to clone or one of
+     * them fails.
+     */
+    void runCollectionCloners(DBClientConnection* client);
+
+    /**
+     * Runs CollectionCloners on 'numCloners' threads, the calling thread included, and waits for
+     * all of them. If initial sync fails in the meantime, the connections of the other threads are
+     * shut down so that none of them stays blocked on the sync source.
+     */
+    void runCollectionClonersConcurrently(size_t numCloners);
+
     std::string describeForFuzzer(BaseClonerStage* stage) const final {
         return _dbName + " db: { " + stage->getName() + ": 1 } ";
     }
@@ -105,10 +132,22 @@ private:
     // (MX) Write access with mutex from main flow of control, read access with mutex from other
     //      threads, read access allowed from main flow without mutex.
     const std::string _dbName;                                                // (R)
+    const CreateClientFn _createClientFn;                                     // (R)
     ClonerStage<DatabaseCloner> _listCollectionsStage;                        // (R)
     std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
-    std::unique_ptr<CollectionCloner> _currentCollectionCloner;               // (MX)
-    Stats _stats;                                                             // (MX)
+    Stats _stats;                                                             // (M)
+
+    // The running CollectionCloners, keyed by the index of their collection in '_collections'.
+    std::map<size_t, std::unique_ptr<CollectionCloner>> _currentCollectionCloners;  // (M)
+    // Index in '_collections' of the next collection to hand out to a CollectionCloner.
+    size_t _nextCollection = 0;  // (M)
+    // Set once a CollectionCloner fails, so that no further collections are handed out.
+    bool _collectionCloneFailed = false;  // (M)
+    // Connections created by 'createClientFn' that are still in use, and the number of threads
+    // other than the one running postStage() that are still cloning.
+    std::vector<DBClientConnection*> _extraClients;  // (M)
+    size_t _numExtraClonerThreads = 0;               // (M)
+    stdx::condition_variable _extraClonerThreadsDoneCond;
 };
 
 }  // namespace repl
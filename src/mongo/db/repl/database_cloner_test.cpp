@@ -32,6 +32,7 @@
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/repl/cloner_test_fixture.h"
 #include "mongo/db/repl/database_cloner.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/service_context_test_fixture.h"
@@ -39,6 +40,7 @@
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -390,6 +392,89 @@ TEST_F(DatabaseClonerTest, CreateCollections) {
     ASSERT(stats.commitCalled);
 }
 
+TEST_F(DatabaseClonerTest, ClonesCollectionsConcurrently) {
+    auto uuid1 = UUID::gen();
+    auto uuid2 = UUID::gen();
+    const BSONObj idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                         << "_id_");
+    const std::vector<BSONObj> sourceInfos = {BSON("name"
+                                                   << "a"
+                                                   << "type"
+                                                   << "collection"
+                                                   << "options" << BSONObj() << "info"
+                                                   << BSON("readOnly" << false << "uuid" << uuid1)),
+                                              BSON(
+                                                  "name"
+                                                  << "b"
+                                                  << "type"
+                                                  << "collection"
+                                                  << "options" << BSONObj() << "info"
+                                                  << BSON("readOnly" << false << "uuid" << uuid2))};
+    _mockServer->setCommandReply("listCollections",
+                                 createListCollectionsResponse({sourceInfos[0], sourceInfos[1]}));
+    // The collections may be cloned in either order, so both get the same replies.
+    _mockServer->setCommandReply("count", {createCountResponse(0), createCountResponse(0)});
+    _mockServer->setCommandReply(
+        "listIndexes",
+        {createCursorResponse(_dbName + ".a", BSON_ARRAY(idIndexSpec)),
+         createCursorResponse(_dbName + ".b", BSON_ARRAY(idIndexSpec))});
+    // Create the entries up front, since the bulk loaders are created from different threads.
+    _collections[NamespaceString{_dbName, "a"}];
+    _collections[NamespaceString{_dbName, "b"}];
+
+    const auto originalMaxConcurrentCollectionCloners = initialSyncMaxConcurrentCollectionCloners;
+    initialSyncMaxConcurrentCollectionCloners = 2;
+    ON_BLOCK_EXIT([&] {
+        initialSyncMaxConcurrentCollectionCloners = originalMaxConcurrentCollectionCloners;
+    });
+    int numClientsCreated = 0;
+    auto createClientFn = [&]() -> std::unique_ptr<DBClientConnection> {
+        ++numClientsCreated;
+        const bool autoReconnect = true;
+        return std::make_unique<MockDBClientConnection>(_mockServer.get(), autoReconnect);
+    };
+    auto cloner = std::make_unique<DatabaseCloner>(_dbName,
+                                                   _sharedData.get(),
+                                                   _source,
+                                                   _mockClient.get(),
+                                                   &_storageInterface,
+                                                   _dbWorkThreadPool.get(),
+                                                   createClientFn);
+
+    // Hold the clone of 'a' before its first stage; 'b' must still be cloned in the meantime.
+    auto collClonerBeforeFailPoint = globalFailPointRegistry().find("hangBeforeClonerStage");
+    auto timesEntered = collClonerBeforeFailPoint->setMode(
+        FailPoint::alwaysOn,
+        0,
+        fromjson("{cloner: 'CollectionCloner', stage: 'count', nss: '" + _dbName + ".a'}"));
+
+    stdx::thread clonerThread([&] {
+        Client::initThread("ClonerRunner");
+        ASSERT_OK(cloner->run());
+    });
+    collClonerBeforeFailPoint->waitForTimesEntered(timesEntered + 1);
+    while (cloner->getStats().clonedCollections < 1) {
+        sleepmillis(10);
+    }
+
+    auto stats = cloner->getStats();
+    ASSERT_EQ(1, stats.clonedCollections);
+    ASSERT_EQ(_dbName + ".a", stats.collectionStats[0].ns);
+    ASSERT_EQ(Date_t(), stats.collectionStats[0].end);
+    ASSERT_EQ(_dbName + ".b", stats.collectionStats[1].ns);
+    ASSERT_EQ(_clock.now(), stats.collectionStats[1].end);
+
+    collClonerBeforeFailPoint->setMode(FailPoint::off, 0);
+    clonerThread.join();
+
+    stats = cloner->getStats();
+    ASSERT_EQ(2, stats.clonedCollections);
+    ASSERT_EQ(_clock.now(), stats.end);
+    ASSERT_EQ(1, numClientsCreated);
+    ASSERT(_collections[NamespaceString(_dbName, "a")].stats->commitCalled);
+    ASSERT(_collections[NamespaceString(_dbName, "b")].stats->commitCalled);
+}
+
 TEST_F(DatabaseClonerTest, DatabaseAndCollectionStats) {
     auto uuid1 = UUID::gen();
     auto uuid2 = UUID::gen();
@@ -126,6 +126,10 @@ StatusWith<OpTime> OplogApplier::applyOplogBatch(OperationContext* opCtx,
     return lastApplied;
 }
 
+void OplogApplier::prefetchBatch(const std::vector<OplogEntry>& ops) {
+    _prefetchBatch(ops);
+}
+
 StatusWith<std::vector<OplogEntry>> OplogApplier::getNextApplierBatch(
     OperationContext* opCtx, const BatchLimits& batchLimits) {
     return _oplogBatcher->getNextApplierBatch(opCtx, batchLimits);
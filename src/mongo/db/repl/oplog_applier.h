@@ -156,6 +156,13 @@ public:
      */
     StatusWith<OpTime> applyOplogBatch(OperationContext* opCtx, std::vector<OplogEntry> ops);
 
+    /**
+     * Called by the OplogBatcher when it has assembled the next batch, before the batch is handed
+     * over for application, so that the data the batch touches can be read into the cache while
+     * the previous batch is still being applied. Must not block.
+     */
+    void prefetchBatch(const std::vector<OplogEntry>& ops);
+
     /**
      * Calls the OplogBatcher's getNextApplierBatch.
      */
@@ -179,6 +186,11 @@ private:
     virtual StatusWith<OpTime> _applyOplogBatch(OperationContext* opCtx,
                                                 std::vector<OplogEntry> ops) = 0;
 
+    /**
+     * Called from prefetchBatch(). Does nothing by default.
+     */
+    virtual void _prefetchBatch(const std::vector<OplogEntry>& ops) {}
+
     // Used to schedule task for oplog application loop.
     // Not owned by us.
     executor::TaskExecutor* const _executor;
@@ -45,10 +45,12 @@
 #include "mongo/db/repl/insert_group.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/transaction_oplog_application.h"
+#include "mongo/db/repl/update_delete_group.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/db/storage/control/storage_control.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/basic.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_with_sampling.h"
@@ -412,7 +414,17 @@ OplogApplierImpl::OplogApplierImpl(executor::TaskExecutor* executor,
       _writerPool(writerPool),
       _storageInterface(storageInterface),
       _consistencyMarkers(consistencyMarkers),
-      _beginApplyingOpTime(options.beginApplyingOpTime) {}
+      _beginApplyingOpTime(options.beginApplyingOpTime) {
+    if (replPrefetchThreads > 0) {
+        _prefetcher = std::make_unique<OplogPrefetcher>(replPrefetchThreads);
+    }
+}
+
+void OplogApplierImpl::_prefetchBatch(const std::vector<OplogEntry>& ops) {
+    if (_prefetcher) {
+        _prefetcher->prefetch(ops);
+    }
+}
 
 void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
     // Start up a thread from the batcher to pull from the oplog buffer into the batcher's oplog
@@ -624,7 +636,11 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
     // Increment the batch size stat.
     oplogApplicationBatchSize.increment(ops.size());
 
-    std::vector<WorkerMultikeyPathInfo> multikeyVector(_writerPool->getStats().numThreads);
+    // Divide the batch into more partitions than there are writer threads, so that a thread which
+    // finishes its partitions early can claim partitions no other thread has started yet.
+    const size_t numWriterThreads = _writerPool->getStats().numThreads;
+    const size_t numPartitions = numWriterThreads * replWriterPartitionsPerThread.load();
+    std::vector<WorkerMultikeyPathInfo> multikeyVector(numPartitions);
     {
         // Each node records cumulative batch application stats for itself using this timer.
         TimerHolder timer(&applyBatchStats);
@@ -649,8 +665,10 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         //   and create a pseudo oplog.
         std::vector<std::vector<OplogEntry>> derivedOps;
 
-        std::vector<std::vector<const OplogEntry*>> writerVectors(
-            _writerPool->getStats().numThreads);
+        // Operations that conflict with each other, because they write the same document or the
+        // same capped collection, are always hashed into the same partition in oplog order, so the
+        // partitions can be applied in any order and by any writer thread.
+        std::vector<std::vector<const OplogEntry*>> writerVectors(numPartitions);
         fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
 
         // Wait for writes to finish before applying ops.
@@ -672,32 +690,52 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         }
 
         {
-            std::vector<Status> statusVector(_writerPool->getStats().numThreads, Status::OK());
+            std::vector<Status> statusVector(numPartitions, Status::OK());
 
-            // Doles out all the work to the writer pool threads. writerVectors is not modified,
-            // but  applyOplogBatchPerWorker will modify the vectors that it contains.
-            invariant(writerVectors.size() == statusVector.size());
+            // Hand out the largest partitions first, so that the smaller ones claimed last fill in
+            // the gaps and all writer threads finish at about the same time.
+            std::vector<size_t> partitionOrder;
+            partitionOrder.reserve(numPartitions);
             for (size_t i = 0; i < writerVectors.size(); i++) {
-                if (writerVectors[i].empty())
-                    continue;
-
-                _writerPool->schedule(
-                    [this,
-                     &writer = writerVectors.at(i),
-                     &status = statusVector.at(i),
-                     &multikeyVector = multikeyVector.at(i)](auto scheduleStatus) {
-                        invariant(scheduleStatus);
+                if (!writerVectors[i].empty())
+                    partitionOrder.push_back(i);
+            }
+            std::stable_sort(partitionOrder.begin(), partitionOrder.end(), [&](size_t a, size_t b) {
+                return writerVectors[a].size() > writerVectors[b].size();
+            });
+            AtomicWord<size_t> nextPartition{0};
 
+            // Doles out all the work to the writer pool threads. Each thread keeps claiming the
+            // next unapplied partition until there are none left. writerVectors is not modified,
+            // but applyOplogBatchPerWorker will modify the vectors that it contains.
+            invariant(writerVectors.size() == statusVector.size());
+            const size_t numWriters = std::min(numWriterThreads, partitionOrder.size());
+            for (size_t i = 0; i < numWriters; i++) {
+                _writerPool->schedule([this,
+                                       &writerVectors,
+                                       &statusVector,
+                                       &multikeyVector,
+                                       &partitionOrder,
+                                       &nextPartition](auto scheduleStatus) {
+                    invariant(scheduleStatus);
+
+                    for (auto next = nextPartition.fetchAndAdd(1); next < partitionOrder.size();
+                         next = nextPartition.fetchAndAdd(1)) {
+                        const auto partition = partitionOrder[next];
                         auto opCtx = cc().makeOperationContext();
 
                         // This code path is only executed on secondaries and initial syncing nodes,
                         // so it is safe to exclude any writes from Flow Control.
                         opCtx->setShouldParticipateInFlowControl(false);
 
-                        status = opCtx->runWithoutInterruptionExceptAtGlobalShutdown([&] {
-                            return applyOplogBatchPerWorker(opCtx.get(), &writer, &multikeyVector);
-                        });
-                    });
+                        statusVector[partition] =
+                            opCtx->runWithoutInterruptionExceptAtGlobalShutdown([&] {
+                                return applyOplogBatchPerWorker(opCtx.get(),
+                                                                &writerVectors[partition],
+                                                                &multikeyVector[partition]);
+                            });
+                    }
+                });
             }
 
             _writerPool->waitForIdle();
@@ -711,7 +749,7 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                         "Failed to apply batch of operations. Number of operations in "
                         "batch: {numOperationsInBatch}. First operation: {firstOperation}. "
                         "Last operation: "
-                        "{lastOperation}. Oplog application failed in writer thread "
+                        "{lastOperation}. Oplog application failed in writer partition "
                         "{failedWriterThread}: {error}",
                         "Failed to apply batch of operations",
                         "numOperationsInBatch"_attr = ops.size(),
@@ -774,7 +812,7 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
 /**
  * ops - This only modifies the isForCappedCollection field on each op. It does not alter the ops
  *      vector in any other way.
- * writerVectors - Set of operations for each worker thread to apply.
+ * writerVectors - Set of operations for each writer partition to apply.
  * derivedOps - If provided, this function inserts a decomposition of applyOps operations
  *      and instructions for updating the transactions table.  Required if processing oplogs
  *      with transactions.
@@ -1009,6 +1047,89 @@ Status applyOplogEntryOrGroupedInserts(OperationContext* opCtx,
     MONGO_UNREACHABLE;
 }
 
+Status applyGroupedUpdatesAndDeletes(OperationContext* opCtx,
+                                     std::vector<const OplogEntry*>::const_iterator begin,
+                                     std::vector<const OplogEntry*>::const_iterator end,
+                                     OplogApplication::Mode oplogApplicationMode) {
+    invariant(!opCtx->writesAreReplicated());
+    invariant(documentValidationDisabled(opCtx));
+    invariant(std::distance(begin, end) > 1);
+
+    const OplogEntry& firstOp = **begin;
+    // Count the group as a single operation, for reporting purposes.
+    CurOp groupOp(opCtx);
+
+    const NamespaceString nss(firstOp.getNss());
+
+    // The ops are only counted as applied once the group commits. A group that fails is applied
+    // again one op at a time, which counts its ops then.
+    long long numOpsApplied = 0;
+    auto incrementOpsAppliedStats = [&numOpsApplied] { ++numOpsApplied; };
+
+    auto clockSource = opCtx->getServiceContext()->getFastClockSource();
+    auto applyStartTime = clockSource->now();
+
+    // applyOperation_inlock() does not timestamp writes made inside a wrapping write unit of work,
+    // so timestamp each op here, as applyOperation_inlock() would when applying it on its own.
+    const bool assignOperationTimestamps =
+        ReplicationCoordinator::get(opCtx)->getReplicationMode() ==
+            ReplicationCoordinator::modeReplSet ||
+        oplogApplicationMode == OplogApplication::Mode::kRecovering;
+
+    // See applyOplogEntryOrGroupedInserts().
+    const bool shouldAlwaysUpsert = !oplogApplicationEnforcesSteadyStateConstraints &&
+        oplogApplicationMode == OplogApplication::Mode::kSecondary;
+
+    auto status = writeConflictRetry(opCtx, "applyGroupedUpdatesAndDeletes", nss.ns(), [&] {
+        AutoGetCollection autoColl(opCtx,
+                                   getNsOrUUID(nss, firstOp),
+                                   fixLockModeForSystemDotViewsChanges(nss, MODE_IX));
+        auto db = autoColl.getDb();
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "missing database (" << nss.db() << ")",
+                db);
+        OldClientContext ctx(opCtx, autoColl.getNss().ns(), db);
+
+        numOpsApplied = 0;
+        WriteUnitOfWork wuow(opCtx);
+        for (auto it = begin; it != end; ++it) {
+            const OplogEntry& op = **it;
+            if (assignOperationTimestamps) {
+                uassertStatusOK(opCtx->recoveryUnit()->setTimestamp(op.getTimestamp()));
+            }
+
+            Status status = applyOperation_inlock(
+                opCtx, db, &op, shouldAlwaysUpsert, oplogApplicationMode, incrementOpsAppliedStats);
+            if (!status.isOK()) {
+                if (status.code() == ErrorCodes::WriteConflict) {
+                    throw WriteConflictException();
+                }
+                return status;
+            }
+        }
+        wuow.commit();
+        return Status::OK();
+    });
+
+    if (status.isOK()) {
+        opsAppliedStats.increment(numOpsApplied);
+
+        auto opDuration = durationCount<Milliseconds>(clockSource->now() - applyStartTime);
+        if (shouldLogSlowOpWithSampling(opCtx,
+                                        MONGO_LOGV2_DEFAULT_COMPONENT,
+                                        Milliseconds(opDuration),
+                                        Milliseconds(serverGlobalParams.slowMS))
+                .first) {
+            LOGV2(5165000,
+                  "Applied grouped updates and deletes",
+                  "firstOp"_attr = redact(firstOp.toBSON()),
+                  "numOps"_attr = std::distance(begin, end),
+                  "duration"_attr = Milliseconds(opDuration));
+        }
+    }
+    return status;
+}
+
 Status OplogApplierImpl::applyOplogBatchPerWorker(OperationContext* opCtx,
                                                   std::vector<const OplogEntry*>* ops,
                                                   WorkerMultikeyPathInfo* workerMultikeyPathInfo) {
@@ -1037,6 +1158,7 @@ Status OplogApplierImpl::applyOplogBatchPerWorker(OperationContext* opCtx,
     const auto oplogApplicationMode = getOptions().mode;
 
     InsertGroup insertGroup(ops, opCtx, oplogApplicationMode);
+    UpdateDeleteGroup updateDeleteGroup(ops, opCtx, oplogApplicationMode);
 
     {  // Ensure that the MultikeyPathTracker stops tracking paths.
         ON_BLOCK_EXIT([opCtx] { MultikeyPathTracker::get(opCtx).stopTrackingMultikeyPathInfo(); });
@@ -1053,6 +1175,13 @@ Status OplogApplierImpl::applyOplogBatchPerWorker(OperationContext* opCtx,
                 continue;
             }
 
+            // Likewise for a run of updates and deletes on the same collection.
+            groupResult = updateDeleteGroup.groupAndApplyUpdatesAndDeletes(it);
+            if (groupResult.isOK()) {
+                it = groupResult.getValue();
+                continue;
+            }
+
             // If we didn't create a group, try to apply the op individually.
             try {
                 const Status status =
@@ -35,6 +35,7 @@
 #include "mongo/db/concurrency/replication_state_transition_lock_guard.h"
 #include "mongo/db/repl/initial_syncer.h"
 #include "mongo/db/repl/oplog_applier.h"
+#include "mongo/db/repl/oplog_prefetcher.h"
 #include "mongo/db/repl/replication_consistency_markers.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_metrics.h"
@@ -98,6 +99,11 @@ private:
      */
     StatusWith<OpTime> _applyOplogBatch(OperationContext* opCtx, std::vector<OplogEntry> ops);
 
+    /**
+     * Hands the batch to the OplogPrefetcher, if prefetching is enabled.
+     */
+    void _prefetchBatch(const std::vector<OplogEntry>& ops) override;
+
     void _deriveOpsAndFillWriterVectors(OperationContext* opCtx,
                                         std::vector<OplogEntry>* ops,
                                         std::vector<std::vector<const OplogEntry*>>* writerVectors,
@@ -111,6 +117,9 @@ private:
     // Not owned by us.
     ThreadPool* const _writerPool;
 
+    // Reads the data of upcoming batches into the cache. Null if 'replPrefetchThreads' is 0.
+    std::unique_ptr<OplogPrefetcher> _prefetcher;
+
     StorageInterface* _storageInterface;
 
     ReplicationConsistencyMarkers* const _consistencyMarkers;
@@ -146,5 +155,15 @@ Status applyOplogEntryOrGroupedInserts(OperationContext* opCtx,
                                        const OplogEntryOrGroupedInserts& entryOrGroupedInserts,
                                        OplogApplication::Mode oplogApplicationMode);
 
+/**
+ * Applies a run of update and delete operations on the same collection, ['begin', 'end'), in a
+ * single write unit of work. Each operation is timestamped with its own oplog entry's timestamp.
+ * Nothing is applied if any of the operations fails.
+ */
+Status applyGroupedUpdatesAndDeletes(OperationContext* opCtx,
+                                     std::vector<const OplogEntry*>::const_iterator begin,
+                                     std::vector<const OplogEntry*>::const_iterator end,
+                                     OplogApplication::Mode oplogApplicationMode);
+
 }  // namespace repl
 }  // namespace mongo
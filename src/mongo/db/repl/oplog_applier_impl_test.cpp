@@ -57,6 +57,7 @@
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/repl/oplog_entry_test_helpers.h"
+#include "mongo/db/repl/oplog_prefetcher.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_process.h"
@@ -557,6 +558,101 @@ TEST_F(OplogApplierImplTest,
                                                      createOplogCollectionOptions()));
 }
 
+/**
+ * Records the operations handed to each applyOplogBatchPerWorker() call, which may come from
+ * several writer threads at once.
+ */
+class TrackWriterPartitionsApplier : public OplogApplierImpl {
+public:
+    using OplogApplierImpl::OplogApplierImpl;
+
+    Status applyOplogBatchPerWorker(OperationContext* opCtx,
+                                    std::vector<const OplogEntry*>* ops,
+                                    WorkerMultikeyPathInfo* workerMultikeyPathInfo) override {
+        stdx::lock_guard<Latch> lock(_mutex);
+        partitionsApplied.emplace_back();
+        for (auto&& opPtr : *ops) {
+            partitionsApplied.back().push_back(opPtr->getOpTime());
+        }
+        return Status::OK();
+    }
+
+    std::vector<std::vector<OpTime>> partitionsApplied;
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("TrackWriterPartitionsApplier::_mutex");
+};
+
+TEST_F(OplogApplierImplTest, MultiApplyDividesBatchIntoMoreWriterPartitionsThanWriterThreads) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    const int numWriterThreads = 2;
+    const int partitionsPerThread = 4;
+    const auto originalPartitionsPerThread = replWriterPartitionsPerThread.load();
+    replWriterPartitionsPerThread.store(partitionsPerThread);
+    ON_BLOCK_EXIT([&] { replWriterPartitionsPerThread.store(originalPartitionsPerThread); });
+
+    // Most updates target one hot document, the rest are spread over many documents.
+    std::vector<OplogEntry> ops;
+    std::vector<OpTime> hotDocumentOpTimes;
+    for (int i = 1; i <= 100; ++i) {
+        const int id = i % 2 ? 0 : i;
+        ops.push_back(makeUpdateDocumentOplogEntry({Timestamp(Seconds(1), i), 1LL},
+                                                   nss,
+                                                   BSON("_id" << id),
+                                                   BSON("$set" << BSON("x" << i))));
+        if (id == 0) {
+            hotDocumentOpTimes.push_back(ops.back().getOpTime());
+        }
+    }
+
+    auto writerPool = makeReplWriterPool(numWriterThreads);
+    NoopOplogApplierObserver observer;
+    TrackWriterPartitionsApplier oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+    ASSERT_EQUALS(ops.back().getOpTime(),
+                  unittest::assertGet(oplogApplier.applyOplogBatch(_opCtx.get(), ops)));
+
+    // The two writer threads shared the work of more than two partitions between them.
+    const auto& partitions = oplogApplier.partitionsApplied;
+    ASSERT_GT(partitions.size(), size_t(numWriterThreads));
+    ASSERT_LTE(partitions.size(), size_t(numWriterThreads * partitionsPerThread));
+
+    // Every operation was applied exactly once, and all the updates to the hot document were
+    // applied in oplog order by the same partition.
+    std::vector<OpTime> applied;
+    size_t partitionsWithHotDocument = 0;
+    for (const auto& partition : partitions) {
+        applied.insert(applied.end(), partition.begin(), partition.end());
+        if (std::find(partition.begin(), partition.end(), hotDocumentOpTimes.front()) !=
+            partition.end()) {
+            ++partitionsWithHotDocument;
+            std::vector<OpTime> hotDocumentOps;
+            std::copy_if(partition.begin(),
+                         partition.end(),
+                         std::back_inserter(hotDocumentOps),
+                         [&](const OpTime& opTime) {
+                             return std::find(hotDocumentOpTimes.begin(),
+                                              hotDocumentOpTimes.end(),
+                                              opTime) != hotDocumentOpTimes.end();
+                         });
+            ASSERT(hotDocumentOps == hotDocumentOpTimes);
+        }
+    }
+    ASSERT_EQUALS(1U, partitionsWithHotDocument);
+    ASSERT_EQUALS(ops.size(), applied.size());
+    std::sort(applied.begin(), applied.end());
+    for (size_t i = 0; i < ops.size(); ++i) {
+        ASSERT_EQUALS(ops[i].getOpTime(), applied[i]);
+    }
+}
+
 TEST_F(OplogApplierImplTest,
        OplogApplicationThreadFuncUsesApplyOplogEntryOrGroupedInsertsToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
@@ -1605,6 +1701,64 @@ TEST_F(OplogApplierImplTest, OplogApplicationThreadFuncFailsWhenCollectionCreati
                   oplogApplier.applyOplogBatchPerWorker(_opCtx.get(), &ops, nullptr));
 }
 
+class OplogPrefetcherTest : public OplogApplierImplTest {
+public:
+    void setUp() override {
+        OplogApplierImplTest::setUp();
+        ASSERT_OK(
+            ReplicationCoordinator::get(_opCtx.get())->setFollowerMode(MemberState::RS_SECONDARY));
+
+        ASSERT_OK(runOpSteadyState(makeCreateCollectionOplogEntry(
+            {Timestamp(Seconds(1), 0), 1LL}, _nss, BSON("uuid" << kUuid))));
+        ASSERT_OK(runOpSteadyState(makeCreateIndexOplogEntry(
+            {Timestamp(Seconds(2), 0), 1LL}, _nss, "a_1", BSON("a" << 1), kUuid)));
+        ASSERT_OK(runOpSteadyState(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(3), 0), 1LL}, _nss, BSON("_id" << 0 << "a" << 0))));
+    }
+
+protected:
+    const NamespaceString _nss{"test.prefetch"};
+};
+
+TEST_F(OplogPrefetcherTest, PrefetchOpDoesNotModifyData) {
+    const std::vector<OplogEntry> ops = {
+        makeOplogEntry(OpTypeEnum::kInsert, _nss, kUuid, BSON("_id" << 1 << "a" << 1), boost::none),
+        makeOplogEntry(OpTypeEnum::kUpdate,
+                       _nss,
+                       kUuid,
+                       BSON("$set" << BSON("a" << 2)),
+                       BSON("_id" << 0)),
+        makeOplogEntry(OpTypeEnum::kDelete, _nss, kUuid, BSON("_id" << 0), boost::none),
+        // Neither a missing document nor an unknown collection is an error.
+        makeOplogEntry(OpTypeEnum::kDelete, _nss, kUuid, BSON("_id" << 2), boost::none),
+        makeOplogEntry(OpTypeEnum::kDelete, _nss, UUID::gen(), BSON("_id" << 0), boost::none),
+    };
+
+    for (const auto& op : ops) {
+        OplogPrefetcher::prefetchOp(_opCtx.get(), op);
+    }
+
+    ASSERT_TRUE(docExists(_opCtx.get(), _nss, BSON("_id" << 0 << "a" << 0)));
+    ASSERT_FALSE(docExists(_opCtx.get(), _nss, BSON("_id" << 1 << "a" << 1)));
+}
+
+TEST_F(OplogPrefetcherTest, PrefetchBatchOnThreadPool) {
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 10; ++i) {
+        ops.push_back(makeOplogEntry(
+            OpTypeEnum::kUpdate, _nss, kUuid, BSON("$set" << BSON("a" << i)), BSON("_id" << 0)));
+    }
+    // Commands are not prefetched.
+    ops.push_back(makeOplogEntry(OpTypeEnum::kCommand, _nss, kUuid, BSON("create" << "x"), {}));
+
+    OplogPrefetcher prefetcher(2);
+    prefetcher.prefetch(ops);
+    prefetcher.prefetch(ops);
+    prefetcher.waitForIdle_forTest();
+
+    ASSERT_TRUE(docExists(_opCtx.get(), _nss, BSON("_id" << 0 << "a" << 0)));
+}
+
 TEST_F(OplogApplierImplTest,
        OplogApplicationThreadFuncDisablesDocumentValidationWhileApplyingOperations) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
@@ -1736,6 +1890,56 @@ TEST_F(OplogApplierImplTest,
     ASSERT_BSONOBJ_EQ(insertOp2b.getObject(), group2[1]);
 }
 
+TEST_F(OplogApplierImplTest,
+       OplogApplicationThreadFuncGroupsUpdateAndDeleteOperationsOnTheSameCollection) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    createCollectionWithUuid(_opCtx.get(), nss);
+
+    const Seconds s(1);
+    unsigned int i = 1;
+    std::vector<OplogEntry> inserts;
+    for (int id = 1; id <= 3; ++id) {
+        inserts.push_back(
+            makeInsertDocumentOplogEntry({Timestamp(s, i++), 1LL}, nss, BSON("_id" << id)));
+    }
+    ASSERT_OK(runOpsSteadyState(inserts));
+
+    // Updates and deletes applied in one write unit of work observe the same snapshot.
+    std::vector<SnapshotId> snapshotIds;
+    _opObserver->onUpdateFn = [&](OperationContext* opCtx, const OplogUpdateEntryArgs&) {
+        snapshotIds.push_back(opCtx->recoveryUnit()->getSnapshotId());
+    };
+    _opObserver->onDeleteFn = [&](OperationContext* opCtx,
+                                  const NamespaceString&,
+                                  OptionalCollectionUUID,
+                                  StmtId,
+                                  bool,
+                                  const boost::optional<BSONObj>&) {
+        snapshotIds.push_back(opCtx->recoveryUnit()->getSnapshotId());
+    };
+
+    auto updateOp1 = makeUpdateDocumentOplogEntry(
+        {Timestamp(s, i++), 1LL}, nss, BSON("_id" << 1), BSON("_id" << 1 << "x" << 1));
+    auto deleteOp2 = makeDeleteDocumentOplogEntry({Timestamp(s, i++), 1LL}, nss, BSON("_id" << 2));
+    auto updateOp3 = makeUpdateDocumentOplogEntry(
+        {Timestamp(s, i++), 1LL}, nss, BSON("_id" << 3), BSON("_id" << 3 << "x" << 3));
+
+    TestApplyOplogGroupApplier oplogApplier(
+        nullptr, nullptr, OplogApplier::Options(OplogApplication::Mode::kSecondary));
+    std::vector<const OplogEntry*> ops = {&updateOp1, &deleteOp2, &updateOp3};
+    WorkerMultikeyPathInfo pathInfo;
+    ASSERT_OK(oplogApplier.applyOplogBatchPerWorker(_opCtx.get(), &ops, &pathInfo));
+
+    ASSERT_EQUALS(3U, snapshotIds.size());
+    ASSERT(snapshotIds[0] == snapshotIds[1]);
+    ASSERT(snapshotIds[1] == snapshotIds[2]);
+
+    CollectionReader collectionReader(_opCtx.get(), nss);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 1 << "x" << 1), unittest::assertGet(collectionReader.next()));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 3 << "x" << 3), unittest::assertGet(collectionReader.next()));
+    ASSERT_EQUALS(ErrorCodes::CollectionIsEmpty, collectionReader.next().getStatus());
+}
+
 TEST_F(OplogApplierImplTest,
        OplogApplicationThreadFuncLimitsBatchCountWhenGroupingInsertOperation) {
     int seconds = 1;
@@ -38,6 +38,7 @@
 #include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/repl/oplog_batcher_test_fixture.h"
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_buffer_ring_buffer.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -78,14 +79,20 @@ public:
     void tearDown() final;
 
 protected:
+    virtual std::unique_ptr<OplogBuffer> _makeBuffer();
+
     std::unique_ptr<OplogBuffer> _buffer;
     std::unique_ptr<OplogApplier> _applier;
     std::unique_ptr<OperationContext> _opCtx;
     OplogApplier::BatchLimits _limits;
 };
 
+std::unique_ptr<OplogBuffer> OplogApplierTest::_makeBuffer() {
+    return std::make_unique<OplogBufferBlockingQueue>(nullptr);
+}
+
 void OplogApplierTest::setUp() {
-    _buffer = std::make_unique<OplogBufferBlockingQueue>(nullptr);
+    _buffer = _makeBuffer();
     _applier = std::make_unique<OplogApplierMock>(_buffer.get());
     // The OplogApplier interface expects an OperationContext* but the mock implementations in this
     // test will not be dereferencing the pointer. Therefore, it is sufficient to use an
@@ -347,6 +354,70 @@ TEST_F(OplogApplierTest, LastOpInLargeTransactionIsProcessedIndividually) {
     ASSERT_EQUALS(srcOps[4], batch[0]);
 }
 
+/**
+ * Runs the batcher over a ring buffer, which lets it peek at many entries at once.
+ */
+class OplogApplierRingBufferTest : public OplogApplierTest {
+protected:
+    std::unique_ptr<OplogBuffer> _makeBuffer() override {
+        return std::make_unique<OplogBufferRingBuffer>(nullptr, 16, 1024 * 1024);
+    }
+};
+
+TEST_F(OplogApplierRingBufferTest, GetNextApplierBatchPopsOnlyTheEntriesOfTheBatch) {
+    std::vector<OplogEntry> srcOps;
+    srcOps.push_back(makeInsertOplogEntry(1, NamespaceString(dbName, "bar")));
+    srcOps.push_back(makeInsertOplogEntry(2, NamespaceString(dbName, "bar")));
+    srcOps.push_back(makeApplyOpsOplogEntry(3, true));
+    srcOps.push_back(makeInsertOplogEntry(4, NamespaceString(dbName, "bar")));
+    srcOps.push_back(makeInsertOplogEntry(5, NamespaceString(dbName, "bar")));
+    _applier->enqueue(_opCtx.get(), srcOps.cbegin(), srcOps.cend());
+
+    // First batch: [insert, insert]. The prepared applyOps stays in the buffer.
+    auto batch = unittest::assertGet(_applier->getNextApplierBatch(_opCtx.get(), _limits));
+    ASSERT_EQUALS(2U, batch.size()) << toString(batch);
+    ASSERT_EQUALS(srcOps[0], batch[0]);
+    ASSERT_EQUALS(srcOps[1], batch[1]);
+    ASSERT_EQUALS(3U, _buffer->getCount());
+
+    // Second batch: [applyOps]
+    batch = unittest::assertGet(_applier->getNextApplierBatch(_opCtx.get(), _limits));
+    ASSERT_EQUALS(1U, batch.size()) << toString(batch);
+    ASSERT_EQUALS(srcOps[2], batch[0]);
+    ASSERT_EQUALS(2U, _buffer->getCount());
+
+    // Third batch: [insert, insert]
+    batch = unittest::assertGet(_applier->getNextApplierBatch(_opCtx.get(), _limits));
+    ASSERT_EQUALS(2U, batch.size()) << toString(batch);
+    ASSERT_EQUALS(srcOps[3], batch[0]);
+    ASSERT_EQUALS(srcOps[4], batch[1]);
+    ASSERT_TRUE(_buffer->isEmpty());
+}
+
+TEST_F(OplogApplierRingBufferTest, GetNextApplierBatchChecksBatchLimitsForNumberOfOperations) {
+    std::vector<OplogEntry> srcOps;
+    for (int t = 1; t <= 5; ++t) {
+        srcOps.push_back(makeInsertOplogEntry(t, NamespaceString(dbName, "bar")));
+    }
+    _applier->enqueue(_opCtx.get(), srcOps.cbegin(), srcOps.cend());
+
+    _limits.ops = 3U;
+
+    // First batch: [insert, insert, insert]
+    auto batch = unittest::assertGet(_applier->getNextApplierBatch(_opCtx.get(), _limits));
+    ASSERT_EQUALS(3U, batch.size()) << toString(batch);
+    ASSERT_EQUALS(srcOps[0], batch[0]);
+    ASSERT_EQUALS(srcOps[2], batch[2]);
+    ASSERT_EQUALS(2U, _buffer->getCount());
+
+    // Second batch: [insert, insert]
+    batch = unittest::assertGet(_applier->getNextApplierBatch(_opCtx.get(), _limits));
+    ASSERT_EQUALS(2U, batch.size()) << toString(batch);
+    ASSERT_EQUALS(srcOps[3], batch[0]);
+    ASSERT_EQUALS(srcOps[4], batch[1]);
+    ASSERT_TRUE(_buffer->isEmpty());
+}
+
 }  // namespace
 }  // namespace repl
 }  // namespace mongo
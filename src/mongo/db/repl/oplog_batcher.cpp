@@ -36,6 +36,7 @@
 #include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -166,73 +167,104 @@ StatusWith<std::vector<OplogEntry>> OplogBatcher::getNextApplierBatch(
     std::size_t totalOps = 0;
     std::uint32_t totalBytes = 0;
     std::vector<OplogEntry> ops;
-    BSONObj op;
-    while (_oplogBuffer->peek(opCtx, &op)) {
-        auto entry = OplogEntry(op);
-
-        // Check for oplog version change.
-        if (entry.getVersion() != OplogEntry::kOplogVersion) {
-            static constexpr char message[] = "Unexpected oplog version";
-            LOGV2_FATAL_CONTINUE(21240,
-                                 message,
-                                 "expectedVersion"_attr = OplogEntry::kOplogVersion,
-                                 "foundVersion"_attr = entry.getVersion(),
-                                 "oplogEntry"_attr = redact(entry.toBSON()));
-            return {ErrorCodes::BadValue,
-                    str::stream() << message << ", expected oplog version "
-                                  << OplogEntry::kOplogVersion << ", found version "
-                                  << entry.getVersion()
-                                  << ", oplog entry: " << redact(entry.toBSON())};
+
+    // Entries are peeked from the buffer a chunk at a time. The entries which join the batch are
+    // popped together, before the next chunk is peeked and once the batch is complete.
+    OplogBuffer::Batch peeked;
+    std::size_t numToPop = 0;
+    ON_BLOCK_EXIT([&] { _consume(opCtx, numToPop); });
+
+    while (totalOps < batchLimits.ops) {
+        _consume(opCtx, numToPop);
+        numToPop = 0;
+        peeked.clear();
+        if (!_oplogBuffer->peekBatch(opCtx, batchLimits.ops - totalOps, &peeked)) {
+            break;
         }
 
-        if (batchLimits.slaveDelayLatestTimestamp) {
-            auto entryTime =
-                Date_t::fromDurationSinceEpoch(Seconds(entry.getTimestamp().getSecs()));
-            if (entryTime > *batchLimits.slaveDelayLatestTimestamp) {
+        for (const auto& op : peeked) {
+            auto entry = _parseEntry(op);
+
+            // Check for oplog version change.
+            if (entry.getVersion() != OplogEntry::kOplogVersion) {
+                static constexpr char message[] = "Unexpected oplog version";
+                LOGV2_FATAL_CONTINUE(21240,
+                                     message,
+                                     "expectedVersion"_attr = OplogEntry::kOplogVersion,
+                                     "foundVersion"_attr = entry.getVersion(),
+                                     "oplogEntry"_attr = redact(op));
+                return {ErrorCodes::BadValue,
+                        str::stream() << message << ", expected oplog version "
+                                      << OplogEntry::kOplogVersion << ", found version "
+                                      << entry.getVersion() << ", oplog entry: " << redact(op)};
+            }
+
+            if (batchLimits.slaveDelayLatestTimestamp) {
+                auto entryTime =
+                    Date_t::fromDurationSinceEpoch(Seconds(entry.getTimestamp().getSecs()));
+                if (entryTime > *batchLimits.slaveDelayLatestTimestamp) {
+                    if (ops.empty()) {
+                        // Sleep if we've got nothing to do. Only sleep for 1 second at a time to
+                        // allow reconfigs and shutdown to occur.
+                        sleepsecs(1);
+                    }
+                    _lookahead = std::move(entry);
+                    return std::move(ops);
+                }
+            }
+
+            if (mustProcessIndividually(entry)) {
                 if (ops.empty()) {
-                    // Sleep if we've got nothing to do. Only sleep for 1 second at a time to allow
-                    // reconfigs and shutdown to occur.
-                    sleepsecs(1);
+                    ops.push_back(std::move(entry));
+                    ++numToPop;
                 }
+
+                // Otherwise, apply what we have so far and come back for this entry.
+                _lookahead = std::move(entry);
                 return std::move(ops);
             }
-        }
 
-        if (mustProcessIndividually(entry)) {
-            if (ops.empty()) {
-                ops.push_back(std::move(entry));
-                _consume(opCtx, _oplogBuffer);
+            // Apply replication batch limits. Avoid returning an empty batch.
+            auto opCount = getOpCount(entry);
+            auto opBytes = entry.getRawObjSizeBytes();
+            if (totalOps > 0) {
+                if (totalOps + opCount > batchLimits.ops ||
+                    totalBytes + opBytes > batchLimits.bytes) {
+                    _lookahead = std::move(entry);
+                    return std::move(ops);
+                }
             }
 
-            // Otherwise, apply what we have so far and come back for this entry.
-            return std::move(ops);
-        }
-
-        // Apply replication batch limits. Avoid returning an empty batch.
-        auto opCount = getOpCount(entry);
-        auto opBytes = entry.getRawObjSizeBytes();
-        if (totalOps > 0) {
-            if (totalOps + opCount > batchLimits.ops || totalBytes + opBytes > batchLimits.bytes) {
+            // If we have a forced batch boundary, apply it.
+            if (totalOps > 0 && !batchLimits.forceBatchBoundaryAfter.isNull() &&
+                entry.getOpTime().getTimestamp() > batchLimits.forceBatchBoundaryAfter &&
+                ops.back().getOpTime().getTimestamp() <= batchLimits.forceBatchBoundaryAfter) {
+                _lookahead = std::move(entry);
                 return std::move(ops);
             }
-        }
 
-        // If we have a forced batch boundary, apply it.
-        if (totalOps > 0 && !batchLimits.forceBatchBoundaryAfter.isNull() &&
-            entry.getOpTime().getTimestamp() > batchLimits.forceBatchBoundaryAfter &&
-            ops.back().getOpTime().getTimestamp() <= batchLimits.forceBatchBoundaryAfter) {
-            return std::move(ops);
+            // Add op to buffer.
+            totalOps += opCount;
+            totalBytes += opBytes;
+            ops.push_back(std::move(entry));
+            ++numToPop;
         }
-
-        // Add op to buffer.
-        totalOps += opCount;
-        totalBytes += opBytes;
-        ops.push_back(std::move(entry));
-        _consume(opCtx, _oplogBuffer);
     }
     return std::move(ops);
 }
 
+OplogEntry OplogBatcher::_parseEntry(const BSONObj& op) {
+    // An entry peeked again is the same BSONObj. The saved entry shares its buffer and keeps it
+    // alive, so no other entry can be at the same address.
+    if (_lookahead && _lookahead->getRaw().objdata() == op.objdata()) {
+        auto entry = std::move(*_lookahead);
+        _lookahead.reset();
+        return entry;
+    }
+    _lookahead.reset();
+    return OplogEntry(op);
+}
+
 /**
  * If slaveDelay is enabled, this function calculates the most recent timestamp of any oplog
  * entries that can be be returned in a batch.
@@ -248,15 +280,18 @@ boost::optional<Date_t> OplogBatcher::_calculateSlaveDelayLatestTimestamp() {
     return fastClockSource->now() - slaveDelay;
 }
 
-void OplogBatcher::_consume(OperationContext* opCtx, OplogBuffer* oplogBuffer) {
-    // This is just to get the op off the buffer; it's been peeked at and queued for application
-    // already.
-    // If we failed to get an op off the buffer, this means that shutdown() was called between the
-    // consumer's calls to peek() and consume(). shutdown() cleared the buffer so there is nothing
-    // for us to consume here. Since our postcondition is already met, it is safe to return
-    // successfully.
-    BSONObj opToPopAndDiscard;
-    invariant(oplogBuffer->tryPop(opCtx, &opToPopAndDiscard) || _oplogApplier->inShutdown());
+void OplogBatcher::_consume(OperationContext* opCtx, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    // This is just to get the ops off the buffer; they've been peeked at and queued for
+    // application already.
+    // If we failed to get the ops off the buffer, this means that shutdown() was called between
+    // the consumer's calls to peekBatch() and consume(). shutdown() cleared the buffer so there is
+    // nothing for us to consume here. Since our postcondition is already met, it is safe to
+    // return successfully.
+    invariant(_oplogBuffer->tryPopBatch(opCtx, count) == count || _oplogApplier->inShutdown());
 }
 
 void OplogBatcher::_run(StorageInterface* storageInterface) {
@@ -290,8 +325,8 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
 
             auto oplogEntries =
                 fassertNoTrace(31004, getNextApplierBatch(opCtx.get(), batchLimits));
-            for (const auto& oplogEntry : oplogEntries) {
-                ops.emplace_back(oplogEntry);
+            for (auto& oplogEntry : oplogEntries) {
+                ops.emplace_back(std::move(oplogEntry));
             }
 
             // If we don't have anything in the batch, wait a bit for something to appear.
@@ -337,6 +372,11 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
             }
         }
 
+        // Start warming the cache for this batch while the previous one is still being applied.
+        if (!ops.empty()) {
+            _oplogApplier->prefetchBatch(ops.getBatch());
+        }
+
         stdx::unique_lock<Latch> lk(_mutex);
         // Block until the previous batch has been taken.
         _cv.wait(lk, [&] { return _ops.empty() && !_ops.termWhenExhausted(); });
@@ -193,15 +193,25 @@ private:
     boost::optional<Date_t> _calculateSlaveDelayLatestTimestamp();
 
     /**
-     * Pops the operation at the front of the OplogBuffer.
+     * Parses 'op', unless it is the entry which ended the previous batch without joining it, in
+     * which case that entry is returned as parsed then.
      */
-    void _consume(OperationContext* opCtx, OplogBuffer* oplogBuffer);
+    OplogEntry _parseEntry(const BSONObj& op);
+
+    /**
+     * Pops the 'count' operations at the front of the OplogBuffer.
+     */
+    void _consume(OperationContext* opCtx, std::size_t count);
 
     void _run(StorageInterface* storageInterface);
 
     OplogApplier* _oplogApplier;
     OplogBuffer* const _oplogBuffer;
 
+    // The entry which ended the last batch without joining it. It is at the front of the buffer,
+    // and is the first entry the next batch looks at.
+    boost::optional<OplogEntry> _lookahead;
+
     Mutex _mutex = MONGO_MAKE_LATCH("OplogBatcher::_mutex");
     stdx::condition_variable _cv;
 
@@ -148,6 +148,33 @@ public:
      */
     virtual bool peek(OperationContext* opCtx, Value* value) = 0;
 
+    /**
+     * Appends up to "maxCount" items from the front of the oplog buffer to "batch", in order,
+     * without removing them, and returns the number of items appended. Implementations that can
+     * only peek at the front item append at most one.
+     */
+    virtual std::size_t peekBatch(OperationContext* opCtx, std::size_t maxCount, Batch* batch) {
+        Value value;
+        if (maxCount == 0 || !peek(opCtx, &value)) {
+            return 0;
+        }
+        batch->push_back(std::move(value));
+        return 1;
+    }
+
+    /**
+     * Removes up to "count" items from the front of the oplog buffer. Returns the number of items
+     * removed, which is less than "count" only if the buffer held fewer items.
+     */
+    virtual std::size_t tryPopBatch(OperationContext* opCtx, std::size_t count) {
+        Value ignored;
+        std::size_t popped = 0;
+        while (popped < count && tryPop(opCtx, &ignored)) {
+            ++popped;
+        }
+        return popped;
+    }
+
     /**
      * Returns the item most recently added to the oplog buffer or nothing if the buffer is empty.
      */
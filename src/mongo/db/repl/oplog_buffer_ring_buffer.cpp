@@ -0,0 +1,334 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_buffer_ring_buffer.h"
+
+#include <algorithm>
+
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+namespace repl {
+
+namespace {
+
+// Limit buffer to 256MB, like OplogBufferBlockingQueue.
+const size_t kOplogBufferSize = 256 * 1024 * 1024;
+
+size_t getDocumentSize(const BSONObj& o) {
+    // SERVER-9808 Avoid Fortify complaint about implicit signed->unsigned conversion
+    return static_cast<size_t>(o.objsize());
+}
+
+std::size_t roundUpToPowerOfTwo(std::size_t n) {
+    std::size_t powerOfTwo = 1;
+    while (powerOfTwo < n) {
+        powerOfTwo <<= 1;
+    }
+    return powerOfTwo;
+}
+
+}  // namespace
+
+OplogBufferRingBuffer::OplogBufferRingBuffer() : OplogBufferRingBuffer(nullptr) {}
+OplogBufferRingBuffer::OplogBufferRingBuffer(Counters* counters)
+    : OplogBufferRingBuffer(counters, kDefaultCapacity, kOplogBufferSize) {}
+OplogBufferRingBuffer::OplogBufferRingBuffer(Counters* counters,
+                                             std::size_t capacity,
+                                             std::size_t maxSize)
+    : _counters(counters),
+      _maxSize(maxSize),
+      _capacity(roundUpToPowerOfTwo(std::max(capacity, std::size_t(1)))),
+      _mask(_capacity - 1),
+      _slots(_capacity) {}
+
+void OplogBufferRingBuffer::startup(OperationContext*) {
+    // Update server status metric to reflect the current oplog buffer's max size.
+    if (_counters) {
+        _counters->setMaxSize(getMaxSize());
+    }
+}
+
+void OplogBufferRingBuffer::shutdown(OperationContext* opCtx) {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _inShutdown.store(true);
+        _notFullCv.notify_all();
+        _notEmptyCv.notify_all();
+    }
+    clear(opCtx);
+}
+
+void OplogBufferRingBuffer::push(OperationContext*,
+                                 Batch::const_iterator begin,
+                                 Batch::const_iterator end) {
+    invariant(!_drainMode.load());
+    if (begin == end) {
+        return;
+    }
+
+    _lastPushed = *std::prev(end);
+
+    auto tail = _tail.loadRelaxed();
+    while (begin != end) {
+        // A batch larger than the free space is published in parts, so the consumer can make
+        // room for the rest of it.
+        const auto freeSlots = _waitForFreeSlots();
+        if (freeSlots == 0) {
+            return;
+        }
+
+        std::size_t bytes = 0;
+        std::size_t count = 0;
+        for (; begin != end && count < freeSlots; ++begin, ++count) {
+            auto& slot = _slots[(tail + count) & _mask];
+            slot = *begin;
+            bytes += getDocumentSize(slot);
+        }
+
+        // Account for the bytes before publishing the entries, so the consumer never subtracts
+        // the size of an entry that has not been added yet.
+        _size.fetchAndAdd(bytes);
+        tail += count;
+        _tail.store(tail);
+        if (_counters) {
+            _counters->count.increment(count);
+            _counters->size.increment(bytes);
+        }
+
+        _notifyConsumer();
+    }
+}
+
+void OplogBufferRingBuffer::waitForSpace(OperationContext*, std::size_t size) {
+    auto hasSpace = [&] {
+        return _size.load() + size <= _maxSize || _inShutdown.load();
+    };
+    if (hasSpace()) {
+        return;
+    }
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    _producerWaiting.store(true);
+    _notFullCv.wait(lk, hasSpace);
+    _producerWaiting.store(false);
+}
+
+bool OplogBufferRingBuffer::isEmpty() const {
+    return _head.load() == _tail.load();
+}
+
+std::size_t OplogBufferRingBuffer::getMaxSize() const {
+    return _maxSize;
+}
+
+std::size_t OplogBufferRingBuffer::getSize() const {
+    return _size.load();
+}
+
+std::size_t OplogBufferRingBuffer::getCount() const {
+    // Read the consumer position first, so a concurrent pop cannot make the count negative.
+    const auto head = _head.load();
+    return _tail.load() - head;
+}
+
+std::size_t OplogBufferRingBuffer::getCapacity() const {
+    return _capacity;
+}
+
+void OplogBufferRingBuffer::clear(OperationContext*) {
+    stdx::lock_guard<Latch> lk(_clearMutex);
+
+    // Wait for the consumer to leave the buffer. It sees an empty buffer until '_clearing' is
+    // reset, and it never spends longer in the buffer than it takes to copy out a batch.
+    _clearing.store(true);
+    while (_consumerActive.load()) {
+        stdx::this_thread::yield();
+    }
+
+    const auto head = _head.loadRelaxed();
+    const auto tail = _tail.load();
+    _popSlots(head, tail - head);
+    _clearing.store(false);
+}
+
+bool OplogBufferRingBuffer::tryPop(OperationContext*, Value* value) {
+    if (!_enterConsumer()) {
+        return false;
+    }
+    const auto head = _head.loadRelaxed();
+    const bool found = head != _tail.load();
+    if (found) {
+        *value = _slots[head & _mask];
+        _popSlots(head, 1);
+    }
+    _leaveConsumer();
+    return found;
+}
+
+std::size_t OplogBufferRingBuffer::tryPopBatch(OperationContext*, std::size_t count) {
+    if (!_enterConsumer()) {
+        return 0;
+    }
+    const auto head = _head.loadRelaxed();
+    const auto popped = std::min<std::uint64_t>(_tail.load() - head, count);
+    if (popped > 0) {
+        _popSlots(head, popped);
+    }
+    _leaveConsumer();
+    return popped;
+}
+
+bool OplogBufferRingBuffer::waitForData(Seconds waitDuration) {
+    auto hasData = [&] {
+        return !isEmpty() || _drainMode.load() || _inShutdown.load();
+    };
+    if (!hasData()) {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _consumerWaiting.store(true);
+        _notEmptyCv.wait_for(lk, waitDuration.toSystemDuration(), hasData);
+        _consumerWaiting.store(false);
+    }
+    return !isEmpty();
+}
+
+bool OplogBufferRingBuffer::peek(OperationContext*, Value* value) {
+    if (!_enterConsumer()) {
+        return false;
+    }
+    const auto head = _head.loadRelaxed();
+    const bool found = head != _tail.load();
+    if (found) {
+        *value = _slots[head & _mask];
+    }
+    _leaveConsumer();
+    return found;
+}
+
+std::size_t OplogBufferRingBuffer::peekBatch(OperationContext*,
+                                             std::size_t maxCount,
+                                             Batch* batch) {
+    if (!_enterConsumer()) {
+        return 0;
+    }
+    const auto head = _head.loadRelaxed();
+    const auto count = std::min<std::uint64_t>(_tail.load() - head, maxCount);
+    for (std::uint64_t position = head; position != head + count; ++position) {
+        batch->push_back(_slots[position & _mask]);
+    }
+    _leaveConsumer();
+    return count;
+}
+
+boost::optional<OplogBuffer::Value> OplogBufferRingBuffer::lastObjectPushed(
+    OperationContext*) const {
+    if (isEmpty()) {
+        return boost::none;
+    }
+    return _lastPushed;
+}
+
+void OplogBufferRingBuffer::enterDrainMode() {
+    _drainMode.store(true);
+    stdx::lock_guard<Latch> lk(_mutex);
+    _notEmptyCv.notify_one();
+}
+
+void OplogBufferRingBuffer::exitDrainMode() {
+    _drainMode.store(false);
+}
+
+bool OplogBufferRingBuffer::_enterConsumer() {
+    _consumerActive.store(true);
+    if (_clearing.load()) {
+        _consumerActive.store(false);
+        return false;
+    }
+    return true;
+}
+
+void OplogBufferRingBuffer::_leaveConsumer() {
+    _consumerActive.store(false);
+}
+
+std::size_t OplogBufferRingBuffer::_popSlots(std::uint64_t head, std::size_t count) {
+    std::size_t bytes = 0;
+    for (auto position = head; position != head + count; ++position) {
+        // Release the entry, so that the slot does not keep its buffer alive.
+        auto& slot = _slots[position & _mask];
+        bytes += getDocumentSize(slot);
+        slot = Value();
+    }
+    _releaseSlots(head + count, count, bytes);
+    return bytes;
+}
+
+std::size_t OplogBufferRingBuffer::_waitForFreeSlots() {
+    auto freeSlots = [&] {
+        return _capacity - (_tail.loadRelaxed() - _head.load());
+    };
+    if (freeSlots() == 0) {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _producerWaiting.store(true);
+        _notFullCv.wait(lk, [&] { return freeSlots() > 0 || _inShutdown.load(); });
+        _producerWaiting.store(false);
+    }
+    return _inShutdown.load() ? 0 : freeSlots();
+}
+
+void OplogBufferRingBuffer::_releaseSlots(std::uint64_t head,
+                                          std::size_t count,
+                                          std::size_t bytes) {
+    _head.store(head);
+    _size.fetchAndSubtract(bytes);
+    if (_counters) {
+        _counters->count.decrement(count);
+        _counters->size.decrement(bytes);
+    }
+
+    // Only take the mutex when the producer has announced that it is blocked. Both sides use
+    // sequentially consistent atomics, so either the producer sees the space released above when
+    // it checks its wait condition, or this thread sees it waiting.
+    if (_producerWaiting.load()) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _notFullCv.notify_one();
+    }
+}
+
+void OplogBufferRingBuffer::_notifyConsumer() {
+    if (_consumerWaiting.load()) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _notEmptyCv.notify_one();
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
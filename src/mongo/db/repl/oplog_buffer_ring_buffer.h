@@ -0,0 +1,181 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/repl/oplog_buffer.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/with_alignment.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Oplog buffer backed by a bounded in memory ring buffer of BSONObj.
+ *
+ * The buffer supports exactly one producer thread, which calls push(), waitForSpace() and
+ * lastObjectPushed(), and one consumer thread, which calls peek(), peekBatch(), tryPop(),
+ * tryPopBatch() and waitForData(). The two threads hand entries over through the producer and
+ * consumer positions, and neither of them takes a lock to do so. The mutex is only taken by a
+ * thread that has to block, and by the other thread when it sees that a thread is blocked and has
+ * to wake it up.
+ *
+ * clear() and shutdown() may be called from any thread, for instance to unblock the producer
+ * during shutdown. They wait for the consumer to leave the buffer, and the consumer sees an empty
+ * buffer while they run.
+ */
+class OplogBufferRingBuffer final : public OplogBuffer {
+public:
+    /**
+     * Default number of entries the ring buffer can hold, independent of their size.
+     */
+    static constexpr std::size_t kDefaultCapacity = 1 << 18;
+
+    OplogBufferRingBuffer();
+    explicit OplogBufferRingBuffer(Counters* counters);
+
+    /**
+     * 'capacity' is rounded up to a power of two. 'maxSize' is the limit on the total size in
+     * bytes of the entries in the buffer that waitForSpace() waits for.
+     */
+    OplogBufferRingBuffer(Counters* counters, std::size_t capacity, std::size_t maxSize);
+
+    void startup(OperationContext* opCtx) override;
+    void shutdown(OperationContext* opCtx) override;
+    void push(OperationContext* opCtx,
+              Batch::const_iterator begin,
+              Batch::const_iterator end) override;
+    void waitForSpace(OperationContext* opCtx, std::size_t size) override;
+    bool isEmpty() const override;
+    std::size_t getMaxSize() const override;
+    std::size_t getSize() const override;
+    std::size_t getCount() const override;
+    void clear(OperationContext* opCtx) override;
+    bool tryPop(OperationContext* opCtx, Value* value) override;
+    bool waitForData(Seconds waitDuration) override;
+    bool peek(OperationContext* opCtx, Value* value) override;
+    std::size_t peekBatch(OperationContext* opCtx, std::size_t maxCount, Batch* batch) override;
+    std::size_t tryPopBatch(OperationContext* opCtx, std::size_t count) override;
+
+    /**
+     * May only be called by the producer.
+     */
+    boost::optional<Value> lastObjectPushed(OperationContext* opCtx) const override;
+
+    // In drain mode, waitForData() does not block. It is the responsibility of the caller to
+    // ensure that no items are added to the buffer while in drain mode; this is enforced by
+    // invariant().
+    void enterDrainMode() final;
+    void exitDrainMode() final;
+
+    /**
+     * Returns the number of entries the buffer can hold.
+     */
+    std::size_t getCapacity() const;
+
+private:
+    /**
+     * Announces that the consumer is about to read or move the consumer position. Returns false,
+     * and does not enter, if clear() is running. Every successful call must be paired with a call
+     * to _leaveConsumer().
+     */
+    bool _enterConsumer();
+    void _leaveConsumer();
+
+    /**
+     * Removes the 'count' entries at the consumer position 'head' and returns their total size.
+     * Must be called by the consumer, or by clear() while it excludes the consumer.
+     */
+    std::size_t _popSlots(std::uint64_t head, std::size_t count);
+
+    /**
+     * Waits until at least one slot is free and returns the number of free slots, or returns 0 if
+     * the buffer is shut down while waiting.
+     */
+    std::size_t _waitForFreeSlots();
+
+    /**
+     * Publishes the consumer position 'head' after entries totalling 'bytes' have been removed
+     * from the slots before it, and wakes up the producer if it is waiting for space.
+     */
+    void _releaseSlots(std::uint64_t head, std::size_t count, std::size_t bytes);
+
+    /**
+     * Wakes up the consumer if it is blocked in waitForData().
+     */
+    void _notifyConsumer();
+
+    Counters* const _counters;
+    const std::size_t _maxSize;
+
+    // Power of two number of slots, so a position maps to its slot with '_mask'.
+    const std::size_t _capacity;
+    const std::uint64_t _mask;
+    std::vector<Value> _slots;
+
+    // Position one past the last entry pushed. Only written by the producer.
+    CacheAligned<AtomicWord<std::uint64_t>> _tail{0};
+
+    // Position of the first entry not yet popped. Only written by the consumer, or by clear()
+    // while the consumer is excluded.
+    CacheAligned<AtomicWord<std::uint64_t>> _head{0};
+
+    // Total size in bytes of the entries between '_head' and '_tail'.
+    CacheAligned<AtomicWord<std::size_t>> _size{0};
+
+    // Set by a thread before it blocks on '_mutex', so the other thread only takes the mutex to
+    // signal when someone is actually waiting.
+    AtomicWord<bool> _producerWaiting{false};
+    AtomicWord<bool> _consumerWaiting{false};
+
+    // Exclude the consumer from clear(). Each side sets its own flag before it checks the other
+    // one, so with sequentially consistent atomics at most one of them proceeds.
+    AtomicWord<bool> _consumerActive{false};
+    AtomicWord<bool> _clearing{false};
+
+    AtomicWord<bool> _drainMode{false};
+    AtomicWord<bool> _inShutdown{false};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("OplogBufferRingBuffer::_mutex");
+    stdx::condition_variable _notEmptyCv;
+    stdx::condition_variable _notFullCv;
+
+    // Serializes concurrent calls to clear(). Never taken by the producer or the consumer.
+    Mutex _clearMutex = MONGO_MAKE_LATCH("OplogBufferRingBuffer::_clearMutex");
+
+    // The last entry pushed. Only accessed by the producer.
+    boost::optional<Value> _lastPushed;
+};
+
+}  // namespace repl
+}  // namespace mongo
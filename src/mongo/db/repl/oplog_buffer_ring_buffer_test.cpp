@@ -0,0 +1,241 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_buffer_ring_buffer.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+using namespace mongo::repl;
+
+OperationContext* const kOpCtx = nullptr;  // Not dereferenced.
+
+BSONObj makeOplogEntry(int t) {
+    return BSON("ts" << Timestamp(t, t) << "ns"
+                     << "a.a"
+                     << "v" << 2 << "op"
+                     << "i"
+                     << "o" << BSON("_id" << t));
+}
+
+OplogBuffer::Batch makeOplogEntries(int first, int count) {
+    OplogBuffer::Batch values;
+    for (int t = first; t < first + count; ++t) {
+        values.push_back(makeOplogEntry(t));
+    }
+    return values;
+}
+
+TEST(OplogBufferRingBufferTest, CapacityIsRoundedUpToAPowerOfTwo) {
+    OplogBufferRingBuffer buffer(nullptr, 5, 1024);
+    ASSERT_EQUALS(8U, buffer.getCapacity());
+    ASSERT_EQUALS(1024U, buffer.getMaxSize());
+}
+
+TEST(OplogBufferRingBufferTest, PushPeekAndPopKeepEntriesInOrderAndTrackTheirSize) {
+    OplogBuffer::Counters counters;
+    OplogBufferRingBuffer buffer(&counters, 4, 1024 * 1024);
+    buffer.startup(kOpCtx);
+    ASSERT_EQUALS(1024 * 1024, counters.maxSize.get());
+
+    auto values = makeOplogEntries(1, 3);
+    buffer.push(kOpCtx, values.cbegin(), values.cend());
+    const auto expectedSize = std::size_t(values[0].objsize() * 3);
+    ASSERT_FALSE(buffer.isEmpty());
+    ASSERT_EQUALS(3U, buffer.getCount());
+    ASSERT_EQUALS(expectedSize, buffer.getSize());
+    ASSERT_EQUALS(3, counters.count.get());
+    ASSERT_EQUALS(expectedSize, std::size_t(counters.size.get()));
+    auto lastObjectPushed = buffer.lastObjectPushed(kOpCtx);
+    ASSERT_TRUE(lastObjectPushed);
+    ASSERT_BSONOBJ_EQ(values.back(), *lastObjectPushed);
+
+    for (const auto& expected : values) {
+        BSONObj value;
+        ASSERT_TRUE(buffer.peek(kOpCtx, &value));
+        ASSERT_BSONOBJ_EQ(expected, value);
+        ASSERT_TRUE(buffer.tryPop(kOpCtx, &value));
+        ASSERT_BSONOBJ_EQ(expected, value);
+    }
+
+    BSONObj value;
+    ASSERT_FALSE(buffer.peek(kOpCtx, &value));
+    ASSERT_FALSE(buffer.tryPop(kOpCtx, &value));
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_EQUALS(0, counters.count.get());
+    ASSERT_EQUALS(0, counters.size.get());
+    buffer.shutdown(kOpCtx);
+}
+
+TEST(OplogBufferRingBufferTest, EntriesWrapAroundTheEndOfTheRing) {
+    OplogBufferRingBuffer buffer(nullptr, 4, 1024 * 1024);
+    for (int first = 1; first < 20; first += 3) {
+        auto values = makeOplogEntries(first, 3);
+        buffer.push(kOpCtx, values.cbegin(), values.cend());
+        for (const auto& expected : values) {
+            BSONObj value;
+            ASSERT_TRUE(buffer.tryPop(kOpCtx, &value));
+            ASSERT_BSONOBJ_EQ(expected, value);
+        }
+    }
+    ASSERT_TRUE(buffer.isEmpty());
+}
+
+TEST(OplogBufferRingBufferTest, PeekBatchLeavesEntriesAndTryPopBatchRemovesThem) {
+    OplogBuffer::Counters counters;
+    OplogBufferRingBuffer buffer(&counters, 16, 1024 * 1024);
+    auto values = makeOplogEntries(1, 10);
+    buffer.push(kOpCtx, values.cbegin(), values.cend());
+    const auto entrySize = std::size_t(values[0].objsize());
+
+    OplogBuffer::Batch batch;
+    ASSERT_EQUALS(4U, buffer.peekBatch(kOpCtx, 4, &batch));
+    ASSERT_EQUALS(10U, buffer.getCount());
+    ASSERT_EQUALS(4U, buffer.tryPopBatch(kOpCtx, 4));
+    ASSERT_EQUALS(6U, buffer.getCount());
+    ASSERT_EQUALS(6 * entrySize, buffer.getSize());
+    ASSERT_EQUALS(6, counters.count.get());
+    ASSERT_EQUALS(6 * entrySize, std::size_t(counters.size.get()));
+
+    // Peeking past the end of the buffer returns what there is.
+    ASSERT_EQUALS(6U, buffer.peekBatch(kOpCtx, 100, &batch));
+    ASSERT_EQUALS(6U, buffer.tryPopBatch(kOpCtx, 100));
+    ASSERT_EQUALS(0U, buffer.peekBatch(kOpCtx, 100, &batch));
+    ASSERT_EQUALS(0U, buffer.tryPopBatch(kOpCtx, 100));
+
+    ASSERT_EQUALS(values.size(), batch.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(values[i], batch[i]);
+    }
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_EQUALS(0, counters.count.get());
+}
+
+TEST(OplogBufferRingBufferTest, ClearRemovesAllEntries) {
+    OplogBuffer::Counters counters;
+    OplogBufferRingBuffer buffer(&counters, 8, 1024 * 1024);
+    auto values = makeOplogEntries(1, 5);
+    buffer.push(kOpCtx, values.cbegin(), values.cend());
+    buffer.clear(kOpCtx);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_FALSE(buffer.lastObjectPushed(kOpCtx));
+    ASSERT_EQUALS(0U, buffer.getCount());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_EQUALS(0, counters.count.get());
+    ASSERT_EQUALS(0, counters.size.get());
+}
+
+TEST(OplogBufferRingBufferTest, WaitForDataReturnsImmediatelyInDrainMode) {
+    OplogBufferRingBuffer buffer;
+    ASSERT_FALSE(buffer.waitForData(Seconds(0)));
+    buffer.enterDrainMode();
+    ASSERT_FALSE(buffer.waitForData(Seconds(60)));
+    buffer.exitDrainMode();
+}
+
+TEST(OplogBufferRingBufferTest, ProducerAndConsumerThreadsHandOverEveryEntryInOrder) {
+    // A ring much smaller than the number of entries makes both threads wait on each other.
+    OplogBufferRingBuffer buffer(nullptr, 8, 1024 * 1024);
+    const int numEntries = 10000;
+    const int entriesPerPush = 13;
+
+    stdx::thread producer([&] {
+        for (int first = 0; first < numEntries; first += entriesPerPush) {
+            auto values = makeOplogEntries(first, std::min(entriesPerPush, numEntries - first));
+            buffer.waitForSpace(kOpCtx, values[0].objsize() * values.size());
+            buffer.push(kOpCtx, values.cbegin(), values.cend());
+        }
+    });
+
+    OplogBuffer::Batch batch;
+    while (batch.size() < std::size_t(numEntries)) {
+        const auto peeked = buffer.peekBatch(kOpCtx, 5, &batch);
+        if (!peeked) {
+            buffer.waitForData(Seconds(1));
+            continue;
+        }
+        ASSERT_EQUALS(peeked, buffer.tryPopBatch(kOpCtx, peeked));
+    }
+    producer.join();
+
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    for (int t = 0; t < numEntries; ++t) {
+        ASSERT_BSONOBJ_EQ(makeOplogEntry(t), batch[t]);
+    }
+}
+
+TEST(OplogBufferRingBufferTest, ClearWhileTheConsumerPopsLeavesTheBufferConsistent) {
+    OplogBuffer::Counters counters;
+    OplogBufferRingBuffer buffer(&counters, 64, 1024 * 1024);
+    AtomicWord<bool> done{false};
+
+    stdx::thread consumer([&] {
+        OplogBuffer::Batch batch;
+        while (!done.load()) {
+            batch.clear();
+            buffer.tryPopBatch(kOpCtx, buffer.peekBatch(kOpCtx, 7, &batch));
+        }
+    });
+
+    for (int round = 0; round < 1000; ++round) {
+        auto values = makeOplogEntries(round, 20);
+        buffer.push(kOpCtx, values.cbegin(), values.cend());
+        buffer.clear(kOpCtx);
+        ASSERT_TRUE(buffer.isEmpty());
+    }
+    done.store(true);
+    consumer.join();
+
+    ASSERT_EQUALS(0U, buffer.getCount());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_EQUALS(0, counters.count.get());
+    ASSERT_EQUALS(0, counters.size.get());
+}
+
+TEST(OplogBufferRingBufferTest, ShutdownReleasesAProducerWaitingForSpace) {
+    auto values = makeOplogEntries(1, 1);
+    const auto entrySize = std::size_t(values[0].objsize());
+    OplogBufferRingBuffer buffer(nullptr, 8, entrySize);
+    buffer.push(kOpCtx, values.cbegin(), values.cend());
+
+    stdx::thread producer([&] { buffer.waitForSpace(kOpCtx, entrySize); });
+    buffer.shutdown(kOpCtx);
+    producer.join();
+    ASSERT_TRUE(buffer.isEmpty());
+}
+
+}  // namespace
@@ -0,0 +1,229 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_prefetcher.h"
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/locker.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/storage/execution_context.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+// Do not let a prefetch task wait behind a collection or database lock for long; the entries
+// will most likely have been applied by the time it gets the lock.
+constexpr Milliseconds kLockTimeout{100};
+
+/**
+ * Seeks to the keys 'doc' generates in every ready index of 'coll' other than the _id index.
+ */
+void prefetchIndexKeys(OperationContext* opCtx,
+                       const Collection* coll,
+                       const BSONObj& doc,
+                       IndexAccessMethod::GetKeysContext context) {
+    auto it = coll->getIndexCatalog()->getIndexIterator(opCtx, false /* includeUnfinished */);
+    while (it->more()) {
+        const IndexCatalogEntry* entry = it->next();
+        if (entry->descriptor()->isIdIndex()) {
+            continue;
+        }
+
+        if (auto filter = entry->getFilterExpression(); filter && !filter->matchesBSON(doc)) {
+            continue;
+        }
+
+        auto iam = entry->accessMethod();
+        auto& executionCtx = StorageExecutionContext::get(opCtx);
+        auto keys = executionCtx.keys();
+        auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
+        auto multikeyPaths = executionCtx.multikeyPaths();
+        iam->getKeys(executionCtx.pooledBufferBuilder(),
+                     doc,
+                     IndexAccessMethod::GetKeysMode::kRelaxConstraintsUnfiltered,
+                     context,
+                     keys.get(),
+                     multikeyMetadataKeys.get(),
+                     multikeyPaths.get(),
+                     boost::none,
+                     IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        auto cursor = iam->getSortedDataInterface()->newCursor(opCtx);
+        for (const auto& key : *keys) {
+            cursor->seekForKeyString(key);
+        }
+    }
+}
+
+}  // namespace
+
+OplogPrefetcher::OplogPrefetcher(int numThreads) : _numThreads(static_cast<size_t>(numThreads)) {
+    invariant(numThreads > 0);
+
+    ThreadPool::Options options;
+    options.threadNamePrefix = "ReplPrefetcher-";
+    options.poolName = "ReplPrefetcherThreadPool";
+    options.maxThreads = options.minThreads = _numThreads;
+    options.onCreateThread = [](const std::string&) {
+        Client::initThread(getThreadName());
+        AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+    };
+    _pool = std::make_unique<ThreadPool>(options);
+    _pool->startup();
+}
+
+OplogPrefetcher::~OplogPrefetcher() {
+    // Abandon whatever is left of the current batch.
+    _batchNumber.fetchAndAdd(1);
+    _pool->shutdown();
+    _pool->join();
+}
+
+void OplogPrefetcher::prefetch(const std::vector<OplogEntry>& ops) {
+    std::vector<OplogEntry> crudOps;
+    for (const auto& op : ops) {
+        if (op.isCrudOpType() && op.getUuid()) {
+            crudOps.push_back(op);
+        }
+    }
+
+    const auto batchNumber = _batchNumber.addAndFetch(1);
+    if (crudOps.empty()) {
+        return;
+    }
+
+    // Give every thread a contiguous slice of the batch, so that the documents of the first
+    // entries, which the writer threads reach first, are prefetched first.
+    const size_t numTasks = std::min(crudOps.size(), _numThreads);
+    const size_t perTask = (crudOps.size() + numTasks - 1) / numTasks;
+    auto sharedOps = std::make_shared<std::vector<OplogEntry>>(std::move(crudOps));
+    for (size_t begin = 0; begin < sharedOps->size(); begin += perTask) {
+        const size_t end = std::min(begin + perTask, sharedOps->size());
+        _pool->schedule([this, sharedOps, begin, end, batchNumber](Status status) {
+            if (!status.isOK()) {
+                return;
+            }
+
+            auto opCtx = cc().makeOperationContext();
+
+            // Prefetching must not wait for the batch applier, which holds the
+            // ParallelBatchWriterMode lock while it applies the very batch being prefetched.
+            ShouldNotConflictWithSecondaryBatchApplicationBlock noConflict(opCtx->lockState());
+
+            for (size_t i = begin; i < end; ++i) {
+                if (_batchNumber.load() != batchNumber) {
+                    return;
+                }
+                try {
+                    prefetchOp(opCtx.get(), (*sharedOps)[i]);
+                } catch (const DBException& ex) {
+                    LOGV2_DEBUG(5171000,
+                                2,
+                                "Failed to prefetch oplog entry",
+                                "oplogEntry"_attr = redact((*sharedOps)[i].toBSON()),
+                                "error"_attr = redact(ex));
+                }
+                opCtx->recoveryUnit()->abandonSnapshot();
+            }
+        });
+    }
+}
+
+void OplogPrefetcher::waitForIdle_forTest() {
+    _pool->waitForIdle();
+}
+
+void OplogPrefetcher::prefetchOp(OperationContext* opCtx, const OplogEntry& op) {
+    const auto uuid = op.getUuid();
+    if (!uuid) {
+        return;
+    }
+
+    AutoGetCollection autoColl(opCtx,
+                               NamespaceStringOrUUID(op.getNss().db().toString(), *uuid),
+                               MODE_IS,
+                               AutoGetCollection::kViewsForbidden,
+                               Date_t::now() + kLockTimeout);
+    auto coll = autoColl.getCollection();
+    if (!coll) {
+        return;
+    }
+
+    switch (op.getOpType()) {
+        case OpTypeEnum::kInsert: {
+            // The document does not exist yet, but the index pages its keys land on do.
+            prefetchIndexKeys(
+                opCtx, coll, op.getObject(), IndexAccessMethod::GetKeysContext::kAddingKeys);
+            return;
+        }
+        case OpTypeEnum::kUpdate:
+        case OpTypeEnum::kDelete: {
+            if (!coll->getIndexCatalog()->findIdIndex(opCtx)) {
+                return;
+            }
+
+            const auto idSource =
+                op.getOpType() == OpTypeEnum::kUpdate ? op.getObject2() : op.getObject();
+            if (!idSource) {
+                return;
+            }
+            auto idElem = (*idSource)["_id"];
+            if (idElem.eoo()) {
+                return;
+            }
+
+            const auto rid = Helpers::findById(opCtx, coll, idElem.wrap());
+            if (rid.isNull()) {
+                return;
+            }
+            // Both the old keys of an update and the keys of a deleted document are removed
+            // from the indexes, so seek to the keys of the current version of the document.
+            const auto doc = coll->docFor(opCtx, rid).value();
+            prefetchIndexKeys(opCtx, coll, doc, IndexAccessMethod::GetKeysContext::kRemovingKeys);
+            return;
+        }
+        default:
+            return;
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
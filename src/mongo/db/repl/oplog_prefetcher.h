@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/repl/oplog_entry.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+
+class OperationContext;
+
+namespace repl {
+
+/**
+ * Warms the storage engine cache for a batch of oplog entries before the batch is applied.
+ *
+ * For every insert, update and delete in the batch it performs the reads the writer threads
+ * would otherwise stall on: the _id index lookup and the fetch of the target document for
+ * updates and deletes, and a seek to the keys of the document in every other index of the
+ * collection. The reads are done on a small pool of threads, do not conflict with batch
+ * application and are purely advisory: any error is ignored.
+ *
+ * Only the most recent batch is prefetched. As soon as a new batch is handed over, the work left
+ * for the previous one is abandoned, since that batch is being applied by then.
+ */
+class OplogPrefetcher {
+    OplogPrefetcher(const OplogPrefetcher&) = delete;
+    OplogPrefetcher& operator=(const OplogPrefetcher&) = delete;
+
+public:
+    explicit OplogPrefetcher(int numThreads);
+
+    ~OplogPrefetcher();
+
+    /**
+     * Schedules the prefetch of 'ops' and returns immediately. The entries are not referenced
+     * after this returns.
+     */
+    void prefetch(const std::vector<OplogEntry>& ops);
+
+    /**
+     * Blocks until all scheduled prefetch work is done. Used for testing.
+     */
+    void waitForIdle_forTest();
+
+    /**
+     * Performs the reads for the CRUD oplog entry 'op'. Exposed for testing.
+     */
+    static void prefetchOp(OperationContext* opCtx, const OplogEntry& op);
+
+private:
+    const size_t _numThreads;
+
+    std::unique_ptr<ThreadPool> _pool;
+
+    // Incremented for every batch; prefetch tasks of older batches stop when it changes.
+    AtomicWord<unsigned long long> _batchNumber{0};
+};
+
+}  // namespace repl
+}  // namespace mongo
@@ -71,6 +71,7 @@
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier_impl.h"
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_buffer_ring_buffer.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -130,6 +131,18 @@ const char tsFieldName[] = "ts";
 
 MONGO_FAIL_POINT_DEFINE(dropPendingCollectionReaperHang);
 
+const char kBlockingQueueOplogBufferName[] = "inMemoryBlockingQueue";
+const char kRingBufferOplogBufferName[] = "inMemoryRingBuffer";
+
+MONGO_INITIALIZER(steadyStateOplogBuffer)(InitializerContext*) {
+    if ((steadyStateOplogBuffer != kBlockingQueueOplogBufferName) &&
+        (steadyStateOplogBuffer != kRingBufferOplogBufferName)) {
+        return Status(ErrorCodes::BadValue,
+                      "unsupported steady state oplog buffer option: " + steadyStateOplogBuffer);
+    }
+    return Status::OK();
+}
+
 // The count of items in the buffer
 OplogBuffer::Counters bufferGauge;
 ServerStatusMetricField<Counter64> displayBufferCount("repl.buffer.count", &bufferGauge.count);
@@ -216,10 +229,14 @@ void ReplicationCoordinatorExternalStateImpl::startSteadyStateReplication(
         return;
 
     invariant(replCoord);
-    _oplogBuffer = std::make_unique<OplogBufferBlockingQueue>(&bufferGauge);
+    if (steadyStateOplogBuffer == kRingBufferOplogBufferName) {
+        _oplogBuffer = std::make_unique<OplogBufferRingBuffer>(&bufferGauge);
+    } else {
+        _oplogBuffer = std::make_unique<OplogBufferBlockingQueue>(&bufferGauge);
+    }
 
-    // No need to log OplogBuffer::startup because the blocking queue implementation
-    // does not start any threads or access the storage layer.
+    // No need to log OplogBuffer::startup because the in-memory implementations
+    // do not start any threads or access the storage layer.
     _oplogBuffer->startup(opCtx);
 
     invariant(!_oplogApplier);
@@ -0,0 +1,140 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/update_delete_group.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/repl/oplog_applier_impl.h"
+#include "mongo/db/repl/oplog_entry.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace repl {
+
+namespace {
+
+// Bounds the size of the write unit of work, counting the 'o' and 'o2' fields of each op.
+const auto kUpdateDeleteGroupMaxGroupSize = write_ops::insertVectorMaxBytes;
+
+// Limit number of ops in a single group.
+constexpr auto kUpdateDeleteGroupMaxOpCount = 64;
+
+bool isUpdateOrDelete(const OplogEntry& entry) {
+    return entry.getOpType() == OpTypeEnum::kUpdate || entry.getOpType() == OpTypeEnum::kDelete;
+}
+
+size_t opSize(const OplogEntry& entry) {
+    size_t size = entry.getObject().objsize();
+    if (auto o2 = entry.getObject2()) {
+        size += o2->objsize();
+    }
+    return size;
+}
+
+}  // namespace
+
+UpdateDeleteGroup::UpdateDeleteGroup(std::vector<const OplogEntry*>* ops,
+                                     OperationContext* opCtx,
+                                     UpdateDeleteGroup::Mode mode)
+    : _doNotGroupBeforePoint(ops->cbegin()), _end(ops->cend()), _opCtx(opCtx), _mode(mode) {}
+
+StatusWith<UpdateDeleteGroup::ConstIterator> UpdateDeleteGroup::groupAndApplyUpdatesAndDeletes(
+    ConstIterator it) {
+    const auto& entry = **it;
+
+    // Only steady state replication groups updates and deletes. In initial sync and recovery, ops
+    // on documents that are missing are common and would make most groups fail.
+    if (_mode != Mode::kSecondary) {
+        return Status(ErrorCodes::IllegalOperation,
+                      "Only group update and delete operations in steady state replication.");
+    }
+    if (!isUpdateOrDelete(entry)) {
+        return Status(ErrorCodes::TypeMismatch, "Can only group update and delete operations.");
+    }
+    if (it <= _doNotGroupBeforePoint) {
+        return Status(ErrorCodes::InvalidPath,
+                      "Cannot group an operation that we previously attempted to group.");
+    }
+
+    size_t groupSize = opSize(entry);
+    auto opCount = std::vector<const OplogEntry*>::size_type(1);
+
+    // Find the first op that cannot join the group: a different op type, another collection, or
+    // one that would make the group too large.
+    auto endOfGroupableOpsIterator =
+        std::find_if(it + 1, _end, [&](const OplogEntry* nextEntry) -> bool {
+            groupSize += opSize(*nextEntry);
+            opCount += 1;
+
+            return !isUpdateOrDelete(*nextEntry) || nextEntry->getNss() != entry.getNss() ||
+                nextEntry->getUuid() != entry.getUuid() ||
+                groupSize > kUpdateDeleteGroupMaxGroupSize ||
+                opCount > kUpdateDeleteGroupMaxOpCount;
+        });
+
+    if (std::distance(it, endOfGroupableOpsIterator) == 1) {
+        return Status(ErrorCodes::NoSuchKey,
+                      "Not able to create a group with more than a single update or delete");
+    }
+
+    try {
+        uassertStatusOK(
+            applyGroupedUpdatesAndDeletes(_opCtx, it, endOfGroupableOpsIterator, _mode));
+        return endOfGroupableOpsIterator - 1;
+    } catch (...) {
+        // Nothing of the group was applied. Its ops are applied one at a time instead, which
+        // reports the errors that are not acceptable in the current mode.
+        auto status = exceptionToStatus();
+        LOGV2_DEBUG(5165001,
+                    1,
+                    "Error applying updates and deletes as a group. Applying them one at a time",
+                    "firstOp"_attr = redact(entry.toBSON()),
+                    "numOps"_attr = std::distance(it, endOfGroupableOpsIterator),
+                    "error"_attr = redact(status));
+
+        // Avoid quadratic run time by not grouping again until we are beyond this group of ops.
+        _doNotGroupBeforePoint = endOfGroupableOpsIterator - 1;
+
+        return status;
+    }
+
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -35,10 +35,12 @@
 
 #include <algorithm>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj_comparator_interface.h"
+#include "mongo/client/read_preference.h"
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/bits.h"
@@ -47,6 +49,7 @@
 #include "mongo/s/catalog/type_collection.h"
 #include "mongo/s/catalog/type_tags.h"
 #include "mongo/s/catalog_cache.h"
+#include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
 #include "mongo/util/str.h"
 
@@ -60,6 +63,61 @@ using std::vector;
 
 namespace {
 
+struct CollectionShardStats {
+    long long dataSizeBytes;
+    long long writeOps;
+};
+
+/**
+ * Executes the $collStats aggregation stage against the specified shard and obtains the size of the
+ * collection's documents on it and the number of writes the shard has applied to the collection
+ * since it started.
+ *
+ * Returns the statistics or an error. Known error codes are:
+ *  ShardNotFound if shard by that id is not available on the registry
+ *  NoSuchKey if the statistics could not be retrieved
+ */
+StatusWith<CollectionShardStats> retrieveCollectionShardStats(OperationContext* opCtx,
+                                                              const ShardId& shardId,
+                                                              const NamespaceString& nss) {
+    auto shardStatus = Grid::get(opCtx)->shardRegistry()->getShard(opCtx, shardId);
+    if (!shardStatus.isOK()) {
+        return shardStatus.getStatus();
+    }
+
+    const BSONObj collStatsStage =
+        BSON("$collStats" << BSON("storageStats" << BSONObj() << "latencyStats" << BSONObj()));
+
+    auto commandResponse = shardStatus.getValue()->runCommandWithFixedRetryAttempts(
+        opCtx,
+        ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+        nss.db().toString(),
+        BSON("aggregate" << nss.coll() << "pipeline" << BSON_ARRAY(collStatsStage) << "cursor"
+                         << BSONObj()),
+        Shard::RetryPolicy::kIdempotent);
+    if (!commandResponse.isOK()) {
+        return commandResponse.getStatus();
+    }
+    if (!commandResponse.getValue().commandStatus.isOK()) {
+        return commandResponse.getValue().commandStatus;
+    }
+
+    const BSONObj& response = commandResponse.getValue().response;
+    const BSONElement firstBatch = response["cursor"]["firstBatch"];
+    if (firstBatch.type() != Array || firstBatch.Obj().isEmpty()) {
+        return {ErrorCodes::NoSuchKey, "collection statistics not found in $collStats"};
+    }
+
+    const BSONObj collStats = firstBatch.Obj().firstElement().Obj();
+    const BSONElement sizeElem = collStats["storageStats"]["size"];
+    const BSONElement writeOpsElem = collStats["latencyStats"]["writes"]["ops"];
+    if (!sizeElem.isNumber() || !writeOpsElem.isNumber()) {
+        return {ErrorCodes::NoSuchKey, "size or writes.ops field not found in $collStats"};
+    }
+
+    return CollectionShardStats{sizeElem.safeNumberLong(), writeOpsElem.safeNumberLong()};
+}
+
 /**
  * Does a linear pass over the information cached in the specified chunk manager and extracts chunk
  * distribution and chunk placement information which is needed by the balancer policy.
@@ -369,6 +427,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
 
     auto& collections = swCollections.getValue();
 
+    _pruneWriteOpsSamples(collections, shardStats);
+
     if (collections.empty()) {
         return MigrateInfoVector{};
     }
@@ -376,6 +436,11 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
     MigrateInfoVector candidateChunks;
     std::set<ShardId> usedShards;
 
+    // Migrations due to load imbalance share the bytes budget of the round across collections
+    long long migrationBytesBudget = balancerMaxMigrationBytesPerRound.load();
+    long long* const migrationBytesBudgetPtr =
+        migrationBytesBudget ? &migrationBytesBudget : nullptr;
+
     std::shuffle(collections.begin(), collections.end(), _random);
 
     for (const auto& coll : collections) {
@@ -394,8 +459,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
-        auto candidatesStatus =
-            _getMigrateCandidatesForCollection(opCtx, nss, shardStats, &usedShards);
+        auto candidatesStatus = _getMigrateCandidatesForCollection(
+            opCtx, nss, shardStats, &usedShards, migrationBytesBudgetPtr, true);
         if (candidatesStatus == ErrorCodes::NamespaceNotFound) {
             // Namespace got dropped before we managed to get to it, so just skip it
             continue;
@@ -440,7 +505,14 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
 
     std::set<ShardId> usedShards;
 
-    auto candidatesStatus = _getMigrateCandidatesForCollection(opCtx, nss, shardStats, &usedShards);
+    long long migrationBytesBudget = balancerMaxMigrationBytesPerRound.load();
+    long long* const migrationBytesBudgetPtr =
+        migrationBytesBudget ? &migrationBytesBudget : nullptr;
+
+    // Only the balancer round advances the write samples, so that reporting the balancing status
+    // of a collection does not shorten the interval over which its write rate is measured.
+    auto candidatesStatus = _getMigrateCandidatesForCollection(
+        opCtx, nss, shardStats, &usedShards, migrationBytesBudgetPtr, false);
     if (!candidatesStatus.isOK()) {
         return candidatesStatus.getStatus();
     }
@@ -558,7 +630,9 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
     OperationContext* opCtx,
     const NamespaceString& nss,
     const ShardStatisticsVector& shardStats,
-    std::set<ShardId>* usedShards) {
+    std::set<ShardId>* usedShards,
+    long long* migrationBytesBudget,
+    bool updateWriteOpsSamples) {
     auto routingInfoStatus =
         Grid::get(opCtx)->catalogCache()->getShardedCollectionRoutingInfoWithRefresh(opCtx, nss);
     if (!routingInfoStatus.isOK()) {
@@ -569,12 +643,16 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
 
     const auto& shardKeyPattern = cm->getShardKeyPattern().getKeyPattern();
 
-    const auto collInfoStatus = createCollectionDistributionStatus(opCtx, shardStats, cm);
+    auto collInfoStatus = createCollectionDistributionStatus(opCtx, shardStats, cm);
     if (!collInfoStatus.isOK()) {
         return collInfoStatus.getStatus();
     }
 
-    const DistributionStatus& distribution = collInfoStatus.getValue();
+    DistributionStatus& distribution = collInfoStatus.getValue();
+
+    if (balancerLoadAwareBalancing.load()) {
+        _recordShardLoads(opCtx, shardStats, &distribution, updateWriteOpsSamples);
+    }
 
     for (const auto& tagRangeEntry : distribution.tagRanges()) {
         const auto& tagRange = tagRangeEntry.second;
@@ -615,7 +693,93 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
         shardStats,
         distribution,
         usedShards,
+        migrationBytesBudget,
         Grid::get(opCtx)->getBalancerConfiguration()->attemptToBalanceJumboChunks());
 }
 
+void BalancerChunkSelectionPolicyImpl::_recordShardLoads(OperationContext* opCtx,
+                                                         const ShardStatisticsVector& shardStats,
+                                                         DistributionStatus* distribution,
+                                                         bool updateWriteOpsSamples) {
+    const NamespaceString& nss = distribution->nss();
+
+    std::vector<std::pair<ShardId, CollectionShardStats>> collStatsPerShard;
+
+    for (const auto& stat : shardStats) {
+        // Shards, which own no chunks of the collection, do not take any of its load
+        if (!distribution->numberOfChunksInShard(stat.shardId))
+            continue;
+
+        auto collStatsStatus = retrieveCollectionShardStats(opCtx, stat.shardId, nss);
+        if (!collStatsStatus.isOK()) {
+            LOGV2_WARNING(5179003,
+                          "Unable to obtain the load of collection {namespace} on shard "
+                          "{shardId}, balancing it by chunk count instead: {error}",
+                          "Unable to obtain the load of collection on shard, balancing it by "
+                          "chunk count instead",
+                          "namespace"_attr = nss,
+                          "shardId"_attr = stat.shardId,
+                          "error"_attr = collStatsStatus.getStatus());
+            return;
+        }
+
+        collStatsPerShard.emplace_back(stat.shardId, collStatsStatus.getValue());
+    }
+
+    const Date_t now = Date_t::now();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    for (const auto& [shardId, collStats] : collStatsPerShard) {
+        DistributionStatus::ShardLoad load;
+        load.dataSizeBytes = collStats.dataSizeBytes;
+
+        // The write counters of a shard restart from zero if it restarts, in which case the rate
+        // cannot be measured until the next round
+        const auto key = std::make_pair(nss, shardId);
+        auto it = _writeOpsSamples.find(key);
+        if (it != _writeOpsSamples.end()) {
+            const auto& sample = it->second;
+            if (now > sample.time && collStats.writeOps >= sample.writeOps) {
+                const double elapsedSecs = durationCount<Milliseconds>(now - sample.time) / 1000.0;
+                load.writeOpsPerSec = (collStats.writeOps - sample.writeOps) / elapsedSecs;
+            }
+        }
+
+        if (updateWriteOpsSamples) {
+            auto& sample = _writeOpsSamples[key];
+            sample.writeOps = collStats.writeOps;
+            sample.time = now;
+        }
+
+        distribution->setShardLoad(shardId, load);
+    }
+}
+
+void BalancerChunkSelectionPolicyImpl::_pruneWriteOpsSamples(
+    const std::vector<CollectionType>& collections, const ShardStatisticsVector& shardStats) {
+    std::set<NamespaceString> namespaces;
+    for (const auto& coll : collections) {
+        if (!coll.getDropped()) {
+            namespaces.insert(coll.getNs());
+        }
+    }
+
+    std::set<ShardId> shardIds;
+    for (const auto& stat : shardStats) {
+        shardIds.insert(stat.shardId);
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    for (auto it = _writeOpsSamples.begin(); it != _writeOpsSamples.end();) {
+        const auto& [nss, shardId] = it->first;
+        if (!namespaces.count(nss) || !shardIds.count(shardId)) {
+            it = _writeOpsSamples.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 }  // namespace mongo
@@ -29,12 +29,20 @@
 
 #pragma once
 
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
 #include "mongo/db/s/balancer/balancer_chunk_selection_policy.h"
 #include "mongo/db/s/balancer/balancer_random.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
 class ClusterStatistics;
+class CollectionType;
 
 class BalancerChunkSelectionPolicyImpl final : public BalancerChunkSelectionPolicy {
 public:
@@ -70,13 +78,41 @@ private:
 
     /**
      * Synchronous method, which iterates the collection's chunks and uses the cluster statistics to
-     * figure out where to place them.
+     * figure out where to place them. The write samples of the collection are only advanced if
+     * 'updateWriteOpsSamples' is true, which is reserved for the balancer round.
      */
     StatusWith<MigrateInfoVector> _getMigrateCandidatesForCollection(
         OperationContext* opCtx,
         const NamespaceString& nss,
         const ShardStatisticsVector& shardStats,
-        std::set<ShardId>* usedShards);
+        std::set<ShardId>* usedShards,
+        long long* migrationBytesBudget,
+        bool updateWriteOpsSamples);
+
+    /**
+     * Obtains the size and the number of writes of the distribution's collection on every shard,
+     * which owns chunks of it, and records them as the shards' loads so that the collection gets
+     * balanced by load. The write rate is measured against the last sample taken for the same
+     * collection, and a new sample is only taken if 'updateWriteOpsSamples' is true. If the
+     * statistics of any shard cannot be obtained, leaves the distribution as is.
+     */
+    void _recordShardLoads(OperationContext* opCtx,
+                           const ShardStatisticsVector& shardStats,
+                           DistributionStatus* distribution,
+                           bool updateWriteOpsSamples);
+
+    /**
+     * Forgets the write samples of collections which are no longer in 'collections', because they
+     * have been dropped, and of shards which are no longer in 'shardStats'.
+     */
+    void _pruneWriteOpsSamples(const std::vector<CollectionType>& collections,
+                               const ShardStatisticsVector& shardStats);
+
+    // The number of writes a shard reported for a collection and when it did so
+    struct WriteOpsSample {
+        long long writeOps{0};
+        Date_t time;
+    };
 
     // Source for obtaining cluster statistics. Not owned and must not be destroyed before the
     // policy object is destroyed.
@@ -84,6 +120,12 @@ private:
 
     // Source of randomness when metadata needs to be randomized.
     BalancerRandomSource& _random;
+
+    // Protects the state below
+    Mutex _mutex = MONGO_MAKE_LATCH("BalancerChunkSelectionPolicyImpl::_mutex");
+
+    // Last number of writes each shard reported for each collection balanced by load
+    std::map<std::pair<NamespaceString, ShardId>, WriteOpsSample> _writeOpsSamples;
 };
 
 }  // namespace mongo
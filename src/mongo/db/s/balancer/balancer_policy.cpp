@@ -58,6 +58,10 @@ namespace {
 // optimal average across all shards for a zone for a rebalancing migration to be initiated.
 const size_t kDefaultImbalanceThreshold = 1;
 
+// This value indicates the minimum fraction by which a shard's share of a zone's load must exceed
+// the even share across all shards for the zone before a load rebalancing migration is initiated.
+const double kLoadImbalanceThreshold = 0.1;
+
 }  // namespace
 
 DistributionStatus::DistributionStatus(NamespaceString nss, ShardToChunksMap shardToChunksMap)
@@ -177,6 +181,26 @@ string DistributionStatus::getTagForChunk(const ChunkType& chunk) const {
     return "";
 }
 
+void DistributionStatus::setShardLoad(const ShardId& shardId, ShardLoad load) {
+    _shardLoads[shardId] = load;
+}
+
+DistributionStatus::ShardLoad DistributionStatus::getShardLoad(const ShardId& shardId) const {
+    const auto it = _shardLoads.find(shardId);
+    if (it == _shardLoads.end())
+        return ShardLoad();
+
+    return it->second;
+}
+
+long long DistributionStatus::estimatedChunkSizeBytes(const ShardId& shardId) const {
+    const size_t numChunks = numberOfChunksInShard(shardId);
+    if (!numChunks)
+        return 0;
+
+    return getShardLoad(shardId).dataSizeBytes / static_cast<long long>(numChunks);
+}
+
 void DistributionStatus::report(BSONObjBuilder* builder) const {
     builder->append("ns", _nss.ns());
 
@@ -360,6 +384,7 @@ MigrateInfo chooseRandomMigration(const ShardStatisticsVector& shardStats,
 vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
                                             std::set<ShardId>* usedShards,
+                                            long long* migrationBytesBudget,
                                             bool forceJumbo) {
     vector<MigrateInfo> migrations;
 
@@ -524,6 +549,21 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
             continue;
         }
 
+        const auto forceJumboMode = forceJumbo ? MoveChunkRequest::ForceJumbo::kForceBalancer
+                                               : MoveChunkRequest::ForceJumbo::kDoNotForce;
+
+        if (distribution.hasShardLoads()) {
+            while (_singleZoneBalanceByLoad(shardStats,
+                                            distribution,
+                                            tag,
+                                            &migrations,
+                                            usedShards,
+                                            migrationBytesBudget,
+                                            forceJumboMode))
+                ;
+            continue;
+        }
+
         // Calculate the rounded optimal number of chunks per shard
         const size_t idealNumberOfChunksPerShardForTag =
             (size_t)std::roundf(totalNumberOfChunksWithTag / (float)totalNumberOfShardsWithTag);
@@ -534,8 +574,7 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
                                   idealNumberOfChunksPerShardForTag,
                                   &migrations,
                                   usedShards,
-                                  forceJumbo ? MoveChunkRequest::ForceJumbo::kForceBalancer
-                                             : MoveChunkRequest::ForceJumbo::kDoNotForce))
+                                  forceJumboMode))
             ;
     }
 
@@ -648,6 +687,148 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
     return false;
 }
 
+bool BalancerPolicy::_singleZoneBalanceByLoad(const ShardStatisticsVector& shardStats,
+                                              const DistributionStatus& distribution,
+                                              const string& tag,
+                                              vector<MigrateInfo>* migrations,
+                                              set<ShardId>* usedShards,
+                                              long long* migrationBytesBudget,
+                                              MoveChunkRequest::ForceJumbo forceJumbo) {
+    if (migrationBytesBudget && *migrationBytesBudget <= 0)
+        return false;
+
+    struct ZoneLoad {
+        const ClusterStatistics::ShardStatistics* stat;
+        size_t numChunksWithTag;
+        double dataSizeBytes;
+        double writeOpsPerSec;
+        double score;
+    };
+
+    // The collection's load on a shard is attributed to its chunks evenly, so only the share of
+    // the shard's chunks which fall into this zone counts towards the zone's load
+    vector<ZoneLoad> zoneLoads;
+    double totalDataSizeBytes = 0;
+    double totalWriteOpsPerSec = 0;
+
+    for (const auto& stat : shardStats) {
+        if (!tag.empty() && !stat.shardTags.count(tag))
+            continue;
+
+        const size_t numChunks = distribution.numberOfChunksInShard(stat.shardId);
+        const size_t numChunksWithTag =
+            distribution.numberOfChunksInShardWithTag(stat.shardId, tag);
+        const double zoneFraction = numChunks ? double(numChunksWithTag) / numChunks : 0;
+        const auto load = distribution.getShardLoad(stat.shardId);
+
+        zoneLoads.push_back({&stat,
+                             numChunksWithTag,
+                             load.dataSizeBytes * zoneFraction,
+                             load.writeOpsPerSec * zoneFraction,
+                             0});
+        totalDataSizeBytes += zoneLoads.back().dataSizeBytes;
+        totalWriteOpsPerSec += zoneLoads.back().writeOpsPerSec;
+    }
+
+    // Each shard is scored by its share of the zone's data and of the zone's writes, averaged over
+    // whichever of the two the zone has
+    const int numLoadDimensions = (totalDataSizeBytes > 0) + (totalWriteOpsPerSec > 0);
+    if (!numLoadDimensions)
+        return false;
+
+    for (auto& zoneLoad : zoneLoads) {
+        if (totalDataSizeBytes > 0)
+            zoneLoad.score += zoneLoad.dataSizeBytes / totalDataSizeBytes;
+        if (totalWriteOpsPerSec > 0)
+            zoneLoad.score += zoneLoad.writeOpsPerSec / totalWriteOpsPerSec;
+        zoneLoad.score /= numLoadDimensions;
+    }
+
+    const ZoneLoad* from = nullptr;
+    const ZoneLoad* to = nullptr;
+
+    for (const auto& zoneLoad : zoneLoads) {
+        if (usedShards->count(zoneLoad.stat->shardId))
+            continue;
+
+        if (zoneLoad.numChunksWithTag && (!from || zoneLoad.score > from->score))
+            from = &zoneLoad;
+
+        if (isShardSuitableReceiver(*zoneLoad.stat, tag).isOK() &&
+            (!to || zoneLoad.score < to->score))
+            to = &zoneLoad;
+    }
+
+    if (!from)
+        return false;
+
+    if (!to || to == from) {
+        if (migrations->empty()) {
+            LOGV2(5179000,
+                  "No available shards to take chunks for zone {zone}",
+                  "No available shards to take chunks for zone",
+                  "zone"_attr = tag);
+        }
+        return false;
+    }
+
+    const double idealScore = 1.0 / zoneLoads.size();
+    const double chunkScore = from->score / from->numChunksWithTag;
+
+    LOGV2_DEBUG(5179001,
+                1,
+                "collection: {namespace}, zone: {zone}, donor: {fromShardId} load score "
+                "{fromShardLoadScore}, receiver: {toShardId} load score {toShardLoadScore}, "
+                "ideal: {idealLoadScore}, chunk load score: {chunkLoadScore}",
+                "Balancing single zone by load",
+                "namespace"_attr = distribution.nss().ns(),
+                "zone"_attr = tag,
+                "fromShardId"_attr = from->stat->shardId,
+                "fromShardLoadScore"_attr = from->score,
+                "toShardId"_attr = to->stat->shardId,
+                "toShardLoadScore"_attr = to->score,
+                "idealLoadScore"_attr = idealScore,
+                "chunkLoadScore"_attr = chunkScore);
+
+    // Check whether the donor is loaded enough to be worth balancing
+    if (from->score <= idealScore * (1 + kLoadImbalanceThreshold))
+        return false;
+
+    // Do not move a chunk if that would make the recipient more loaded than the donor is left
+    if (from->score - to->score <= 2 * chunkScore)
+        return false;
+
+    const ShardId& fromShardId = from->stat->shardId;
+    const ShardId& toShardId = to->stat->shardId;
+
+    for (const auto& chunk : distribution.getChunks(fromShardId)) {
+        if (distribution.getTagForChunk(chunk) != tag)
+            continue;
+
+        if (chunk.getJumbo())
+            continue;
+
+        migrations->emplace_back(toShardId, chunk, forceJumbo, MigrateInfo::loadImbalance);
+        invariant(usedShards->insert(fromShardId).second);
+        invariant(usedShards->insert(toShardId).second);
+
+        if (migrationBytesBudget)
+            *migrationBytesBudget -= distribution.estimatedChunkSizeBytes(fromShardId);
+
+        return true;
+    }
+
+    LOGV2_WARNING(5179002,
+                  "Shard: {shardId}, collection: {namespace} has only jumbo chunks for zone "
+                  "\'{zone}\' and cannot be balanced by load",
+                  "Shard has only jumbo chunks for zone and cannot be balanced by load",
+                  "shardId"_attr = fromShardId,
+                  "namespace"_attr = distribution.nss().ns(),
+                  "zone"_attr = tag);
+
+    return false;
+}
+
 ZoneRange::ZoneRange(const BSONObj& a_min, const BSONObj& a_max, const std::string& _zone)
     : min(a_min.getOwned()), max(a_max.getOwned()), zone(_zone) {}
 
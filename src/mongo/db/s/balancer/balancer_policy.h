@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <map>
 #include <set>
 #include <vector>
 
@@ -54,7 +55,7 @@ struct ZoneRange {
 };
 
 struct MigrateInfo {
-    enum MigrationReason { drain, zoneViolation, chunksImbalance };
+    enum MigrationReason { drain, zoneViolation, chunksImbalance, loadImbalance };
 
     MigrateInfo(const ShardId& a_to,
                 const ChunkType& a_chunk,
@@ -90,6 +91,17 @@ class DistributionStatus {
     DistributionStatus& operator=(const DistributionStatus&) = delete;
 
 public:
+    /**
+     * Size and recent write load of the collection on a single shard.
+     */
+    struct ShardLoad {
+        // Size of the collection's documents on the shard
+        long long dataSizeBytes{0};
+
+        // Rate of writes against the collection on the shard since the previous measurement
+        double writeOpsPerSec{0};
+    };
+
     DistributionStatus(NamespaceString nss, ShardToChunksMap shardToChunksMap);
     DistributionStatus(DistributionStatus&&) = default;
 
@@ -152,6 +164,31 @@ public:
      */
     std::string getTagForChunk(const ChunkType& chunk) const;
 
+    /**
+     * Records the size and write load of the collection on the specified shard. Once the load of
+     * any shard has been recorded, the collection is balanced by load instead of by chunk count and
+     * shards without a recorded load are considered idle.
+     */
+    void setShardLoad(const ShardId& shardId, ShardLoad load);
+
+    /**
+     * Returns whether the load of any shard has been recorded through setShardLoad.
+     */
+    bool hasShardLoads() const {
+        return !_shardLoads.empty();
+    }
+
+    /**
+     * Returns the recorded load of the specified shard or an empty load if none was recorded.
+     */
+    ShardLoad getShardLoad(const ShardId& shardId) const;
+
+    /**
+     * Returns the average size of the chunks owned by the specified shard, which is used as the
+     * estimated cost of migrating any one of them.
+     */
+    long long estimatedChunkSizeBytes(const ShardId& shardId) const;
+
     /**
      * Returns a BSON/string representation of this distribution status.
      */
@@ -170,6 +207,9 @@ private:
 
     // Set of all zones defined for this collection
     std::set<std::string> _allTags;
+
+    // Size and write load of the collection on each shard, if it is balanced by load
+    std::map<ShardId, ShardLoad> _shardLoads;
 };
 
 class BalancerPolicy {
@@ -193,13 +233,23 @@ public:
      * any of the shards have chunks, which are sufficiently higher than this number, suggests
      * moving chunks to shards, which are under this number.
      *
+     * If the distribution carries the size and write load of the collection on each shard, the
+     * shards are instead compared by their share of the collection's data and writes and chunks
+     * are moved from the most loaded shards to the least loaded ones.
+     *
      * The usedShards parameter is in/out and it contains the set of shards, which have already been
      * used for migrations. Used so we don't return multiple conflicting migrations for the same
      * shard.
+     *
+     * The migrationBytesBudget parameter is in/out and it contains the number of bytes, which
+     * migrations due to load imbalance are still allowed to copy in this round. Each such migration
+     * deducts the estimated size of its chunk and none are suggested once it is exhausted. If it is
+     * nullptr, these migrations are not limited.
      */
     static std::vector<MigrateInfo> balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
                                             std::set<ShardId>* usedShards,
+                                            long long* migrationBytesBudget,
                                             bool forceJumbo);
 
     /**
@@ -248,6 +298,27 @@ private:
                                    std::vector<MigrateInfo>* migrations,
                                    std::set<ShardId>* usedShards,
                                    MoveChunkRequest::ForceJumbo forceJumbo);
+
+    /**
+     * Selects one chunk for the specified zone (if appropriate) to be moved from the shard with the
+     * highest share of the zone's data and writes to the shard with the lowest one. Takes into
+     * account and updates the shards, which have already been used for migrations, and the bytes
+     * budget of the round.
+     *
+     * A chunk is only moved if the donor is sufficiently above the average load and if the move is
+     * not expected to leave the recipient more loaded than the donor, so that the same chunk does
+     * not keep moving back and forth between rounds.
+     *
+     * Returns true if a migration was suggested, false otherwise. This method is intented to be
+     * called multiple times until all posible migrations for a zone have been selected.
+     */
+    static bool _singleZoneBalanceByLoad(const ShardStatisticsVector& shardStats,
+                                         const DistributionStatus& distribution,
+                                         const std::string& tag,
+                                         std::vector<MigrateInfo>* migrations,
+                                         std::set<ShardId>* usedShards,
+                                         long long* migrationBytesBudget,
+                                         MoveChunkRequest::ForceJumbo forceJumbo);
 };
 
 }  // namespace mongo
@@ -115,7 +115,7 @@ std::vector<MigrateInfo> balanceChunks(const ShardStatisticsVector& shardStats,
                                        bool shouldAggressivelyBalance,
                                        bool forceJumbo) {
     std::set<ShardId> usedShards;
-    return BalancerPolicy::balance(shardStats, distribution, &usedShards, forceJumbo);
+    return BalancerPolicy::balance(shardStats, distribution, &usedShards, nullptr, forceJumbo);
 }
 
 TEST(BalancerPolicy, Basic) {
@@ -253,8 +253,11 @@ TEST(BalancerPolicy, ParallelBalancingNotSchedulingOnInUseSourceShardsWithMoveNe
 
     // Here kShardId0 would have been selected as a donor
     std::set<ShardId> usedShards{kShardId0};
-    const auto migrations(BalancerPolicy::balance(
-        cluster.first, DistributionStatus(kNamespace, cluster.second), &usedShards, false));
+    const auto migrations(BalancerPolicy::balance(cluster.first,
+                                                  DistributionStatus(kNamespace, cluster.second),
+                                                  &usedShards,
+                                                  nullptr,
+                                                  false));
     ASSERT_EQ(1U, migrations.size());
 
     ASSERT_EQ(kShardId1, migrations[0].from);
@@ -273,8 +276,11 @@ TEST(BalancerPolicy, ParallelBalancingNotSchedulingOnInUseSourceShardsWithMoveNo
 
     // Here kShardId0 would have been selected as a donor
     std::set<ShardId> usedShards{kShardId0};
-    const auto migrations(BalancerPolicy::balance(
-        cluster.first, DistributionStatus(kNamespace, cluster.second), &usedShards, false));
+    const auto migrations(BalancerPolicy::balance(cluster.first,
+                                                  DistributionStatus(kNamespace, cluster.second),
+                                                  &usedShards,
+                                                  nullptr,
+                                                  false));
     ASSERT_EQ(0U, migrations.size());
 }
 
@@ -287,8 +293,11 @@ TEST(BalancerPolicy, ParallelBalancingNotSchedulingOnInUseDestinationShards) {
 
     // Here kShardId2 would have been selected as a recipient
     std::set<ShardId> usedShards{kShardId2};
-    const auto migrations(BalancerPolicy::balance(
-        cluster.first, DistributionStatus(kNamespace, cluster.second), &usedShards, false));
+    const auto migrations(BalancerPolicy::balance(cluster.first,
+                                                  DistributionStatus(kNamespace, cluster.second),
+                                                  &usedShards,
+                                                  nullptr,
+                                                  false));
     ASSERT_EQ(1U, migrations.size());
 
     ASSERT_EQ(kShardId0, migrations[0].from);
@@ -644,7 +653,8 @@ TEST(BalancerPolicy, BalancerMostOverLoadShardHasMultipleTagsSkipTagWithShardInU
     ASSERT_OK(distribution.addRangeToZone(ZoneRange(BSON("x" << 3), BSON("x" << 5), "c")));
 
     std::set<ShardId> usedShards{kShardId1};
-    const auto migrations(BalancerPolicy::balance(cluster.first, distribution, &usedShards, false));
+    const auto migrations(
+        BalancerPolicy::balance(cluster.first, distribution, &usedShards, nullptr, false));
     ASSERT_EQ(1U, migrations.size());
 
     ASSERT_EQ(kShardId0, migrations[0].from);
@@ -692,6 +702,94 @@ TEST(BalancerPolicy, BalancerHandlesNoShardsWithTag) {
     ASSERT(balanceChunks(cluster.first, distribution, false, false).empty());
 }
 
+TEST(BalancerPolicy, BalancerByLoadMovesChunkOffMostLoadedShard) {
+    // Chunk counts are even, but shard0 holds three times the data and takes three times the writes
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId2, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 4}});
+
+    DistributionStatus distribution(kNamespace, cluster.second);
+    distribution.setShardLoad(kShardId0, {3 * 1024 * 1024, 300});
+    distribution.setShardLoad(kShardId1, {1024 * 1024, 100});
+    distribution.setShardLoad(kShardId2, {1024 * 1024, 100});
+
+    const auto migrations(balanceChunks(cluster.first, distribution, false, false));
+    ASSERT_EQ(1U, migrations.size());
+
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMax(), migrations[0].maxKey);
+    ASSERT_EQ(MigrateInfo::loadImbalance, migrations[0].reason);
+}
+
+TEST(BalancerPolicy, BalancerByLoadIgnoresChunkCountImbalance) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 8},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 2}});
+
+    DistributionStatus distribution(kNamespace, cluster.second);
+    distribution.setShardLoad(kShardId0, {1024 * 1024, 100});
+    distribution.setShardLoad(kShardId1, {1024 * 1024, 100});
+
+    ASSERT(balanceChunks(cluster.first, distribution, false, false).empty());
+}
+
+TEST(BalancerPolicy, BalancerByLoadDoesNotMoveChunkWhichWouldOverloadRecipient) {
+    // Moving the only chunk of shard0 would leave shard1 more loaded than shard0 is now
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 1},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 1}});
+
+    DistributionStatus distribution(kNamespace, cluster.second);
+    distribution.setShardLoad(kShardId0, {3 * 1024 * 1024, 300});
+    distribution.setShardLoad(kShardId1, {2 * 1024 * 1024, 200});
+
+    ASSERT(balanceChunks(cluster.first, distribution, false, false).empty());
+}
+
+TEST(BalancerPolicy, BalancerByLoadRespectsMigrationBytesBudget) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId2, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId3, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 4}});
+
+    DistributionStatus distribution(kNamespace, cluster.second);
+    distribution.setShardLoad(kShardId0, {4 * 1024 * 1024, 300});
+    distribution.setShardLoad(kShardId1, {4 * 1024 * 1024, 300});
+    distribution.setShardLoad(kShardId2, {1024 * 1024, 100});
+    distribution.setShardLoad(kShardId3, {1024 * 1024, 100});
+
+    {
+        std::set<ShardId> usedShards;
+        const auto migrations(
+            BalancerPolicy::balance(cluster.first, distribution, &usedShards, nullptr, false));
+        ASSERT_EQ(2U, migrations.size());
+    }
+
+    {
+        // The budget only affords a part of the first chunk, but the first migration is allowed
+        std::set<ShardId> usedShards;
+        long long migrationBytesBudget = 1024;
+        const auto migrations(BalancerPolicy::balance(
+            cluster.first, distribution, &usedShards, &migrationBytesBudget, false));
+        ASSERT_EQ(1U, migrations.size());
+        ASSERT_EQ(kShardId0, migrations[0].from);
+        ASSERT_EQ(kShardId2, migrations[0].to);
+        ASSERT_EQ(1024 - 1024 * 1024, migrationBytesBudget);
+    }
+
+    {
+        std::set<ShardId> usedShards;
+        long long migrationBytesBudget = 0;
+        ASSERT(BalancerPolicy::balance(
+                   cluster.first, distribution, &usedShards, &migrationBytesBudget, false)
+                   .empty());
+    }
+}
+
 TEST(DistributionStatus, AddTagRangeOverlap) {
     DistributionStatus d(kNamespace, ShardToChunksMap{});
 
@@ -33,6 +33,9 @@
 
 #include "mongo/db/s/migration_chunk_cloner_source_legacy.h"
 
+#include <algorithm>
+#include <set>
+
 #include "mongo/base/status.h"
 #include "mongo/client/read_preference.h"
 #include "mongo/db/catalog/index_catalog.h"
@@ -654,24 +657,44 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromIndexScan(OperationCon
     _jumboChunkCloneState->clonerExec->detachFromOperationContext();
 }
 
-void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationContext* opCtx,
-                                                                    Collection* collection,
-                                                                    BSONArrayBuilder* arrBuilder) {
+Status MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(
+    OperationContext* opCtx,
+    Collection* collection,
+    BSONArrayBuilder* arrBuilder,
+    size_t cloneStream,
+    size_t numCloneStreams) {
     ElapsedTracker tracker(opCtx->getServiceContext()->getFastClockSource(),
                            internalQueryExecYieldIterations.load(),
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
     stdx::unique_lock<Latch> lk(_mutex);
-    auto iter = _cloneLocs.begin();
 
-    for (; iter != _cloneLocs.end(); ++iter) {
+    if (_cloneLocsRanges.empty()) {
+        // Split the record ids into ranges of (almost) equal length, so that the streams finish at
+        // about the same time.
+        for (size_t i = 0; i < numCloneStreams; ++i) {
+            _cloneLocsRanges.push_back({_cloneLocs.size() * i / numCloneStreams,
+                                        _cloneLocs.size() * (i + 1) / numCloneStreams});
+        }
+    }
+
+    if (numCloneStreams != _cloneLocsRanges.size() || cloneStream >= numCloneStreams) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << "Requested clone stream " << cloneStream << " of "
+                              << numCloneStreams << ", but the clone is split into "
+                              << _cloneLocsRanges.size() << " streams"};
+    }
+
+    auto& range = _cloneLocsRanges[cloneStream];
+
+    for (; range.next != range.end; ++range.next, --_numCloneLocsRemaining) {
         // We must always make progress in this method by at least one document because empty
         // return indicates there is no more initial clone data.
         if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
             break;
         }
 
-        auto nextRecordId = *iter;
+        auto nextRecordId = _cloneLocs[range.next];
 
         lk.unlock();
 
@@ -692,7 +715,7 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
         lk.lock();
     }
 
-    _cloneLocs.erase(_cloneLocs.begin(), iter);
+    return Status::OK();
 }
 
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
@@ -701,17 +724,24 @@ uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
         return static_cast<uint64_t>(BSONObjMaxUserSize);
 
     return std::min(static_cast<uint64_t>(BSONObjMaxUserSize),
-                    _averageObjectSizeForCloneLocs * _cloneLocs.size());
+                    _averageObjectSizeForCloneLocs * _numCloneLocsRemaining);
 }
 
 Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
                                                         Collection* collection,
-                                                        BSONArrayBuilder* arrBuilder) {
+                                                        BSONArrayBuilder* arrBuilder,
+                                                        size_t cloneStream,
+                                                        size_t numCloneStreams) {
     dassert(opCtx->lockState()->isCollectionLockedForMode(_args.getNss(), MODE_IS));
 
     // If this chunk is too large to store records in _cloneLocs and the command args specify to
-    // attempt to move it, scan the collection directly.
+    // attempt to move it, scan the collection directly. The scan cannot be split, so only the first
+    // clone stream returns any documents.
     if (_jumboChunkCloneState && _forceJumbo) {
+        if (cloneStream != 0) {
+            return Status::OK();
+        }
+
         try {
             _nextCloneBatchFromIndexScan(opCtx, collection, arrBuilder);
             return Status::OK();
@@ -720,8 +750,8 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
         }
     }
 
-    _nextCloneBatchFromCloneLocs(opCtx, collection, arrBuilder);
-    return Status::OK();
+    return _nextCloneBatchFromCloneLocs(
+        opCtx, collection, arrBuilder, cloneStream, numCloneStreams);
 }
 
 Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
@@ -735,7 +765,7 @@ Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
     {
         // All clone data must have been drained before starting to fetch the incremental changes.
         stdx::unique_lock<Latch> lk(_mutex);
-        invariant(_cloneLocs.empty());
+        invariant(_numCloneLocsRemaining == 0);
 
         // The "snapshot" for delete and update list must be taken under a single lock. This is to
         // ensure that we will preserve the causal order of writes. Always consume the delete
@@ -885,7 +915,7 @@ Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opC
 
             if (!isLargeChunk) {
                 stdx::lock_guard<Latch> lk(_mutex);
-                _cloneLocs.insert(recordId);
+                _cloneLocs.push_back(recordId);
             }
 
             if (++recCount > maxRecsWhenFull) {
@@ -916,6 +946,9 @@ Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opC
     }
 
     stdx::lock_guard<Latch> lk(_mutex);
+    std::sort(_cloneLocs.begin(), _cloneLocs.end());
+    _cloneLocs.erase(std::unique(_cloneLocs.begin(), _cloneLocs.end()), _cloneLocs.end());
+    _numCloneLocsRemaining = _cloneLocs.size();
     _averageObjectSizeForCloneLocs = collectionAverageObjectSize + 12;
 
     return Status::OK();
@@ -998,7 +1031,7 @@ Status MigrationChunkClonerSourceLegacy::_checkRecipientCloningStatus(OperationC
 
         stdx::lock_guard<Latch> sl(_mutex);
 
-        const std::size_t cloneLocsRemaining = _cloneLocs.size();
+        const std::size_t cloneLocsRemaining = _numCloneLocsRemaining;
 
         if (_forceJumbo && _jumboChunkCloneState) {
             LOGV2(21992,
@@ -31,7 +31,7 @@
 
 #include <list>
 #include <memory>
-#include <set>
+#include <vector>
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/client/connection_string.h"
@@ -84,6 +84,12 @@ class MigrationChunkClonerSourceLegacy final : public MigrationChunkClonerSource
     MigrationChunkClonerSourceLegacy& operator=(const MigrationChunkClonerSourceLegacy&) = delete;
 
 public:
+    // Fields of a _migrateClone request from a recipient which fetches the initial clone over
+    // several concurrent streams. See nextCloneBatch().
+    static constexpr StringData kCloneStreamField = "cloneStream"_sd;
+    static constexpr StringData kNumCloneStreamsField = "numCloneStreams"_sd;
+    static constexpr long long kMaxCloneStreams = 16;
+
     MigrationChunkClonerSourceLegacy(MoveChunkRequest request,
                                      const BSONObj& shardKeyPattern,
                                      ConnectionString donorConnStr,
@@ -145,8 +151,13 @@ public:
 
     /**
      * Called by the recipient shard. Populates the passed BSONArrayBuilder with a set of documents,
-     * which are part of the initial clone sequence. Assumes that there is only one active caller
-     * to this method at a time (otherwise, it can cause corruption/crash).
+     * which are part of the initial clone sequence.
+     *
+     * The recipient may fetch the initial clone over several concurrent streams, in which case the
+     * documents to clone are split into 'numCloneStreams' contiguous ranges and this call returns
+     * documents from the range of 'cloneStream' only. All the calls for one migration must agree
+     * on 'numCloneStreams'. Assumes that there is only one active caller to this method for each
+     * stream at a time (otherwise, it can cause corruption/crash).
      *
      * Returns OK status on success. If there were documents returned in the result argument, this
      * method should be called more times until the result is empty. If it returns failure, it is
@@ -160,7 +171,9 @@ public:
      */
     Status nextCloneBatch(OperationContext* opCtx,
                           Collection* collection,
-                          BSONArrayBuilder* arrBuilder);
+                          BSONArrayBuilder* arrBuilder,
+                          size_t cloneStream = 0,
+                          size_t numCloneStreams = 1);
 
     /**
      * Called by the recipient shard. Transfers the accummulated local mods from source to
@@ -227,9 +240,11 @@ private:
                                       Collection* collection,
                                       BSONArrayBuilder* arrBuilder);
 
-    void _nextCloneBatchFromCloneLocs(OperationContext* opCtx,
-                                      Collection* collection,
-                                      BSONArrayBuilder* arrBuilder);
+    Status _nextCloneBatchFromCloneLocs(OperationContext* opCtx,
+                                        Collection* collection,
+                                        BSONArrayBuilder* arrBuilder,
+                                        size_t cloneStream,
+                                        size_t numCloneStreams);
 
     /**
      * Get the disklocs that belong to the chunk migrated and sort them in _cloneLocs (to avoid
@@ -347,8 +362,23 @@ private:
     // The current state of the cloner
     State _state{kNew};
 
-    // List of record ids that needs to be transferred (initial clone)
-    std::set<RecordId> _cloneLocs;
+    // List of record ids that needs to be transferred (initial clone), sorted so that the
+    // documents are read in storage order. Entries are not removed as they are transferred;
+    // instead each clone stream advances through its own range of them.
+    std::vector<RecordId> _cloneLocs;
+
+    // A contiguous range of '_cloneLocs' served to one clone stream. 'next' is the position of the
+    // first entry which has not been transferred yet.
+    struct CloneLocsRange {
+        size_t next;
+        size_t end;
+    };
+
+    // The ranges of '_cloneLocs', one per clone stream, split on the first request for clone data
+    std::vector<CloneLocsRange> _cloneLocsRanges;
+
+    // Number of entries of '_cloneLocs' which have not been transferred yet (initial clone)
+    size_t _numCloneLocsRemaining{0};
 
     // The estimated average object size during the clone phase. Used for buffer size
     // pre-allocation (initial clone).
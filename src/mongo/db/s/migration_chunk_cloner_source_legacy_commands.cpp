@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/bson/util/bson_extract.h"
 #include "mongo/db/auth/action_set.h"
 #include "mongo/db/auth/action_type.h"
 #include "mongo/db/auth/authorization_session.h"
@@ -161,6 +162,23 @@ public:
         const MigrationSessionId migrationSessionId(
             uassertStatusOK(MigrationSessionId::extractFromBSON(cmdObj)));
 
+        // Recipients which fetch the initial clone over several concurrent streams identify the
+        // stream each request is for
+        long long cloneStream = 0;
+        long long numCloneStreams = 1;
+        if (cmdObj.hasField(MigrationChunkClonerSourceLegacy::kNumCloneStreamsField)) {
+            uassertStatusOK(bsonExtractIntegerField(
+                cmdObj, MigrationChunkClonerSourceLegacy::kNumCloneStreamsField, &numCloneStreams));
+            uassertStatusOK(bsonExtractIntegerField(
+                cmdObj, MigrationChunkClonerSourceLegacy::kCloneStreamField, &cloneStream));
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "Invalid clone stream " << cloneStream << " of "
+                                  << numCloneStreams,
+                    numCloneStreams > 0 &&
+                        numCloneStreams <= MigrationChunkClonerSourceLegacy::kMaxCloneStreams &&
+                        cloneStream >= 0 && cloneStream < numCloneStreams);
+        }
+
         boost::optional<BSONArrayBuilder> arrBuilder;
 
         // Try to maximize on the size of the buffer, which we are returning in order to have less
@@ -176,8 +194,11 @@ public:
 
             arrSizeAtPrevIteration = arrBuilder->arrSize();
 
-            uassertStatusOK(autoCloner.getCloner()->nextCloneBatch(
-                opCtx, autoCloner.getColl(), arrBuilder.get_ptr()));
+            uassertStatusOK(autoCloner.getCloner()->nextCloneBatch(opCtx,
+                                                                   autoCloner.getColl(),
+                                                                   arrBuilder.get_ptr(),
+                                                                   cloneStream,
+                                                                   numCloneStreams));
         }
 
         invariant(arrBuilder);
@@ -343,6 +343,73 @@ TEST_F(MigrationChunkClonerSourceLegacyTest, CorrectDocumentsFetched) {
     futureCommit.default_timed_get();
 }
 
+TEST_F(MigrationChunkClonerSourceLegacyTest, CorrectDocumentsFetchedOverSeveralStreams) {
+    std::vector<BSONObj> contents;
+    for (int i = 100; i < 110; ++i) {
+        contents.push_back(createCollectionDocument(i));
+    }
+
+    createShardedCollection(contents);
+
+    MigrationChunkClonerSourceLegacy cloner(
+        createMoveChunkRequest(ChunkRange(BSON("X" << 100), BSON("X" << 200))),
+        kShardKeyPattern,
+        kDonorConnStr,
+        kRecipientConnStr.getServers()[0]);
+
+    {
+        auto futureStartClone = launchAsync([&]() {
+            onCommand([&](const RemoteCommandRequest& request) { return BSON("ok" << true); });
+        });
+
+        ASSERT_OK(cloner.startClone(operationContext(), UUID::gen(), _lsid, _txnNumber));
+        futureStartClone.default_timed_get();
+    }
+
+    {
+        AutoGetCollection autoColl(operationContext(), kNss, MODE_IS);
+
+        // Each stream returns its own half of the documents
+        for (size_t stream = 0; stream < 2; ++stream) {
+            {
+                BSONArrayBuilder arrBuilder;
+                ASSERT_OK(cloner.nextCloneBatch(
+                    operationContext(), autoColl.getCollection(), &arrBuilder, stream, 2));
+                ASSERT_EQ(5, arrBuilder.arrSize());
+
+                const auto arr = arrBuilder.arr();
+                for (size_t i = 0; i < 5; ++i) {
+                    ASSERT_BSONOBJ_EQ(contents[stream * 5 + i], arr[i].Obj());
+                }
+            }
+
+            {
+                BSONArrayBuilder arrBuilder;
+                ASSERT_OK(cloner.nextCloneBatch(
+                    operationContext(), autoColl.getCollection(), &arrBuilder, stream, 2));
+                ASSERT_EQ(0, arrBuilder.arrSize());
+            }
+        }
+
+        // All the requests must agree on the number of streams
+        {
+            BSONArrayBuilder arrBuilder;
+            ASSERT_EQ(ErrorCodes::InvalidOptions,
+                      cloner
+                          .nextCloneBatch(
+                              operationContext(), autoColl.getCollection(), &arrBuilder, 0, 3)
+                          .code());
+        }
+    }
+
+    auto futureCommit = launchAsync([&]() {
+        onCommand([&](const RemoteCommandRequest& request) { return BSON("ok" << true); });
+    });
+
+    ASSERT_OK(cloner.commitClone(operationContext()));
+    futureCommit.default_timed_get();
+}
+
 TEST_F(MigrationChunkClonerSourceLegacyTest, CollectionNotFound) {
     MigrationChunkClonerSourceLegacy cloner(
         createMoveChunkRequest(ChunkRange(BSON("X" << 100), BSON("X" << 200))),
@@ -33,6 +33,7 @@
 
 #include "mongo/db/s/migration_destination_manager.h"
 
+#include <algorithm>
 #include <list>
 #include <vector>
 
@@ -54,6 +55,7 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/s/migration_chunk_cloner_source_legacy.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/move_timing_helper.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
@@ -228,11 +230,22 @@ bool opReplicatedEnough(OperationContext* opCtx,
  * Create the migration clone request BSON object to send to the source shard.
  *
  * 'sessionId' unique identifier for this migration.
+ * 'cloneStream' the stream, out of 'numCloneStreams', which the request fetches documents for.
  */
-BSONObj createMigrateCloneRequest(const NamespaceString& nss, const MigrationSessionId& sessionId) {
+BSONObj createMigrateCloneRequest(const NamespaceString& nss,
+                                  const MigrationSessionId& sessionId,
+                                  size_t cloneStream,
+                                  size_t numCloneStreams) {
     BSONObjBuilder builder;
     builder.append("_migrateClone", nss.ns());
     sessionId.append(&builder);
+    // Leave the stream out of single stream requests, which all donors understand
+    if (numCloneStreams > 1) {
+        builder.append(MigrationChunkClonerSourceLegacy::kCloneStreamField,
+                       static_cast<long long>(cloneStream));
+        builder.append(MigrationChunkClonerSourceLegacy::kNumCloneStreamsField,
+                       static_cast<long long>(numCloneStreams));
+    }
     return builder.obj();
 }
 
@@ -499,6 +512,96 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     return lastOpApplied;
 }
 
+repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
+    OperationContext* opCtx,
+    std::function<void(OperationContext*, BSONObj)> insertBatchFn,
+    std::function<BSONObj(OperationContext*, size_t)> fetchBatchFn,
+    size_t numStreams) {
+    if (numStreams <= 1) {
+        return cloneDocumentsFromDonor(opCtx, insertBatchFn, [&](OperationContext* opCtx) {
+            return fetchBatchFn(opCtx, 0);
+        });
+    }
+
+    Mutex mutex = MONGO_MAKE_LATCH("MigrationDestinationManager::cloneDocumentsFromDonor");
+
+    // The operation contexts of the streams which are running, so that they can be interrupted
+    // when another stream fails, and the error of the first stream which failed
+    std::vector<OperationContext*> streamOpCtxs{opCtx};
+    boost::optional<Status> streamError;
+
+    repl::OpTime lastOpApplied;
+
+    auto runStream = [&](OperationContext* streamOpCtx, size_t stream) {
+        try {
+            auto streamLastOpApplied = cloneDocumentsFromDonor(
+                streamOpCtx, insertBatchFn, [&](OperationContext* fetchOpCtx) {
+                    return fetchBatchFn(fetchOpCtx, stream);
+                });
+
+            stdx::lock_guard<Latch> lk(mutex);
+            lastOpApplied = std::max(lastOpApplied, streamLastOpApplied);
+        } catch (const DBException& ex) {
+            stdx::lock_guard<Latch> lk(mutex);
+            if (!streamError) {
+                streamError = ex.toStatus();
+                LOGV2(5178000,
+                      "Clone stream {stream} failed: {error}",
+                      "Clone stream failed",
+                      "stream"_attr = stream,
+                      "error"_attr = redact(*streamError));
+            }
+
+            for (auto otherOpCtx : streamOpCtxs) {
+                stdx::lock_guard<Client> clientLock(*otherOpCtx->getClient());
+                otherOpCtx->getServiceContext()->killOperation(clientLock, otherOpCtx);
+            }
+        }
+    };
+
+    {
+        std::vector<stdx::thread> streamThreads;
+        auto streamThreadsJoinGuard = makeGuard([&] {
+            for (auto& streamThread : streamThreads) {
+                streamThread.join();
+            }
+        });
+
+        for (size_t stream = 1; stream < numStreams; ++stream) {
+            streamThreads.emplace_back([&, stream] {
+                Client::initKillableThread(str::stream() << "chunkCloneStream-" << stream,
+                                           opCtx->getServiceContext());
+                auto streamOpCtx = Client::getCurrent()->makeOperationContext();
+
+                {
+                    stdx::lock_guard<Latch> lk(mutex);
+                    if (streamError) {
+                        return;
+                    }
+                    streamOpCtxs.push_back(streamOpCtx.get());
+                }
+                ON_BLOCK_EXIT([&] {
+                    stdx::lock_guard<Latch> lk(mutex);
+                    streamOpCtxs.erase(
+                        std::find(streamOpCtxs.begin(), streamOpCtxs.end(), streamOpCtx.get()));
+                });
+
+                runStream(streamOpCtx.get(), stream);
+            });
+        }
+
+        // The first stream runs on this thread
+        runStream(opCtx, 0);
+    }  // This scope ensures that all the streams have finished
+
+    if (streamError) {
+        uassertStatusOK(*streamError);
+    }
+
+    opCtx->checkForInterrupt();
+    return lastOpApplied;
+}
+
 Status MigrationDestinationManager::abort(const MigrationSessionId& sessionId) {
     stdx::lock_guard<Latch> sl(_mutex);
 
@@ -967,7 +1070,7 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         _sessionMigration->start(opCtx->getServiceContext());
 
-        const BSONObj migrateCloneRequest = createMigrateCloneRequest(_nss, *_sessionId);
+        const size_t numCloneStreams = migrateCloneStreams.load();
 
         _chunkMarkedPending = true;  // no lock needed, only the migrate thread looks.
 
@@ -977,6 +1080,9 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
             uassert(50748, "Migration aborted while copying documents", getState() != ABORT);
         };
 
+        Mutex secondaryThrottleMutex =
+            MONGO_MAKE_LATCH("MigrationDestinationManager::secondaryThrottleMutex");
+
         auto insertBatchFn = [&](OperationContext* opCtx, BSONObj arr) {
             auto it = arr.begin();
             while (it != arr.end()) {
@@ -1018,6 +1124,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
                     _clonedBytes += batchClonedBytes;
                 }
                 if (_writeConcern.needToWaitForOtherNodes()) {
+                    // The streams take turns checking in the session of the outer operation
+                    stdx::lock_guard<Latch> secondaryThrottleLock(secondaryThrottleMutex);
                     runWithoutSession(outerOpCtx, [&] {
                         repl::ReplicationCoordinator::StatusAndDuration replStatus =
                             repl::ReplicationCoordinator::get(opCtx)->awaitReplication(
@@ -1039,13 +1147,14 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
             }
         };
 
-        auto fetchBatchFn = [&](OperationContext* opCtx) {
+        auto fetchBatchFn = [&](OperationContext* opCtx, size_t cloneStream) {
             auto res = uassertStatusOKWithContext(
-                fromShard->runCommand(opCtx,
-                                      ReadPreferenceSetting(ReadPreference::PrimaryOnly),
-                                      "admin",
-                                      migrateCloneRequest,
-                                      Shard::RetryPolicy::kNoRetry),
+                fromShard->runCommand(
+                    opCtx,
+                    ReadPreferenceSetting(ReadPreference::PrimaryOnly),
+                    "admin",
+                    createMigrateCloneRequest(_nss, *_sessionId, cloneStream, numCloneStreams),
+                    Shard::RetryPolicy::kNoRetry),
                 "_migrateClone failed: ");
 
             uassertStatusOKWithContext(Shard::CommandResponse::getEffectiveStatus(res),
@@ -1056,7 +1165,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        lastOpApplied =
+            cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn, numCloneStreams);
 
         timing.done(3);
         migrateThreadHangAtStep3.pauseWhileSet();
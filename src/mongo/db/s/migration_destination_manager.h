@@ -120,6 +120,18 @@ public:
         std::function<void(OperationContext*, BSONObj)> insertBatchFn,
         std::function<BSONObj(OperationContext*)> fetchBatchFn);
 
+    /**
+     * Clones documents from a donor shard over 'numStreams' concurrent streams. Each stream fetches
+     * its batches with 'fetchBatchFn', which is passed the number of the stream, and inserts them
+     * with 'insertBatchFn' on a thread of its own. If any stream fails, the others are interrupted
+     * and the error of the first failure is thrown.
+     */
+    static repl::OpTime cloneDocumentsFromDonor(
+        OperationContext* opCtx,
+        std::function<void(OperationContext*, BSONObj)> insertBatchFn,
+        std::function<BSONObj(OperationContext*, size_t)> fetchBatchFn,
+        size_t numStreams);
+
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
      * specified session id. If the migration is already aborted, does nothing.
@@ -30,7 +30,11 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/s/migration_destination_manager.h"
+
+#include <algorithm>
+
 #include "mongo/db/s/shard_server_test_fixture.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 namespace {
@@ -156,5 +160,76 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsCatchesInsertErrors) {
     ASSERT_EQ(operationContext()->getKillStatus(), 51008);
 }
 
+// Tests that the documents fetched by every stream of a multi-stream clone are inserted.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorOverSeveralStreams) {
+    const size_t numStreams = 3;
+
+    // Each stream returns a single batch with the documents of the stream, then an empty one.
+    // Only the thread of a stream accesses its entry.
+    std::vector<char> ranOnce(numStreams, false);
+
+    auto fetchBatchFn = [&](OperationContext* opCtx, size_t stream) {
+        BSONObjBuilder fetchBatchResultBuilder;
+        if (ranOnce[stream]) {
+            fetchBatchResultBuilder.append("objects", BSONObj());
+        } else {
+            ranOnce[stream] = true;
+            BSONArrayBuilder arrayBuilder;
+            for (int i = 0; i < 10; ++i) {
+                arrayBuilder.append(createDocument(stream * 10 + i));
+            }
+            fetchBatchResultBuilder.append("objects", arrayBuilder.arr());
+        }
+
+        return fetchBatchResultBuilder.obj();
+    };
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<BSONObj> resultDocs;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        stdx::lock_guard<Latch> lk(mutex);
+        for (auto&& docToClone : docs) {
+            resultDocs.push_back(docToClone.Obj().getOwned());
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, numStreams);
+
+    std::sort(resultDocs.begin(), resultDocs.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs["_id"].numberInt() < rhs["_id"].numberInt();
+    });
+
+    ASSERT_EQ(numStreams * 10, resultDocs.size());
+    for (size_t i = 0; i < resultDocs.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(createDocument(i), resultDocs[i]);
+    }
+}
+
+// Tests that a fetch error in one stream of a multi-stream clone interrupts the other streams and
+// is thrown on the main thread.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsOverSeveralStreamsThrowsFetchErrors) {
+    auto fetchBatchFn = [&](OperationContext* opCtx, size_t stream) {
+        if (stream == 1) {
+            uasserted(ErrorCodes::NetworkTimeout, "network error");
+        }
+
+        // The other streams never run out of documents, so they only stop when interrupted
+        opCtx->checkForInterrupt();
+        BSONObjBuilder fetchBatchResultBuilder;
+        fetchBatchResultBuilder.append("objects", createDocumentsToCloneArray());
+        return fetchBatchResultBuilder.obj();
+    };
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {};
+
+    ASSERT_THROWS_CODE_AND_WHAT(MigrationDestinationManager::cloneDocumentsFromDonor(
+                                    operationContext(), insertBatchFn, fetchBatchFn, 3),
+                                DBException,
+                                ErrorCodes::NetworkTimeout,
+                                "network error");
+}
+
 }  // namespace
 }  // namespace mongo
@@ -54,6 +54,7 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/wait_for_majority_service.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
@@ -77,6 +78,10 @@ MONGO_FAIL_POINT_DEFINE(suspendRangeDeletion);
 MONGO_FAIL_POINT_DEFINE(throwWriteConflictExceptionInDeleteRange);
 MONGO_FAIL_POINT_DEFINE(throwInternalErrorInDeleteRange);
 
+// The longest delay that the replication lag alone imposes between two batches, so that a lagging
+// set is re-checked regularly.
+const Milliseconds kMaxReplicationLagBatchDelay = Seconds(1);
+
 /**
  * Returns whether the currentCollection has the same UUID as the expectedCollectionUuid. Used to
  * ensure that the collection has not been dropped or dropped and recreated since the range was
@@ -113,6 +118,74 @@ bool collectionUuidHasChanged(const NamespaceString& nss,
     return false;
 }
 
+/**
+ * Deletes up to numDocsToRemovePerBatch documents whose keys in the shard key index 'descriptor'
+ * fall into [min, max), all in one WriteUnitOfWork, see Helpers::deleteWithReservedOplogSlots.
+ * Must not be used on collections recording pre-images.
+ *
+ * Returns the number of documents deleted.
+ */
+int deleteNextGroupedBatch(OperationContext* opCtx,
+                           Collection* collection,
+                           const IndexDescriptor* descriptor,
+                           const BSONObj& min,
+                           const BSONObj& max,
+                           int numDocsToRemovePerBatch) {
+    auto const& nss = collection->ns();
+
+    std::unique_ptr<RemoveSaver> removeSaver;
+    if (serverGlobalParams.moveParanoia) {
+        removeSaver = std::make_unique<RemoveSaver>("moveChunk", nss.ns(), "cleaning");
+    }
+
+    WriteUnitOfWork wuow(opCtx);
+
+    // The range is contiguous in the shard key index, so the batch is the next run of its keys.
+    std::vector<RecordId> batch;
+    {
+        auto exec = InternalPlanner::indexScan(opCtx,
+                                               collection,
+                                               descriptor,
+                                               min,
+                                               max,
+                                               BoundInclusion::kIncludeStartKeyOnly,
+                                               PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                               InternalPlanner::FORWARD,
+                                               removeSaver ? InternalPlanner::IXSCAN_FETCH
+                                                           : InternalPlanner::IXSCAN_DEFAULT);
+        BSONObj obj;
+        RecordId rid;
+        while (static_cast<int>(batch.size()) < numDocsToRemovePerBatch &&
+               exec->getNext(&obj, &rid) != PlanExecutor::IS_EOF) {
+            if (removeSaver) {
+                uassertStatusOK(removeSaver->goingToDelete(obj));
+            }
+            batch.push_back(rid);
+        }
+    }
+
+    if (batch.empty()) {
+        return 0;
+    }
+
+    if (throwWriteConflictExceptionInDeleteRange.shouldFail()) {
+        throw WriteConflictException();
+    }
+
+    if (throwInternalErrorInDeleteRange.shouldFail()) {
+        uasserted(ErrorCodes::InternalError, "Failing for test");
+    }
+
+    Helpers::deleteWithReservedOplogSlots(opCtx, nss, batch.size(), [&](size_t i) {
+        collection->deleteDocument(
+            opCtx, kUninitializedStmtId, batch[i], nullptr, true /* fromMigrate */);
+    });
+
+    wuow.commit();
+    ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(batch.size());
+    return batch.size();
+}
+
 /**
  * Performs the deletion of up to numDocsToRemovePerBatch entries within the range in progress. Must
  * be called under the collection lock.
@@ -171,6 +244,19 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
                             "namespace"_attr = nss.ns());
     }
 
+    if (MONGO_unlikely(hangBeforeDoingDeletion.shouldFail())) {
+        LOGV2(23768, "Hit hangBeforeDoingDeletion failpoint");
+        hangBeforeDoingDeletion.pauseWhileSet(opCtx);
+    }
+
+    // The grouped batch reserves the oplog slot of each delete ahead of the storage write, which
+    // leaves no room for a pre-image no-op entry, so collections recording pre-images use the
+    // delete stage below.
+    if (rangeDeleterBatchDeletes.load() && !collection->getRecordPreImages()) {
+        return deleteNextGroupedBatch(
+            opCtx, collection, descriptor, min, max, numDocsToRemovePerBatch);
+    }
+
     auto deleteStageParams = std::make_unique<DeleteStageParams>();
     deleteStageParams->fromMigrate = true;
     deleteStageParams->isMulti = true;
@@ -191,11 +277,6 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
                                                      PlanYieldPolicy::YieldPolicy::YIELD_MANUAL,
                                                      InternalPlanner::FORWARD);
 
-    if (MONGO_unlikely(hangBeforeDoingDeletion.shouldFail())) {
-        LOGV2(23768, "Hit hangBeforeDoingDeletion failpoint");
-        hangBeforeDoingDeletion.pauseWhileSet(opCtx);
-    }
-
     int numDeleted = 0;
     do {
         BSONObj deletedObj;
@@ -237,6 +318,46 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
 }
 
 
+/**
+ * Returns how long to wait before the next batch. Unless rangeDeleterReplicationLagTargetMS is set,
+ * this is the fixed 'delayBetweenBatches'. Otherwise batches follow each other without a delay as
+ * long as the majority commit point lags behind the last applied write by no more than the target,
+ * and are held back by the excess lag beyond it.
+ */
+Milliseconds getDelayBeforeNextBatch(Milliseconds delayBetweenBatches) {
+    const Milliseconds lagTarget(rangeDeleterReplicationLagTargetMS.load());
+    if (lagTarget <= Milliseconds(0)) {
+        return delayBetweenBatches;
+    }
+
+    auto replCoord = repl::ReplicationCoordinator::get(getGlobalServiceContext());
+    if (!replCoord->isReplEnabled()) {
+        return Milliseconds(0);
+    }
+
+    const auto lastApplied = replCoord->getMyLastAppliedOpTimeAndWallTime();
+    const auto lastCommitted = replCoord->getLastCommittedOpTimeAndWallTime();
+    if (lastCommitted.wallTime == Date_t() || lastCommitted.wallTime >= lastApplied.wallTime) {
+        return Milliseconds(0);
+    }
+
+    const auto lag = lastApplied.wallTime - lastCommitted.wallTime;
+    if (lag <= lagTarget) {
+        return Milliseconds(0);
+    }
+
+    const auto delay = std::min(lag - lagTarget, kMaxReplicationLagBatchDelay);
+    LOGV2_DEBUG(5182000,
+                2,
+                "Delaying the next range deletion batch by {delay} because the replication lag "
+                "{lag} exceeds the target {lagTarget}",
+                "Delaying the next range deletion batch because of replication lag",
+                "delay"_attr = delay,
+                "lag"_attr = lag,
+                "lagTarget"_attr = lagTarget);
+    return delay;
+}
+
 template <typename Callable>
 auto withTemporaryOperationContext(Callable&& callable) {
     ThreadClient tc(migrationutil::kRangeDeletionThreadName, getGlobalServiceContext());
@@ -341,7 +462,8 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                 ErrorCodes::isShutdownError(swNumDeleted.getStatus()) ||
                 ErrorCodes::isNotMasterError(swNumDeleted.getStatus());
         })
-        .withDelayBetweenIterations(delayBetweenBatches)
+        .withDelayBetweenIterations(
+            [delayBetweenBatches] { return getDelayBeforeNextBatch(delayBetweenBatches); })
         .on(executor)
         .ignoreValue();
 }
@@ -50,6 +50,13 @@ extern AtomicWord<int> rangeDeleterBatchSize;
 // next batch of deletions.
 extern AtomicWord<int> rangeDeleterBatchDelayMS;
 
+// Whether each batch of document deletions is removed in a single WriteUnitOfWork.
+extern AtomicWord<bool> rangeDeleterBatchDeletes;
+
+// If positive, the replication lag in millis up to which batches of document deletions follow each
+// other without a delay. Replaces rangeDeleterBatchDelayMS.
+extern AtomicWord<int> rangeDeleterReplicationLagTargetMS;
+
 /**
  * Deletes a range of orphaned documents for the given namespace and collection UUID. Returns a
  * future which will be resolved when the range has finished being deleted. The resulting future
@@ -61,7 +68,8 @@ extern AtomicWord<int> rangeDeleterBatchDelayMS;
  * 2. Waits for delayForActiveQueriesOnSecondariesToComplete seconds before deleting any documents,
  *    to give queries running on secondaries a chance to finish.
  * 3. Delete documents in a series of batches with up to numDocsToRemovePerBatch documents per
- *    batch, with a delay of delayBetweenBatches milliseconds in between batches.
+ *    batch, with a delay of delayBetweenBatches milliseconds in between batches, or a delay
+ *    derived from the replication lag if rangeDeleterReplicationLagTargetMS is set.
  */
 SharedSemiFuture<void> removeDocumentsInRange(
     const std::shared_ptr<executor::TaskExecutor>& executor,
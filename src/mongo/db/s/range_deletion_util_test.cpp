@@ -42,6 +42,7 @@
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -695,6 +696,109 @@ TEST_F(RangeDeleterTest, RemoveDocumentsInRangeRespectsDelayInBetweenBatches) {
     ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
 }
 
+TEST_F(RangeDeleterTest, RemoveDocumentsInRangeSkipsDelayWhileReplicationLagIsBelowTarget) {
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    // More documents than the batch size.
+    const auto numDocsToInsert = 3;
+    const auto numDocsToRemovePerBatch = 1;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    rangeDeleterReplicationLagTargetMS.store(1000);
+    ON_BLOCK_EXIT([] { rangeDeleterReplicationLagTargetMS.store(0); });
+
+    setFilteringMetadataWithUUID(uuid());
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    // The fixed delay would hang the test unless the clock were advanced.
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               boost::none,
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete */,
+                               Hours(1) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
+}
+
+TEST_F(RangeDeleterTest, RemoveDocumentsInRangeRemovesAllDocumentsWithoutGroupedBatches) {
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    const auto numDocsToInsert = 3;
+    const auto numDocsToRemovePerBatch = 2;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    rangeDeleterBatchDeletes.store(false);
+    ON_BLOCK_EXIT([] { rangeDeleterBatchDeletes.store(true); });
+
+    setFilteringMetadataWithUUID(uuid());
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+    // A document outside of the range must survive.
+    dbclient.insert(kNss.toString(), BSON(kShardKey << 10));
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               boost::none,
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete */,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 1);
+}
+
+TEST_F(RangeDeleterTest, RemoveDocumentsInRangeRemovesAllDocumentsOfCollectionRecordingPreImages) {
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    const auto numDocsToInsert = 3;
+    const auto numDocsToRemovePerBatch = 2;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    {
+        AutoGetCollection autoColl(operationContext(), kNss, MODE_X);
+        WriteUnitOfWork wuow(operationContext());
+        autoColl.getCollection()->setRecordPreImages(operationContext(), true);
+        wuow.commit();
+    }
+
+    setFilteringMetadataWithUUID(uuid());
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+    // A document outside of the range must survive.
+    dbclient.insert(kNss.toString(), BSON(kShardKey << 10));
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               boost::none,
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete */,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 1);
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeRespectsOrphanCleanupDelay) {
     const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
     // More documents than the batch size.
@@ -40,9 +40,11 @@
 #include "mongo/db/s/transaction_coordinator_metrics_observer.h"
 #include "mongo/db/s/transaction_coordinator_test_fixture.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/log_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/fail_point.h"
 #include "mongo/util/tick_source_mock.h"
 
 namespace mongo {
@@ -806,6 +808,130 @@ TEST_F(TransactionCoordinatorDriverPersistenceTest,
     assertDocumentMatches(allCoordinatorDocs[0], _lsid, txnNumber2, _participants);
 }
 
+TEST_F(TransactionCoordinatorDriverPersistenceTest,
+       ConcurrentDeletesAreAppliedInOneBatchWithTheirOwnOutcome) {
+    const int numTxns = 10;
+    for (int i = 0; i <= numTxns; i++) {
+        txn::persistParticipantsList(*_aws, _lsid, TxnNumber{i}, _participants).get();
+    }
+    // The last transaction has no decision, so its document must not be deleted.
+    for (int i = 0; i < numTxns; i++) {
+        txn::CoordinatorCommitDecision decision(txn::CommitDecision::kCommit);
+        decision.setCommitTimestamp(_commitTimestamp);
+        txn::persistDecision(*_aws, _lsid, TxnNumber{i}, _participants, decision).get();
+    }
+
+    std::vector<txn::CoordinatorDocWriteBatcher::Result> results(numTxns + 1);
+    std::vector<stdx::thread> threads;
+    const auto startDelete = [&](int i) {
+        threads.emplace_back([&, i] {
+            ThreadClient tc("CoordinatorDocWriteBatcherTest", getServiceContext());
+            auto opCtx = tc->makeOperationContext();
+
+            OperationSessionInfo sessionInfo;
+            sessionInfo.setSessionId(_lsid);
+            sessionInfo.setTxnNumber(TxnNumber{i});
+            results[i] = txn::CoordinatorDocWriteBatcher::get(opCtx.get())
+                             .remove(opCtx.get(),
+                                     BSON(TransactionCoordinatorDocument::kIdFieldName
+                                          << sessionInfo.toBSON()
+                                          << TransactionCoordinatorDocument::kDecisionFieldName
+                                          << BSON("$exists" << true)));
+        });
+    };
+
+    auto& batcher = txn::CoordinatorDocWriteBatcher::get(operationContext());
+    {
+        // Hold the first delete's batch, so that all the other deletes queue up behind it.
+        FailPointEnableBlock fp("hangBeforeApplyingCoordinatorDocWriteBatch");
+        startDelete(0);
+        fp->waitForTimesEntered(fp.initialTimesEntered() + 1);
+
+        for (int i = 1; i <= numTxns; i++) {
+            startDelete(i);
+        }
+        while (batcher.getNumPendingWrites() < size_t(numTxns)) {
+            sleepmillis(1);
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQUALS(results[0].numDocs, 1);
+    ASSERT_EQUALS(results[0].numWritesInBatch, size_t(1));
+    for (int i = 1; i <= numTxns; i++) {
+        ASSERT_EQUALS(results[i].numDocs, i < numTxns ? 1 : 0);
+        ASSERT_EQUALS(results[i].numWritesInBatch, size_t(numTxns));
+    }
+
+    const auto allCoordinatorDocs = txn::readAllCoordinatorDocs(operationContext());
+    ASSERT_EQUALS(allCoordinatorDocs.size(), size_t(1));
+    assertDocumentMatches(allCoordinatorDocs[0], _lsid, numTxns, _participants);
+}
+
+TEST_F(TransactionCoordinatorDriverPersistenceTest,
+       InterruptedDeleteWaitingForABatchIsWithdrawn) {
+    const auto makeDeleteQuery = [&](TxnNumber txnNumber) {
+        OperationSessionInfo sessionInfo;
+        sessionInfo.setSessionId(_lsid);
+        sessionInfo.setTxnNumber(txnNumber);
+        return BSON(TransactionCoordinatorDocument::kIdFieldName
+                    << sessionInfo.toBSON() << TransactionCoordinatorDocument::kDecisionFieldName
+                    << BSON("$exists" << true));
+    };
+    for (TxnNumber txnNumber : {0, 1}) {
+        txn::persistParticipantsList(*_aws, _lsid, txnNumber, _participants).get();
+        txn::CoordinatorCommitDecision decision(txn::CommitDecision::kCommit);
+        decision.setCommitTimestamp(_commitTimestamp);
+        txn::persistDecision(*_aws, _lsid, txnNumber, _participants, decision).get();
+    }
+
+    auto& batcher = txn::CoordinatorDocWriteBatcher::get(operationContext());
+    long long numDocsDeletedByApplier = 0;
+    auto waiterStatus = Status::OK();
+    stdx::thread applyingThread;
+    {
+        // Hold the batch of the first delete, so that the second one waits for the next batch.
+        FailPointEnableBlock fp("hangBeforeApplyingCoordinatorDocWriteBatch");
+        applyingThread = stdx::thread([&] {
+            ThreadClient tc("CoordinatorDocWriteBatcherApplier", getServiceContext());
+            auto opCtx = tc->makeOperationContext();
+            numDocsDeletedByApplier = batcher.remove(opCtx.get(), makeDeleteQuery(0)).numDocs;
+        });
+        fp->waitForTimesEntered(fp.initialTimesEntered() + 1);
+
+        stdx::thread waitingThread([&] {
+            ThreadClient tc("CoordinatorDocWriteBatcherWaiter", getServiceContext());
+            auto opCtx = tc->makeOperationContext();
+            try {
+                batcher.remove(opCtx.get(), makeDeleteQuery(1));
+            } catch (const DBException& ex) {
+                waiterStatus = ex.toStatus();
+            }
+        });
+        while (batcher.getNumPendingWrites() < 1) {
+            sleepmillis(1);
+        }
+        killClientOpCtx(getServiceContext(), "CoordinatorDocWriteBatcherWaiter");
+        waitingThread.join();
+    }
+    applyingThread.join();
+
+    ASSERT_EQUALS(waiterStatus, ErrorCodes::InterruptedAtShutdown);
+    ASSERT_EQUALS(batcher.getNumPendingWrites(), size_t(0));
+    ASSERT_EQUALS(numDocsDeletedByApplier, 1);
+
+    const auto allCoordinatorDocs = txn::readAllCoordinatorDocs(operationContext());
+    ASSERT_EQUALS(allCoordinatorDocs.size(), size_t(1));
+    assertDocumentMatches(allCoordinatorDocs[0],
+                          _lsid,
+                          1,
+                          _participants,
+                          txn::CommitDecision::kCommit,
+                          _commitTimestamp);
+}
+
 
 using TransactionCoordinatorTest = TransactionCoordinatorTestBase;
 
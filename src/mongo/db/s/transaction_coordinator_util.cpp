@@ -33,13 +33,21 @@
 
 #include "mongo/db/s/transaction_coordinator_util.h"
 
+#include <algorithm>
+
 #include "mongo/client/remote_command_retry_scheduler.h"
+#include "mongo/db/catalog_raii.h"
 #include "mongo/db/commands/txn_cmds_gen.h"
 #include "mongo/db/commands/txn_two_phase_commit_cmds_gen.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/dbdirectclient.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/ops/delete.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/transaction_coordinator_futures_util.h"
 #include "mongo/db/s/transaction_coordinator_worker_curop_repository.h"
 #include "mongo/db/storage/flow_control.h"
@@ -59,6 +67,7 @@ MONGO_FAIL_POINT_DEFINE(hangBeforeSendingCommit);
 MONGO_FAIL_POINT_DEFINE(hangBeforeSendingAbort);
 MONGO_FAIL_POINT_DEFINE(hangBeforeDeletingCoordinatorDoc);
 MONGO_FAIL_POINT_DEFINE(hangAfterDeletingCoordinatorDoc);
+MONGO_FAIL_POINT_DEFINE(hangBeforeApplyingCoordinatorDocWriteBatch);
 
 using ResponseStatus = executor::TaskExecutor::ResponseStatus;
 using CoordinatorAction = TransactionCoordinatorWorkerCurOpRepository::CoordinatorAction;
@@ -99,8 +108,126 @@ bool shouldRetryPersistingCoordinatorState(const StatusWith<T>& responseStatus)
         responseStatus != ErrorCodes::TransactionCoordinatorSteppingDown;
 }
 
+const auto getCoordinatorDocWriteBatcher =
+    ServiceContext::declareDecoration<CoordinatorDocWriteBatcher>();
+
 }  // namespace
 
+CoordinatorDocWriteBatcher& CoordinatorDocWriteBatcher::get(OperationContext* opCtx) {
+    return getCoordinatorDocWriteBatcher(opCtx->getServiceContext());
+}
+
+CoordinatorDocWriteBatcher::Result CoordinatorDocWriteBatcher::remove(OperationContext* opCtx,
+                                                                      BSONObj query) {
+    auto write = std::make_shared<PendingWrite>();
+    write->deleteQuery = std::move(query);
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    _pending.push_back(write);
+
+    while (!write->done) {
+        if (_batchInProgress) {
+            try {
+                opCtx->waitForConditionOrInterrupt(
+                    _batchApplied, lk, [&] { return write->done || !_batchInProgress; });
+            } catch (const DBException&) {
+                // Withdraw the deletion, unless the batch being applied has already taken it.
+                auto it = std::find(_pending.begin(), _pending.end(), write);
+                if (it != _pending.end()) {
+                    _pending.erase(it);
+                }
+                throw;
+            }
+            continue;
+        }
+
+        _batchInProgress = true;
+        const size_t maxBatchSize = transactionCoordinatorMaxDocumentWritesPerBatch.load();
+        Batch batch;
+        while (!_pending.empty() && batch.size() < maxBatchSize) {
+            batch.push_back(std::move(_pending.front()));
+            _pending.pop_front();
+        }
+        lk.unlock();
+
+        auto batchStatus = Status::OK();
+        try {
+            hangBeforeApplyingCoordinatorDocWriteBatch.pauseWhileSet(opCtx);
+            _applyBatch(opCtx, batch);
+        } catch (const DBException& ex) {
+            batchStatus = ex.toStatus();
+        }
+
+        // An interruption of this operation context says nothing about the coordinators whose
+        // deletions it was applying, so they are given a retryable error instead.
+        const bool interrupted =
+            !batchStatus.isOK() && !opCtx->checkForInterruptNoAssert().isOK();
+
+        lk.lock();
+        for (auto& pending : batch) {
+            pending->done = true;
+            if (batchStatus.isOK()) {
+                continue;
+            }
+            if (interrupted && pending != write) {
+                pending->status = {ErrorCodes::Interrupted,
+                                   str::stream() << "Batch of transaction coordinator deletions "
+                                                    "was interrupted: "
+                                                 << batchStatus.reason()};
+            } else {
+                pending->status = batchStatus;
+            }
+        }
+        _batchInProgress = false;
+        _batchApplied.notify_all();
+    }
+
+    uassertStatusOK(write->status);
+    return write->result;
+}
+
+size_t CoordinatorDocWriteBatcher::getNumPendingWrites() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _pending.size();
+}
+
+void CoordinatorDocWriteBatcher::_applyBatch(OperationContext* opCtx, const Batch& batch) {
+    const auto& nss = NamespaceString::kTransactionCoordinatorsNamespace;
+
+    LOGV2_DEBUG(5184000,
+                3,
+                "Deleting a batch of transaction coordinator documents",
+                "numWrites"_attr = batch.size());
+
+    AutoGetCollection autoColl(opCtx, nss, MODE_IX);
+    uassert(ErrorCodes::NotMaster,
+            str::stream() << "Not primary while writing to " << nss,
+            repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, nss));
+
+    // Without the collection, no deletion can match a document, just like the equivalent delete
+    // command.
+    auto collection = autoColl.getCollection();
+    if (collection) {
+        writeConflictRetry(opCtx, "deleteTransactionCoordinatorDocs", nss.ns(), [&] {
+            WriteUnitOfWork wuow(opCtx);
+            Helpers::deleteWithReservedOplogSlots(opCtx, nss, batch.size(), [&](size_t i) {
+                batch[i]->result.numDocs = deleteObjects(
+                    opCtx, collection, nss, batch[i]->deleteQuery, true /* justOne */);
+            });
+            wuow.commit();
+        });
+    }
+
+    // A deletion which matched no document must still wait for the writes which made it so to
+    // become majority committed.
+    auto& replClientInfo = repl::ReplClientInfo::forClient(opCtx->getClient());
+    replClientInfo.setLastOpToSystemLastOpTime(opCtx);
+    for (const auto& write : batch) {
+        write->result.opTime = replClientInfo.getLastOp();
+        write->result.numWritesInBatch = batch.size();
+    }
+}
+
 namespace {
 repl::OpTime persistParticipantListBlocking(OperationContext* opCtx,
                                             const LogicalSessionId& lsid,
@@ -486,39 +613,21 @@ void deleteCoordinatorDocBlocking(OperationContext* opCtx,
     sessionInfo.setSessionId(lsid);
     sessionInfo.setTxnNumber(txnNumber);
 
-    DBDirectClient client(opCtx);
-
-    // Throws if serializing the request or deserializing the response fails.
-    auto commandResponse = client.runCommand([&] {
-        write_ops::Delete deleteOp(NamespaceString::kTransactionCoordinatorsNamespace);
-        deleteOp.setDeletes({[&] {
-            write_ops::DeleteOpEntry entry;
-
-            // Ensure the document is only deleted after a decision has been made.
-            BSONObj abortDecision =
-                BSON(TransactionCoordinatorDocument::kDecisionFieldName << "abort");
-            BSONObj commitDecision =
-                BSON(TransactionCoordinatorDocument::kDecisionFieldName << "commit");
-            entry.setQ(BSON(TransactionCoordinatorDocument::kIdFieldName
-                            << sessionInfo.toBSON()
-                            << TransactionCoordinatorDocument::kDecisionFieldName
-                            << BSON("$exists" << true)));
-
-            entry.setMulti(false);
-            return entry;
-        }()});
-        return deleteOp.serialize({});
-    }());
-
-    const auto commandReply = commandResponse->getCommandReply();
-    uassertStatusOK(getStatusFromWriteCommandReply(commandReply));
+    // The deletion is written together with the writes of other concurrent coordinators. Ensure
+    // the document is only deleted after a decision has been made.
+    const auto result = CoordinatorDocWriteBatcher::get(opCtx).remove(
+        opCtx,
+        BSON(TransactionCoordinatorDocument::kIdFieldName
+             << sessionInfo.toBSON() << TransactionCoordinatorDocument::kDecisionFieldName
+             << BSON("$exists" << true)));
 
     // If no document matched, throw an anonymous error. (The delete itself will not have thrown an
     // error, because it's legal for a delete to match no documents.)
-    if (commandReply.getIntField("n") != 1) {
+    if (result.numDocs != 1) {
         // Attempt to include the document for this (lsid, txnNumber) in the error message, if one
         // exists. Note that this is best-effort: the document may have been deleted or manually
         // changed since the update above ran.
+        DBDirectClient client(opCtx);
         const auto doc = client.findOne(
             NamespaceString::kTransactionCoordinatorsNamespace.toString(),
             QUERY(TransactionCoordinatorDocument::kIdFieldName << sessionInfo.toBSON()));
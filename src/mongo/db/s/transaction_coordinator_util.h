@@ -29,11 +29,15 @@
 
 #pragma once
 
+#include <deque>
+#include <memory>
 #include <vector>
 
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/s/transaction_coordinator_document_gen.h"
 #include "mongo/db/s/transaction_coordinator_futures_util.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
 
 namespace mongo {
 namespace txn {
@@ -159,7 +163,8 @@ Future<void> sendAbort(ServiceContext* service,
 /**
  * Deletes the document in config.transaction_coordinators for (lsid, txnNumber).
  *
- * Does *not* wait for the delete to be majority-committed.
+ * Does *not* wait for the delete to be majority-committed. The delete is applied in one batch with
+ * the deletes of other concurrent coordinators, see CoordinatorDocWriteBatcher.
  *
  * Throws if the update fails.
  *
@@ -230,6 +235,69 @@ Future<void> sendDecisionToShard(ServiceContext* service,
                                  const BSONObj& commandObj,
                                  OperationContextFn operationContextFn = [](OperationContext*) {});
 
+/**
+ * Group-commits the deletions of config.transaction_coordinators documents, which concurrent
+ * coordinators make once their transactions are done. Every caller queues its deletion and, unless
+ * another caller is already applying a batch, applies the queued deletions on its own operation
+ * context in a single WriteUnitOfWork. Otherwise it waits for the batch containing its deletion.
+ *
+ * Each deletion still logs its own oplog entry, timestamped with its own reserved slot, see
+ * Helpers::deleteWithReservedOplogSlots. All the deletions of a batch return the opTime of the
+ * batch.
+ */
+class CoordinatorDocWriteBatcher {
+public:
+    struct Result {
+        long long numDocs{0};
+        repl::OpTime opTime;
+
+        // The number of deletions applied in the same batch as this one, including itself.
+        size_t numWritesInBatch{0};
+    };
+
+    static CoordinatorDocWriteBatcher& get(OperationContext* opCtx);
+
+    /**
+     * Deletes at most one document matching 'query' from config.transaction_coordinators and
+     * returns the number of documents deleted. Throws if the batch containing the deletion fails,
+     * or if this operation is interrupted while its deletion waits for a batch.
+     */
+    Result remove(OperationContext* opCtx, BSONObj query);
+
+    /**
+     * Returns the number of deletions waiting for a batch to pick them up.
+     */
+    size_t getNumPendingWrites();
+
+private:
+    struct PendingWrite {
+        BSONObj deleteQuery;
+
+        // Set once the batch containing this deletion has committed, or has failed.
+        bool done{false};
+        Status status{Status::OK()};
+        Result result;
+    };
+
+    using Batch = std::vector<std::shared_ptr<PendingWrite>>;
+
+    /**
+     * Applies the deletions of 'batch' in one WriteUnitOfWork. Throws if any of them fails, in
+     * which case none of them is applied.
+     */
+    void _applyBatch(OperationContext* opCtx, const Batch& batch);
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CoordinatorDocWriteBatcher::_mutex");
+
+    // Signalled every time a batch has completed or has failed.
+    stdx::condition_variable _batchApplied;
+
+    // Deletions queued for the next batch, in arrival order.
+    std::deque<std::shared_ptr<PendingWrite>> _pending;
+
+    bool _batchInProgress{false};
+};
+
 /**
  * Returns a string representation of the transaction id represented by the given session id and
  * transaction number.
@@ -186,6 +186,26 @@ public:
     }
 };
 
+/**
+ * Appends records to an empty RecordStore in increasing RecordId order. See
+ * RecordStore::makeBulkLoader().
+ */
+class RecordStoreBulkLoader {
+public:
+    virtual ~RecordStoreBulkLoader() = default;
+
+    /**
+     * Appends a record and returns the RecordId assigned to it.
+     */
+    virtual StatusWith<RecordId> insertRecord(const char* data, int len) = 0;
+
+    /**
+     * Ends the load and accounts for the loaded records in the record count and data size of the
+     * RecordStore. Must be called once, inside a WriteUnitOfWork, after the last insertRecord().
+     */
+    virtual void finish(OperationContext* opCtx) = 0;
+};
+
 /**
  * An abstraction used for storing documents in a collection or entries in an index.
  *
@@ -386,6 +406,18 @@ public:
         return {};
     }
 
+    /**
+     * Returns a loader which appends records to this RecordStore more cheaply than insertRecords(),
+     * or nullptr if that is not possible. Only empty RecordStores can be bulk loaded, and nothing
+     * else may read or write the RecordStore until the loader is destroyed.
+     *
+     * Loaded records are not part of any WriteUnitOfWork and cannot be rolled back, so a caller
+     * must be prepared to drop the whole RecordStore if the load fails.
+     */
+    virtual std::unique_ptr<RecordStoreBulkLoader> makeBulkLoader(OperationContext* opCtx) {
+        return nullptr;
+    }
+
     // higher level
 
 
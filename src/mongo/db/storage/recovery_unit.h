@@ -41,6 +41,7 @@
 namespace mongo {
 
 class BSONObjBuilder;
+class Client;
 class OperationContext;
 
 /**
@@ -468,6 +469,16 @@ public:
         return false;
     };
 
+    /**
+     * Allows the storage engine to keep this operation's read-only snapshot open once the
+     * operation abandons it, and to continue the next read by 'client' on that snapshot instead of
+     * a new one, as long as the snapshot is younger than an engine-defined bound. Only appropriate
+     * for reads that accept slightly stale data, such as readConcern "local" without
+     * afterClusterTime. A write by 'client' always ends the reuse, so that it reads its own
+     * writes.
+     */
+    virtual void allowReadSnapshotReuse(Client* client) {}
+
     /**
      * Indicates whether a unit of work is active. Will be true after beginUnitOfWork
      * is called and before either commitUnitOfWork or abortUnitOfWork gets called.
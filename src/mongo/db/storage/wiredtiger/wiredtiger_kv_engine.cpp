@@ -215,6 +215,8 @@ public:
 
             _sessionCache->closeExpiredIdleSessions(gWiredTigerSessionCloseIdleTimeSecs.load() *
                                                     1000);
+            _sessionCache->closeExpiredReadSnapshots(
+                Milliseconds(gWiredTigerReadSnapshotReuseMaxAgeMillis.load()));
         }
         LOGV2_DEBUG(22304, 1, "stopping {name} thread", "name"_attr = name());
     }
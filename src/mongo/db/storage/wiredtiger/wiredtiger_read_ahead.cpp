@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
+
+#include <algorithm>
+#include <boost/filesystem/operations.hpp>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#include "mongo/logv2/log.h"
+#include "mongo/platform/posix_fadvise.h"
+#include "mongo/util/errno_util.h"
+
+namespace mongo {
+
+std::unique_ptr<WiredTigerReadAhead> WiredTigerReadAhead::make(
+    const boost::filesystem::path& dataFile, int64_t dataSize, int64_t windowBytes) {
+#if defined(POSIX_FADV_WILLNEED)
+    boost::system::error_code ec;
+    auto fileSize = boost::filesystem::file_size(dataFile, ec);
+    if (ec || fileSize == 0 || dataSize <= 0) {
+        return nullptr;
+    }
+
+    int fd = ::open(dataFile.c_str(), O_RDONLY);
+    if (fd < 0) {
+        auto err = errno;
+        LOGV2_DEBUG(5163000,
+                    1,
+                    "Unable to open data file for read-ahead",
+                    "file"_attr = dataFile.generic_string(),
+                    "error"_attr = errnoWithDescription(err));
+        return nullptr;
+    }
+
+    return std::make_unique<WiredTigerReadAhead>(
+        fd, static_cast<int64_t>(fileSize), dataSize, windowBytes);
+#else
+    return nullptr;
+#endif
+}
+
+WiredTigerReadAhead::WiredTigerReadAhead(int fd,
+                                         int64_t fileSize,
+                                         int64_t dataSize,
+                                         int64_t windowBytes)
+    : _fd(fd), _fileSize(fileSize), _dataSize(dataSize), _windowBytes(windowBytes) {}
+
+WiredTigerReadAhead::~WiredTigerReadAhead() {
+#if !defined(_WIN32)
+    if (_fd >= 0) {
+        ::close(_fd);
+    }
+#endif
+}
+
+boost::optional<WiredTigerReadAhead::Range> WiredTigerReadAhead::onRecord(int64_t size) {
+    _bytesReturned += size;
+    if (_advisedEnd >= _fileSize) {
+        return boost::none;
+    }
+
+    // Compression and free space make the data file smaller or larger than the records it holds,
+    // so scale the bytes returned by the ratio between the two.
+    const int64_t position = std::min(
+        _fileSize,
+        static_cast<int64_t>(static_cast<double>(_bytesReturned) * _fileSize / _dataSize));
+    if (position + _windowBytes / 2 < _advisedEnd) {
+        return boost::none;
+    }
+
+    Range range;
+    range.offset = std::max(position, _advisedEnd);
+    range.length = std::min(position + _windowBytes, _fileSize) - range.offset;
+    if (range.length <= 0) {
+        return boost::none;
+    }
+    _advisedEnd = range.offset + range.length;
+
+#if defined(POSIX_FADV_WILLNEED)
+    if (_fd >= 0) {
+        // Read-ahead is only a hint, so failures are not reported.
+        posix_fadvise(_fd, range.offset, range.length, POSIX_FADV_WILLNEED);
+    }
+#endif
+
+    return range;
+}
+
+}  // namespace mongo
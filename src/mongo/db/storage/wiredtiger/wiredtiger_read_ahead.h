@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <memory>
+
+namespace mongo {
+
+/**
+ * Issues operating system read-ahead for the data file of a table while it is being scanned
+ * forward.
+ *
+ * WiredTiger reads pages on demand, so a scan of cold data turns into many small reads. The data
+ * file of a table that is mostly appended to is laid out roughly in key order, so the position of
+ * a forward scan within the file can be estimated from the fraction of the table's data it has
+ * returned. Ranges ahead of that estimate are handed to posix_fadvise(POSIX_FADV_WILLNEED), which
+ * starts reading them into the page cache in the background.
+ */
+class WiredTigerReadAhead {
+    WiredTigerReadAhead(const WiredTigerReadAhead&) = delete;
+    WiredTigerReadAhead& operator=(const WiredTigerReadAhead&) = delete;
+
+public:
+    struct Range {
+        int64_t offset;
+        int64_t length;
+    };
+
+    /**
+     * Opens 'dataFile' for read-ahead over a table holding 'dataSize' bytes of records. Returns
+     * nullptr if read-ahead is not supported on this platform or the file cannot be opened.
+     */
+    static std::unique_ptr<WiredTigerReadAhead> make(const boost::filesystem::path& dataFile,
+                                                     int64_t dataSize,
+                                                     int64_t windowBytes);
+
+    /**
+     * Read-ahead is advised on 'fd', unless it is negative. The file is 'fileSize' bytes long and
+     * the table holds 'dataSize' bytes of records. At most 'windowBytes' are advised past the
+     * estimated scan position.
+     */
+    WiredTigerReadAhead(int fd, int64_t fileSize, int64_t dataSize, int64_t windowBytes);
+
+    ~WiredTigerReadAhead();
+
+    /**
+     * Accounts for a record of 'size' bytes returned by the scan. Once the scan has used up half
+     * of the range advised so far, advises and returns the next range.
+     */
+    boost::optional<Range> onRecord(int64_t size);
+
+private:
+    const int _fd;
+    const int64_t _fileSize;
+    const int64_t _dataSize;
+    const int64_t _windowBytes;
+
+    // Bytes of records returned by the scan so far.
+    int64_t _bytesReturned = 0;
+
+    // End of the file range advised so far.
+    int64_t _advisedEnd = 0;
+};
+
+}  // namespace mongo
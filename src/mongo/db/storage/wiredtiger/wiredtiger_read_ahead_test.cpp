@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const int64_t kMB = 1024 * 1024;
+
+TEST(WiredTigerReadAheadTest, AdvisesWindowAheadOfScaledPosition) {
+    // The records compress to half their size in the data file.
+    WiredTigerReadAhead readAhead(-1, 100 * kMB, 200 * kMB, 16 * kMB);
+
+    auto range = readAhead.onRecord(kMB);
+    ASSERT(range);
+    ASSERT_EQ(kMB / 2, range->offset);
+    ASSERT_EQ(16 * kMB, range->length);
+
+    // Nothing more is advised until half of the window has been used up.
+    for (int i = 1; i < 16; ++i) {
+        ASSERT_FALSE(readAhead.onRecord(kMB)) << i;
+    }
+
+    // 17MB of records returned puts the scan at 8.5MB into the file.
+    range = readAhead.onRecord(kMB);
+    ASSERT(range);
+    ASSERT_EQ(kMB / 2 + 16 * kMB, range->offset);
+    ASSERT_EQ(8 * kMB, range->length);
+}
+
+TEST(WiredTigerReadAheadTest, StopsAtEndOfFile) {
+    WiredTigerReadAhead readAhead(-1, 10 * kMB, 10 * kMB, 16 * kMB);
+
+    auto range = readAhead.onRecord(kMB);
+    ASSERT(range);
+    ASSERT_EQ(kMB, range->offset);
+    ASSERT_EQ(9 * kMB, range->length);
+
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_FALSE(readAhead.onRecord(kMB)) << i;
+    }
+}
+
+TEST(WiredTigerReadAheadTest, CatchesUpWhenScanOvertakesAdvisedRange) {
+    WiredTigerReadAhead readAhead(-1, 100 * kMB, 100 * kMB, 4 * kMB);
+
+    auto range = readAhead.onRecord(kMB);
+    ASSERT(range);
+    ASSERT_EQ(kMB, range->offset);
+
+    // A large record moves the scan past everything advised so far.
+    range = readAhead.onRecord(20 * kMB);
+    ASSERT(range);
+    ASSERT_EQ(21 * kMB, range->offset);
+    ASSERT_EQ(4 * kMB, range->length);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -57,6 +57,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -720,6 +721,62 @@ private:
     const std::string _config;
 };
 
+/**
+ * Appends records through a WiredTiger bulk cursor, which writes the pages of the empty table
+ * directly rather than searching the tree and allocating an update for every insert.
+ */
+class WiredTigerRecordStore::BulkLoader final : public RecordStoreBulkLoader {
+public:
+    BulkLoader(WiredTigerRecordStore* rs, UniqueWiredTigerSession session, WT_CURSOR* cursor)
+        : _rs(rs), _session(std::move(session)), _cursor(cursor) {}
+
+    ~BulkLoader() {
+        if (_cursor) {
+            invariantWTOK(_cursor->close(_cursor));
+        }
+    }
+
+    StatusWith<RecordId> insertRecord(const char* data, int len) final {
+        invariant(_cursor);
+
+        // The next RecordId was initialized before the bulk cursor was opened, and RecordIds are
+        // handed out in increasing order, as the bulk cursor requires.
+        const RecordId id(_rs->_nextIdNum.fetchAndAdd(1));
+        invariant(id.isNormal());
+
+        _rs->setKey(_cursor, id);
+        WiredTigerItem value(data, len);
+        _cursor->set_value(_cursor, value.Get());
+        int ret = _cursor->insert(_cursor);
+        if (ret) {
+            return wtRCToStatus(ret, "WiredTigerRecordStore::BulkLoader::insertRecord");
+        }
+
+        _numRecords++;
+        _dataSize += len;
+        return id;
+    }
+
+    void finish(OperationContext* opCtx) final {
+        invariant(_cursor);
+        invariant(opCtx->lockState()->inAWriteUnitOfWork());
+
+        // Closing the bulk cursor releases its exclusive access to the table.
+        invariantWTOK(_cursor->close(_cursor));
+        _cursor = nullptr;
+
+        _rs->_changeNumRecords(opCtx, _numRecords);
+        _rs->_increaseDataSize(opCtx, _dataSize);
+    }
+
+private:
+    WiredTigerRecordStore* const _rs;
+    UniqueWiredTigerSession const _session;
+    WT_CURSOR* _cursor;
+    int64_t _numRecords = 0;
+    int64_t _dataSize = 0;
+};
+
 
 // static
 StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
@@ -810,6 +867,7 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
                     getGlobalReplSettings().usingReplSets() ||
                         repl::ReplSettings::shouldRecoverFromOplogAsStandalone())),
       _isOplog(NamespaceString::oplog(params.ns)),
+      _isCatalog(params.ident == "_mdb_catalog"),
       _cappedMaxSize(params.cappedMaxSize),
       _cappedMaxSizeSlack(std::min(params.cappedMaxSize / 10, int64_t(16 * 1024 * 1024))),
       _cappedMaxDocs(params.cappedMaxDocs),
@@ -1036,6 +1094,7 @@ bool WiredTigerRecordStore::findRecord(OperationContext* opCtx,
 void WiredTigerRecordStore::deleteRecord(OperationContext* opCtx, const RecordId& id) {
     dassert(opCtx->lockState()->isWriteLocked());
     invariant(opCtx->lockState()->inAWriteUnitOfWork() || opCtx->lockState()->isNoop());
+    _invalidateReusedReadSnapshotsOnCommit(opCtx);
     // SERVER-48453: Initialize the next record id counter before deleting. This ensures we won't
     // reuse record ids, which can be problematic for the _mdb_catalog.
     _initNextIdIfNeeded(opCtx);
@@ -1077,6 +1136,19 @@ bool WiredTigerRecordStore::cappedAndNeedDelete() const {
     return false;
 }
 
+void WiredTigerRecordStore::_invalidateReusedReadSnapshotsOnCommit(OperationContext* opCtx) {
+    if (!_isCatalog) {
+        return;
+    }
+    auto sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    if (!opCtx->lockState()->inAWriteUnitOfWork()) {
+        sessionCache->notifyCatalogChanged();
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit(
+        [sessionCache](boost::optional<Timestamp>) { sessionCache->notifyCatalogChanged(); });
+}
+
 int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded(OperationContext* opCtx,
                                                      const RecordId& justInserted) {
     if (!_tracksSizeAdjustments) {
@@ -1449,6 +1521,7 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
                                              size_t nRecords) {
     dassert(opCtx->lockState()->isWriteLocked());
     invariant(opCtx->lockState()->inAWriteUnitOfWork() || opCtx->lockState()->isNoop());
+    _invalidateReusedReadSnapshotsOnCommit(opCtx);
 
     // We are kind of cheating on capped collections since we write all of them at once ....
     // Simplest way out would be to just block vector writes for everything except oplog ?
@@ -1598,6 +1671,7 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
                                            int len) {
     dassert(opCtx->lockState()->isWriteLocked());
     invariant(opCtx->lockState()->inAWriteUnitOfWork() || opCtx->lockState()->isNoop());
+    _invalidateReusedReadSnapshotsOnCommit(opCtx);
 
     WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
     curwrap.assertInActiveTxn();
@@ -1708,6 +1782,37 @@ std::unique_ptr<RecordCursor> WiredTigerRecordStore::getRandomCursor(
     return getRandomCursorWithOptions(opCtx, extraConfig);
 }
 
+std::unique_ptr<RecordStoreBulkLoader> WiredTigerRecordStore::makeBulkLoader(
+    OperationContext* opCtx) {
+    if (_isCapped || _isOplog || numRecords(opCtx) != 0) {
+        return nullptr;
+    }
+
+    // The bulk cursor has exclusive access to the table, so find the next RecordId first.
+    _initNextIdIfNeeded(opCtx);
+
+    // Open cursors can cause bulk open_cursor to fail with EBUSY.
+    WiredTigerRecoveryUnit::get(opCtx)->getSession()->closeAllCursors(_uri);
+
+    // A bulk cursor cannot be part of a transaction, so use a different session. Fail quickly
+    // rather than wait on a checkpoint completing; the caller falls back to regular inserts.
+    auto session = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->getSession();
+    WT_SESSION* wtSession = session->getSession();
+    WT_CURSOR* cursor;
+    int ret = wtSession->open_cursor(
+        wtSession, _uri.c_str(), nullptr, "bulk,checkpoint_wait=false", &cursor);
+    if (ret) {
+        LOGV2_DEBUG(5162000,
+                    1,
+                    "Failed to create WiredTiger bulk cursor, falling back to regular inserts",
+                    "uri"_attr = _uri,
+                    "error"_attr = wiredtiger_strerror(ret));
+        return nullptr;
+    }
+
+    return std::make_unique<BulkLoader>(this, std::move(session), cursor);
+}
+
 Status WiredTigerRecordStore::truncate(OperationContext* opCtx) {
     WiredTigerCursor startWrap(_uri, _tableId, true, opCtx);
     WT_CURSOR* start = startWrap.get();
@@ -2176,11 +2281,55 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
 
+    if (_forward) {
+        _trackSequentialRead(value.size);
+    }
+
     _lastReturnedId = id;
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
+void WiredTigerRecordStoreCursorBase::_trackSequentialRead(int64_t size) {
+    if (_readAhead) {
+        _readAhead->onRecord(size);
+        return;
+    }
+
+    const auto minSequentialRecords = gWiredTigerReadAheadMinSequentialRecords.load();
+    _sequentialBytes += size;
+    if (minSequentialRecords <= 0 || ++_sequentialRecords != minSequentialRecords) {
+        return;
+    }
+
+    // The oplog is read from its recently written end, which is almost always cached.
+    if (_rs._isOplog || _rs._isEphemeral) {
+        return;
+    }
+
+    auto dataFile = _rs._kvEngine->getDataFilePathForIdent(_rs.getIdent());
+    if (!dataFile) {
+        return;
+    }
+
+    _readAhead = WiredTigerReadAhead::make(
+        *dataFile, _rs.dataSize(_opCtx), gWiredTigerReadAheadWindowBytes.load());
+    if (_readAhead) {
+        LOGV2_DEBUG(5163001,
+                    2,
+                    "Starting read-ahead for sequential collection scan",
+                    "ident"_attr = _rs.getIdent(),
+                    "records"_attr = _sequentialRecords);
+        // Account for the part of the table the scan has already returned.
+        _readAhead->onRecord(_sequentialBytes);
+    }
+}
+
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
+    // A seek breaks a sequential scan, so its position in the data file is no longer known.
+    _sequentialRecords = 0;
+    _sequentialBytes = 0;
+    _readAhead.reset();
+
     invariant(_hasRestored);
     if (_oplogVisibleTs && id.repr() > *_oplogVisibleTs) {
         _eof = true;
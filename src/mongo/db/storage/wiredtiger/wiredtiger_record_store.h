@@ -40,6 +40,7 @@
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/platform/atomic_word.h"
@@ -167,6 +168,8 @@ public:
 
     std::unique_ptr<RecordCursor> getRandomCursor(OperationContext* opCtx) const final;
 
+    std::unique_ptr<RecordStoreBulkLoader> makeBulkLoader(OperationContext* opCtx) final;
+
     virtual std::unique_ptr<RecordCursor> getRandomCursorWithOptions(
         OperationContext* opCtx, StringData extraConfig) const = 0;
 
@@ -279,6 +282,7 @@ protected:
     virtual void setKey(WT_CURSOR* cursor, RecordId id) const = 0;
 
 private:
+    class BulkLoader;
     class RandomCursor;
 
     class NumRecordsChange;
@@ -342,6 +346,12 @@ private:
     int64_t _cappedDeleteAsNeeded(OperationContext* opCtx, const RecordId& justInserted);
     int64_t _cappedDeleteAsNeeded_inlock(OperationContext* opCtx, const RecordId& justInserted);
 
+    /**
+     * Writes to the durable catalog invalidate the read snapshots kept for reuse by the session
+     * cache once they commit. No-op for other record stores.
+     */
+    void _invalidateReusedReadSnapshotsOnCommit(OperationContext* opCtx);
+
     const std::string _uri;
     const std::string _ident;
     const uint64_t _tableId;  // not persisted
@@ -356,6 +366,8 @@ private:
     const bool _isLogged;
     // True if the namespace of this record store starts with "local.oplog.", and false otherwise.
     const bool _isOplog;
+    // True if this record store holds the durable catalog.
+    const bool _isCatalog;
     int64_t _cappedMaxSize;
     const int64_t _cappedMaxSizeSlack;  // when to start applying backpressure
     const int64_t _cappedMaxDocs;
@@ -486,12 +498,26 @@ protected:
 private:
     bool isVisible(const RecordId& id);
 
+    /**
+     * Accounts for a record of 'size' bytes returned by a forward scan, and starts read-ahead of
+     * the table's data file once the scan has been sequential for long enough.
+     */
+    void _trackSequentialRead(int64_t size);
+
     /**
      * This value is used for visibility calculations on what oplog entries can be returned to a
      * client. This value *must* be initialized/updated *before* a WiredTiger snapshot is
      * established.
      */
     boost::optional<std::int64_t> _oplogVisibleTs = boost::none;
+
+    // Number and total size of the records returned by next() since the cursor was created or
+    // last repositioned.
+    std::int64_t _sequentialRecords = 0;
+    std::int64_t _sequentialBytes = 0;
+
+    // Set once a forward scan has been sequential for wiredTigerReadAheadMinSequentialRecords.
+    std::unique_ptr<WiredTigerReadAhead> _readAhead;
 };
 
 class WiredTigerRecordStoreStandardCursor final : public WiredTigerRecordStoreCursorBase {
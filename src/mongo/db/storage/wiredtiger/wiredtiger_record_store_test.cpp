@@ -221,6 +221,53 @@ StatusWith<RecordId> insertBSON(ServiceContext::UniqueOperationContext& opCtx,
     return res;
 }
 
+TEST(WiredTigerRecordStoreTest, BulkLoaderAppendsRecordsInOrder) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+    std::vector<RecordId> ids;
+    {
+        auto loader = rs->makeBulkLoader(opCtx.get());
+        ASSERT(loader);
+        for (auto data : {"a", "bb", "ccc"}) {
+            StatusWith<RecordId> res = loader->insertRecord(data, strlen(data) + 1);
+            ASSERT_OK(res.getStatus());
+            ASSERT(ids.empty() || ids.back() < res.getValue());
+            ids.push_back(res.getValue());
+        }
+
+        WriteUnitOfWork uow(opCtx.get());
+        loader->finish(opCtx.get());
+        uow.commit();
+    }
+
+    ASSERT_EQ(3, rs->numRecords(opCtx.get()));
+    ASSERT_EQ(2 + 3 + 4, rs->dataSize(opCtx.get()));
+
+    auto cursor = rs->getCursor(opCtx.get());
+    for (auto&& [id, data] : std::vector<std::pair<RecordId, std::string>>{
+             {ids[0], "a"}, {ids[1], "bb"}, {ids[2], "ccc"}}) {
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(id, record->id);
+        ASSERT_EQ(data, record->data.data());
+    }
+    ASSERT_FALSE(cursor->next());
+
+    // Regular inserts continue after the bulk loaded records.
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "d", 2, Timestamp());
+        ASSERT_OK(res.getStatus());
+        ASSERT_GT(res.getValue(), ids.back());
+        uow.commit();
+    }
+
+    // Only empty record stores can be bulk loaded.
+    ASSERT_FALSE(rs->makeBulkLoader(opCtx.get()));
+}
+
 TEST(WiredTigerRecordStoreTest, CappedCursorRollover) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore("a.b", 10000, 5));
@@ -34,9 +34,11 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -56,6 +58,23 @@ logv2::LogSeverity kSlowTransactionSeverity = logv2::LogSeverity::Debug(1);
 
 MONGO_FAIL_POINT_DEFINE(doUntimestampedWritesForIdempotencyTests);
 
+AtomicWord<std::uint64_t> nextReadSnapshotReuseKey{1};
+
+/**
+ * Per-client state for reusing read-only snapshots across operations.
+ */
+struct ReadSnapshotReuseState {
+    // Identifies the client's kept snapshot in the session cache. Unlike the Client's address,
+    // it is never given to another client.
+    const std::uint64_t key = nextReadSnapshotReuseKey.fetchAndAdd(1);
+
+    // False when the client has no snapshot kept in the session cache. True when it may have one;
+    // the session cache can close kept snapshots on its own.
+    bool mayHaveStashedSnapshot = false;
+};
+
+const auto getReadSnapshotReuseState = Client::declareDecoration<ReadSnapshotReuseState>();
+
 }  // namespace
 
 AtomicWord<std::int64_t> snapshotTooOldErrorCount{0};
@@ -167,6 +186,9 @@ WiredTigerRecoveryUnit::WiredTigerRecoveryUnit(WiredTigerSessionCache* sc,
 
 WiredTigerRecoveryUnit::~WiredTigerRecoveryUnit() {
     invariant(!_inUnitOfWork(), toString(_getState()));
+    // A transaction still open here is not kept for reuse, since the operation may no longer hold
+    // the global lock that keeps it from racing with WiredTigerSessionCache::closeAll().
+    _readSnapshotReuseClient = nullptr;
     _abort();
 }
 
@@ -215,6 +237,18 @@ void WiredTigerRecoveryUnit::beginUnitOfWork(OperationContext* opCtx) {
               str::stream() << "cannot begin unit of work while commit or rollback handlers are "
                                "running: "
                             << toString(_getState()));
+
+    // The client is about to write. Neither the current snapshot nor one kept from its previous
+    // reads may be reused afterwards, since they would not see the write.
+    _readSnapshotReusable = false;
+    if (auto client = opCtx->getClient()) {
+        auto& reuseState = getReadSnapshotReuseState(client);
+        if (reuseState.mayHaveStashedSnapshot) {
+            _sessionCache->discardReadSnapshot(reuseState.key);
+            reuseState.mayHaveStashedSnapshot = false;
+        }
+    }
+
     _setState(_isActive() ? State::kActive : State::kInactiveInUnitOfWork);
 }
 
@@ -378,6 +412,12 @@ void WiredTigerRecoveryUnit::_txnClose(bool commit) {
                     3,
                     "WT commit_transaction for snapshot id {snapshotId}",
                     "snapshotId"_attr = getSnapshotId().toNumber());
+    } else if (_stashReadSnapshotForReuse()) {
+        wtRet = 0;
+        LOGV2_DEBUG(5164000,
+                    3,
+                    "WT kept read-only transaction open for reuse",
+                    "snapshotId"_attr = getSnapshotId().toNumber());
     } else {
         wtRet = s->rollback_transaction(s, nullptr);
         invariant(!wtRet);
@@ -493,6 +533,10 @@ void WiredTigerRecoveryUnit::_txnOpen() {
     invariant(!_isCommittingOrAborting(),
               str::stream() << "commit or rollback handler reopened transaction: "
                             << toString(_getState()));
+    _readSnapshotReusable = false;
+    if (_takeStashedReadSnapshot()) {
+        return;
+    }
     _ensureSession();
 
     // Only start a timer for transaction's lifetime if we're going to log it.
@@ -506,6 +550,15 @@ void WiredTigerRecoveryUnit::_txnOpen() {
         case ReadSource::kNoTimestamp: {
             if (_isOplogReader) {
                 _oplogVisibleTs = static_cast<std::int64_t>(_oplogManager->getOplogReadTimestamp());
+            } else if (!_inUnitOfWork() &&
+                       _prepareConflictBehavior == PrepareConflictBehavior::kEnforce &&
+                       _roundUpPreparedTimestamps == RoundUpPreparedTimestamps::kNoRound &&
+                       gWiredTigerReadSnapshotReuseMaxAgeMillis.load() > 0) {
+                // Recorded before the transaction begins, so that a catalog change racing with it
+                // and an age measured from here are both on the safe side.
+                _readSnapshotReusable = true;
+                _readSnapshotCatalogEpoch = _sessionCache->getReadSnapshotCatalogEpoch();
+                _readSnapshotOpenedAt = _sessionCache->getClockSource()->now();
             }
             WiredTigerBeginTxnBlock(session, _prepareConflictBehavior, _roundUpPreparedTimestamps)
                 .done();
@@ -560,6 +613,57 @@ void WiredTigerRecoveryUnit::_txnOpen() {
                 "readSource"_attr = toString(_timestampReadSource));
 }
 
+bool WiredTigerRecoveryUnit::_takeStashedReadSnapshot() {
+    if (!_readSnapshotReuseClient || _isOplogReader || _inUnitOfWork() ||
+        (_timestampReadSource != ReadSource::kUnset &&
+         _timestampReadSource != ReadSource::kNoTimestamp) ||
+        _prepareConflictBehavior != PrepareConflictBehavior::kEnforce ||
+        _roundUpPreparedTimestamps != RoundUpPreparedTimestamps::kNoRound) {
+        return false;
+    }
+
+    auto& reuseState = getReadSnapshotReuseState(_readSnapshotReuseClient);
+    if (!reuseState.mayHaveStashedSnapshot || (_session && _session->cursorsOut() != 0)) {
+        return false;
+    }
+    reuseState.mayHaveStashedSnapshot = false;
+
+    const Milliseconds maxAge{gWiredTigerReadSnapshotReuseMaxAgeMillis.load()};
+    auto stashed = _sessionCache->takeReadSnapshot(
+        reuseState.key, maxAge, &_readSnapshotOpenedAt, &_readSnapshotCatalogEpoch);
+    if (!stashed) {
+        return false;
+    }
+
+    // Our own session, if any, has no transaction open and goes back to the session cache.
+    _session = std::move(stashed);
+    _readSnapshotReusable = true;
+    LOGV2_DEBUG(5164001,
+                3,
+                "WT reusing read-only transaction",
+                "snapshotId"_attr = getSnapshotId().toNumber(),
+                "openedAt"_attr = _readSnapshotOpenedAt);
+    return true;
+}
+
+bool WiredTigerRecoveryUnit::_stashReadSnapshotForReuse() {
+    if (!_readSnapshotReuseClient || !_readSnapshotReusable || _session->cursorsOut() != 0) {
+        return false;
+    }
+
+    const Milliseconds maxAge{gWiredTigerReadSnapshotReuseMaxAgeMillis.load()};
+    if (_readSnapshotOpenedAt + maxAge <= _sessionCache->getClockSource()->now()) {
+        return false;
+    }
+
+    auto& reuseState = getReadSnapshotReuseState(_readSnapshotReuseClient);
+    _sessionCache->stashReadSnapshot(
+        reuseState.key, std::move(_session), _readSnapshotOpenedAt, _readSnapshotCatalogEpoch);
+    reuseState.mayHaveStashedSnapshot = true;
+    _readSnapshotReusable = false;
+    return true;
+}
+
 Timestamp WiredTigerRecoveryUnit::_beginTransactionAtAllDurableTimestamp(WT_SESSION* session) {
     WiredTigerBeginTxnBlock txnOpen(session,
                                     _prepareConflictBehavior,
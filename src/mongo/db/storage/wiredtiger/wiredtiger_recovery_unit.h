@@ -166,6 +166,10 @@ public:
         return _readOnce;
     };
 
+    void allowReadSnapshotReuse(Client* client) override {
+        _readSnapshotReuseClient = client;
+    }
+
     std::shared_ptr<StorageStats> getOperationStatistics() const override;
 
     // ---- WT STUFF
@@ -244,6 +248,19 @@ private:
      */
     Timestamp _getTransactionReadTimestamp(WT_SESSION* session);
 
+    /**
+     * Continues on the snapshot kept by the previous read of the client allowed to reuse it, if
+     * there is one and it is still fresh enough. Returns true if the transaction is now open.
+     */
+    bool _takeStashedReadSnapshot();
+
+    /**
+     * Hands the session and its open read-only transaction to the session cache so the client's
+     * next read can reuse it, instead of rolling the transaction back. Returns false, leaving the
+     * transaction open, when the snapshot cannot be kept.
+     */
+    bool _stashReadSnapshotForReuse();
+
     WiredTigerSessionCache* _sessionCache;  // not owned
     WiredTigerOplogManager* _oplogManager;  // not owned
     UniqueWiredTigerSession _session;
@@ -273,6 +290,14 @@ private:
     std::unique_ptr<Timer> _timer;
     bool _isOplogReader = false;
     boost::optional<int64_t> _oplogVisibleTs = boost::none;
+
+    // The client whose reads may share a snapshot, see allowReadSnapshotReuse().
+    Client* _readSnapshotReuseClient = nullptr;
+    // Whether the open transaction may be kept for reuse: it reads without a timestamp and has not
+    // written. When true, '_readSnapshotOpenedAt' and '_readSnapshotCatalogEpoch' describe it.
+    bool _readSnapshotReusable = false;
+    Date_t _readSnapshotOpenedAt;
+    uint64_t _readSnapshotCatalogEpoch = 0;
 };
 
 }  // namespace mongo
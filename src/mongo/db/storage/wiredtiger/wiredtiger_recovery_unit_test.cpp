@@ -35,6 +35,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/recovery_unit_test_harness.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -42,6 +43,7 @@
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -121,6 +123,10 @@ public:
         return &_engine;
     }
 
+    ClockSourceMock* getClockSource() {
+        return &_cs;
+    }
+
 private:
     unittest::TempDir _dbpath;
     ClockSourceMock _cs;
@@ -664,6 +670,138 @@ TEST_F(WiredTigerRecoveryUnitTestFixture, ReadOnceCursorsAreNotCached) {
     ASSERT(ru->getReadOnce());
 }
 
+TEST_F(WiredTigerRecoveryUnitTestFixture, ReadSnapshotIsReusedByTheSameClientUntilTooOld) {
+    const auto originalMaxAge = gWiredTigerReadSnapshotReuseMaxAgeMillis.load();
+    gWiredTigerReadSnapshotReuseMaxAgeMillis.store(5);
+    ON_BLOCK_EXIT([&] { gWiredTigerReadSnapshotReuseMaxAgeMillis.store(originalMaxAge); });
+
+    auto writerOpCtx = clientAndCtx1.second.get();
+    auto readerOpCtx = clientAndCtx2.second.get();
+    auto sessionCache = ru2->getSessionCache();
+    std::unique_ptr<RecordStore> rs(
+        harnessHelper->createRecordStore(writerOpCtx, "test.read_snapshot_reuse"));
+
+    auto insert = [&] {
+        WriteUnitOfWork wuow(writerOpCtx);
+        auto rid = rs->insertRecord(writerOpCtx, "data", 4, Timestamp());
+        ASSERT_OK(rid);
+        wuow.commit();
+        return rid.getValue();
+    };
+    // Simulates the client's next operation, which gets a new recovery unit.
+    auto newReaderOperation = [&] {
+        readerOpCtx->setRecoveryUnit(harnessHelper->newRecoveryUnit(),
+                                     WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+        auto ru = WiredTigerRecoveryUnit::get(readerOpCtx);
+        ru->allowReadSnapshotReuse(readerOpCtx->getClient());
+        return ru;
+    };
+
+    RecordData rd;
+    auto rid1 = insert();
+    auto readerRU = newReaderOperation();
+    ASSERT_TRUE(rs->findRecord(readerOpCtx, rid1, &rd));
+    readerRU->abandonSnapshot();
+    ASSERT_EQ(1U, sessionCache->getStashedReadSnapshotsCount());
+
+    // The next read continues on the kept snapshot and does not see a newer write by another
+    // client.
+    auto rid2 = insert();
+    readerRU = newReaderOperation();
+    ASSERT_FALSE(rs->findRecord(readerOpCtx, rid2, &rd));
+    ASSERT_EQ(0U, sessionCache->getStashedReadSnapshotsCount());
+    readerRU->abandonSnapshot();
+    ASSERT_EQ(1U, sessionCache->getStashedReadSnapshotsCount());
+
+    // Once the snapshot is older than the bound, the read starts a new one.
+    harnessHelper->getClockSource()->advance(Milliseconds(5));
+    readerRU = newReaderOperation();
+    ASSERT_TRUE(rs->findRecord(readerOpCtx, rid2, &rd));
+    ASSERT_EQ(0U, sessionCache->getStashedReadSnapshotsCount());
+    readerRU->abandonSnapshot();
+    ASSERT_EQ(1U, sessionCache->getStashedReadSnapshotsCount());
+
+    // Operations that do not allow reuse neither take nor keep a snapshot.
+    readerOpCtx->setRecoveryUnit(harnessHelper->newRecoveryUnit(),
+                                 WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+    ASSERT_TRUE(rs->findRecord(readerOpCtx, rid2, &rd));
+    readerOpCtx->recoveryUnit()->abandonSnapshot();
+    ASSERT_EQ(1U, sessionCache->getStashedReadSnapshotsCount());
+
+    sessionCache->closeExpiredReadSnapshots(Milliseconds(5));
+    ASSERT_EQ(1U, sessionCache->getStashedReadSnapshotsCount());
+    harnessHelper->getClockSource()->advance(Milliseconds(5));
+    sessionCache->closeExpiredReadSnapshots(Milliseconds(5));
+    ASSERT_EQ(0U, sessionCache->getStashedReadSnapshotsCount());
+}
+
+TEST_F(WiredTigerRecoveryUnitTestFixture, ClientWriteDiscardsItsKeptReadSnapshot) {
+    const auto originalMaxAge = gWiredTigerReadSnapshotReuseMaxAgeMillis.load();
+    gWiredTigerReadSnapshotReuseMaxAgeMillis.store(5);
+    ON_BLOCK_EXIT([&] { gWiredTigerReadSnapshotReuseMaxAgeMillis.store(originalMaxAge); });
+
+    auto opCtx = clientAndCtx1.second.get();
+    auto sessionCache = ru1->getSessionCache();
+    std::unique_ptr<RecordStore> rs(
+        harnessHelper->createRecordStore(opCtx, "test.read_snapshot_reuse_write"));
+
+    RecordId rid1;
+    {
+        WriteUnitOfWork wuow(opCtx);
+        auto res = rs->insertRecord(opCtx, "data", 4, Timestamp());
+        ASSERT_OK(res);
+        rid1 = res.getValue();
+        wuow.commit();
+    }
+
+    RecordData rd;
+    ru1->allowReadSnapshotReuse(opCtx->getClient());
+    ASSERT_TRUE(rs->findRecord(opCtx, rid1, &rd));
+    ru1->abandonSnapshot();
+    ASSERT_EQ(1U, sessionCache->getStashedReadSnapshotsCount());
+
+    // The client writes, and must read its write afterwards.
+    RecordId rid2;
+    {
+        WriteUnitOfWork wuow(opCtx);
+        ASSERT_EQ(0U, sessionCache->getStashedReadSnapshotsCount());
+        auto res = rs->insertRecord(opCtx, "data", 4, Timestamp());
+        ASSERT_OK(res);
+        rid2 = res.getValue();
+        wuow.commit();
+    }
+    ASSERT_TRUE(rs->findRecord(opCtx, rid2, &rd));
+}
+
+TEST_F(WiredTigerRecoveryUnitTestFixture, ReadSnapshotOpenedBeforeCloseAllIsNotKept) {
+    const auto originalMaxAge = gWiredTigerReadSnapshotReuseMaxAgeMillis.load();
+    gWiredTigerReadSnapshotReuseMaxAgeMillis.store(5);
+    ON_BLOCK_EXIT([&] { gWiredTigerReadSnapshotReuseMaxAgeMillis.store(originalMaxAge); });
+
+    auto opCtx = clientAndCtx1.second.get();
+    auto sessionCache = ru1->getSessionCache();
+    std::unique_ptr<RecordStore> rs(
+        harnessHelper->createRecordStore(opCtx, "test.read_snapshot_reuse_close_all"));
+
+    RecordId rid;
+    {
+        WriteUnitOfWork wuow(opCtx);
+        auto res = rs->insertRecord(opCtx, "data", 4, Timestamp());
+        ASSERT_OK(res);
+        rid = res.getValue();
+        wuow.commit();
+    }
+
+    RecordData rd;
+    ru1->allowReadSnapshotReuse(opCtx->getClient());
+    ASSERT_TRUE(rs->findRecord(opCtx, rid, &rd));
+
+    // The read ends after all the sessions have been closed, so its snapshot must not outlive them.
+    sessionCache->closeAll();
+    ru1->abandonSnapshot();
+    ASSERT_EQ(0U, sessionCache->getStashedReadSnapshotsCount());
+}
+
 TEST_F(WiredTigerRecoveryUnitTestFixture, CommitWithDurableTimestamp) {
     auto opCtx = clientAndCtx1.second.get();
     Timestamp ts1(3, 3);
@@ -418,6 +418,133 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     }
 }
 
+void WiredTigerSessionCache::stashReadSnapshot(uint64_t clientKey,
+                                               UniqueWiredTigerSession session,
+                                               Date_t openedAt,
+                                               uint64_t catalogEpoch) {
+    invariant(session);
+    invariant(session->cursorsOut() == 0);
+
+    std::vector<StashedReadSnapshot> toClose;
+    ON_BLOCK_EXIT([&] { _closeReadSnapshots(std::move(toClose)); });
+
+    StashedReadSnapshot snapshot{std::move(session), openedAt, catalogEpoch};
+    if (isShuttingDown()) {
+        toClose.push_back(std::move(snapshot));
+        return;
+    }
+
+    const auto now = _clockSource->now();
+    const Milliseconds maxAge{gWiredTigerReadSnapshotReuseMaxAgeMillis.load()};
+
+    stdx::lock_guard<Latch> lock(_readSnapshotsLock);
+    // A session checked out before closeAll() must not be kept past it. closeAll() bumps the epoch
+    // before it closes the kept snapshots under this lock, so checking the epoch here guarantees
+    // that either the snapshot is refused or closeAll() closes it.
+    if (snapshot.session->_getEpoch() != _epoch.load()) {
+        toClose.push_back(std::move(snapshot));
+        return;
+    }
+
+    auto it = _readSnapshots.find(clientKey);
+    if (it != _readSnapshots.end()) {
+        toClose.push_back(std::move(it->second));
+        it->second = std::move(snapshot);
+    } else {
+        _readSnapshots.emplace(clientKey, std::move(snapshot));
+    }
+
+    // Snapshots of clients that stopped reading are only closed by a sweep. Sweep them here as
+    // well, but at most once per 'maxAge', so that they do not pin old data for long.
+    if (now < _nextReadSnapshotSweep) {
+        return;
+    }
+    _nextReadSnapshotSweep = now + maxAge;
+    for (auto sweepIt = _readSnapshots.begin(); sweepIt != _readSnapshots.end();) {
+        if (sweepIt->second.openedAt + maxAge <= now) {
+            toClose.push_back(std::move(sweepIt->second));
+            _readSnapshots.erase(sweepIt++);
+        } else {
+            ++sweepIt;
+        }
+    }
+}
+
+UniqueWiredTigerSession WiredTigerSessionCache::takeReadSnapshot(uint64_t clientKey,
+                                                                 Milliseconds maxAge,
+                                                                 Date_t* openedAt,
+                                                                 uint64_t* catalogEpoch) {
+    std::vector<StashedReadSnapshot> toClose;
+    ON_BLOCK_EXIT([&] { _closeReadSnapshots(std::move(toClose)); });
+
+    StashedReadSnapshot snapshot;
+    {
+        stdx::lock_guard<Latch> lock(_readSnapshotsLock);
+        auto it = _readSnapshots.find(clientKey);
+        if (it == _readSnapshots.end()) {
+            return nullptr;
+        }
+        snapshot = std::move(it->second);
+        _readSnapshots.erase(it);
+    }
+
+    if (snapshot.openedAt + maxAge <= _clockSource->now() ||
+        snapshot.catalogEpoch != _readSnapshotCatalogEpoch.load() ||
+        snapshot.session->_getEpoch() != _epoch.load()) {
+        toClose.push_back(std::move(snapshot));
+        return nullptr;
+    }
+
+    *openedAt = snapshot.openedAt;
+    *catalogEpoch = snapshot.catalogEpoch;
+    return std::move(snapshot.session);
+}
+
+void WiredTigerSessionCache::discardReadSnapshot(uint64_t clientKey) {
+    std::vector<StashedReadSnapshot> toClose;
+    {
+        stdx::lock_guard<Latch> lock(_readSnapshotsLock);
+        auto it = _readSnapshots.find(clientKey);
+        if (it == _readSnapshots.end()) {
+            return;
+        }
+        toClose.push_back(std::move(it->second));
+        _readSnapshots.erase(it);
+    }
+    _closeReadSnapshots(std::move(toClose));
+}
+
+void WiredTigerSessionCache::closeExpiredReadSnapshots(Milliseconds maxAge) {
+    const auto now = _clockSource->now();
+    std::vector<StashedReadSnapshot> toClose;
+    {
+        stdx::lock_guard<Latch> lock(_readSnapshotsLock);
+        for (auto it = _readSnapshots.begin(); it != _readSnapshots.end();) {
+            if (it->second.openedAt + maxAge <= now) {
+                toClose.push_back(std::move(it->second));
+                _readSnapshots.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+    _closeReadSnapshots(std::move(toClose));
+}
+
+size_t WiredTigerSessionCache::getStashedReadSnapshotsCount() {
+    stdx::lock_guard<Latch> lock(_readSnapshotsLock);
+    return _readSnapshots.size();
+}
+
+void WiredTigerSessionCache::_closeReadSnapshots(std::vector<StashedReadSnapshot> snapshots) {
+    for (auto& snapshot : snapshots) {
+        WT_SESSION* s = snapshot.session->getSession();
+        invariantWTOK(s->rollback_transaction(s, nullptr));
+        // The session goes back to the cache, or is freed if closeAll() ran in the meantime.
+        snapshot.session.reset();
+    }
+}
+
 void WiredTigerSessionCache::closeAll() {
     // Increment the epoch as we are now closing all sessions with this epoch.
     SessionCache swap;
@@ -428,6 +555,21 @@ void WiredTigerSessionCache::closeAll() {
         _sessions.swap(swap);
     }
 
+    // Snapshots kept for reuse hold open transactions, which must end before the sessions can be
+    // closed or WiredTiger can roll back to the stable timestamp. The epoch is bumped first, so
+    // stashReadSnapshot() refuses any snapshot of an older epoch from now on.
+    {
+        std::vector<StashedReadSnapshot> toClose;
+        {
+            stdx::lock_guard<Latch> lock(_readSnapshotsLock);
+            for (auto& entry : _readSnapshots) {
+                toClose.push_back(std::move(entry.second));
+            }
+            _readSnapshots.clear();
+        }
+        _closeReadSnapshots(std::move(toClose));
+    }
+
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
         delete (*i);
     }
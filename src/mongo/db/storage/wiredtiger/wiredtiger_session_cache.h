@@ -31,6 +31,7 @@
 
 #include <list>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
@@ -38,7 +39,10 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -264,6 +268,56 @@ public:
      */
     void closeExpiredIdleSessions(int64_t idleTimeMillis);
 
+    /**
+     * Keeps 'session', which has an open read-only transaction that began at 'openedAt', so that
+     * the next read from the client identified by 'clientKey' can continue on the same snapshot.
+     * 'catalogEpoch' is the value of getReadSnapshotCatalogEpoch() before the transaction began.
+     * Any snapshot already kept for that client is closed. 'session' is closed instead of kept if
+     * it was checked out before the last closeAll().
+     */
+    void stashReadSnapshot(uint64_t clientKey,
+                           std::unique_ptr<WiredTigerSession, WiredTigerSessionDeleter> session,
+                           Date_t openedAt,
+                           uint64_t catalogEpoch);
+
+    /**
+     * Returns the session kept for 'clientKey' with its transaction still open, or nullptr if
+     * there is none. A kept snapshot older than 'maxAge', or one that began before the last
+     * catalog change, is closed instead of returned. 'openedAt' is set to the time the returned
+     * snapshot began and 'catalogEpoch' to the epoch it was stashed with.
+     */
+    std::unique_ptr<WiredTigerSession, WiredTigerSessionDeleter> takeReadSnapshot(
+        uint64_t clientKey, Milliseconds maxAge, Date_t* openedAt, uint64_t* catalogEpoch);
+
+    /**
+     * Closes the snapshot kept for 'clientKey', if any. Called when the client writes, so that it
+     * always reads its own writes.
+     */
+    void discardReadSnapshot(uint64_t clientKey);
+
+    /**
+     * Closes every kept snapshot that is older than 'maxAge'.
+     */
+    void closeExpiredReadSnapshots(Milliseconds maxAge);
+
+    /**
+     * Invalidates every kept snapshot that began before this call. Called after a change to the
+     * durable catalog commits, since a snapshot taken earlier would not see the data behind the
+     * in-memory catalog.
+     */
+    void notifyCatalogChanged() {
+        _readSnapshotCatalogEpoch.fetchAndAdd(1);
+    }
+
+    uint64_t getReadSnapshotCatalogEpoch() const {
+        return _readSnapshotCatalogEpoch.load();
+    }
+
+    /**
+     * Number of read snapshots currently kept for reuse.
+     */
+    size_t getStashedReadSnapshotsCount();
+
     /**
      * Free all cached sessions and ensures that previously acquired sessions will be freed on
      * release.
@@ -359,6 +413,10 @@ public:
         return _engine;
     }
 
+    ClockSource* getClockSource() const {
+        return _clockSource;
+    }
+
     std::uint64_t getPrepareCommitOrAbortCount() const {
         return _prepareCommitOrAbortCounter.loadRelaxed();
     }
@@ -409,6 +467,27 @@ private:
     WT_SESSION* _waitUntilDurableSession = nullptr;  // owned, and never explicitly closed
                                                      // (uses connection close to clean up)
 
+    // A read-only transaction left open by a client's previous read, see stashReadSnapshot().
+    struct StashedReadSnapshot {
+        std::unique_ptr<WiredTigerSession, WiredTigerSessionDeleter> session;
+        Date_t openedAt;
+        uint64_t catalogEpoch;
+    };
+
+    // Protects _readSnapshots and _nextReadSnapshotSweep.
+    Mutex _readSnapshotsLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_readSnapshotsLock");
+    stdx::unordered_map<uint64_t, StashedReadSnapshot> _readSnapshots;
+    Date_t _nextReadSnapshotSweep;
+
+    // Bumped when a durable catalog change commits.
+    AtomicWord<unsigned long long> _readSnapshotCatalogEpoch{0};
+
+    /**
+     * Rolls back the transactions of the given stashed snapshots and releases their sessions.
+     * Must not be called while holding _readSnapshotsLock.
+     */
+    void _closeReadSnapshots(std::vector<StashedReadSnapshot> snapshots);
+
     /**
      * Returns a session to the cache for later reuse. If closeAll was called between getting this
      * session and releasing it, the session is directly released. This method is thread safe.
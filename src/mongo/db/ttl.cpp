@@ -44,6 +44,7 @@
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/namespace_string.h"
@@ -57,6 +58,8 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -72,10 +75,13 @@ MONGO_FAIL_POINT_DEFINE(hangTTLMonitorWithLock);
 
 Counter64 ttlPasses;
 Counter64 ttlDeletedDocuments;
+Counter64 ttlDeletedDocumentBatches;
 
 ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
+ServerStatusMetricField<Counter64> ttlDeletedDocumentBatchesDisplay("ttl.deletedDocumentBatches",
+                                                                    &ttlDeletedDocumentBatches);
 
 class TTLMonitor : public BackgroundJob {
 public:
@@ -109,6 +115,13 @@ public:
             tc.get()->setSystemOperationKillable(lk);
         }
 
+        _indexWorkers = makeIndexWorkers();
+        _indexWorkers->startup();
+        ON_BLOCK_EXIT([&] {
+            _indexWorkers->shutdown();
+            _indexWorkers->join();
+        });
+
         while (true) {
             {
                 // Wait until either ttlMonitorSleepSecs passes or a shutdown is requested.
@@ -166,6 +179,24 @@ public:
     }
 
 private:
+    /**
+     * Returns the pool on which doTTLPass() processes TTL indexes concurrently.
+     */
+    static std::unique_ptr<ThreadPool> makeIndexWorkers() {
+        ThreadPool::Options options;
+        options.poolName = "TTLMonitorIndexWorkers";
+        options.minThreads = 0;
+        options.maxThreads = ttlMonitorMaxConcurrentIndexes;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName);
+            AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+
+            stdx::lock_guard<Client> lk(cc());
+            cc().setSystemOperationKillable(lk);
+        };
+        return std::make_unique<ThreadPool>(options);
+    }
+
     /**
      * Gets all TTL indexes from every collection and performs doTTLForIndex().
      */
@@ -233,26 +264,56 @@ private:
             ttlIndexes.push_back(std::make_pair(*nss, spec.getOwned()));
         }
 
-        for (const auto& it : ttlIndexes) {
-            try {
-                doTTLForIndex(&opCtx, it.first, it.second);
-            } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
-                LOGV2_WARNING(22537,
-                              "TTLMonitor was interrupted, waiting {ttlMonitorSleepSecs_load} "
-                              "seconds before doing another pass",
-                              "TTLMonitor was interrupted, waiting before doing another pass",
-                              "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
-                return;
-            } catch (const DBException& dbex) {
-                LOGV2_ERROR(22538,
-                            "Error processing ttl index: {it_second} -- {dbex}",
-                            "Error processing TTL index",
-                            "index"_attr = it.second,
-                            "error"_attr = dbex);
-                // Continue on to the next index.
-                continue;
+        if (ttlIndexes.size() <= 1 || ttlMonitorMaxConcurrentIndexes == 1) {
+            for (const auto& it : ttlIndexes) {
+                if (!doTTLForIndexAndLogErrors(&opCtx, it.first, it.second)) {
+                    return;
+                }
             }
+            return;
         }
+
+        // Each index is processed on its own worker with its own operation context, so that a
+        // collection with a large backlog of expired documents does not hold up the others. An
+        // interrupted worker only gives up on its own index; the remaining workers are interrupted
+        // by the same shutdown or stepdown.
+        for (const auto& it : ttlIndexes) {
+            _indexWorkers->schedule([this, nss = it.first, spec = it.second](Status status) {
+                if (!status.isOK()) {
+                    return;
+                }
+                const ServiceContext::UniqueOperationContext workerOpCtx =
+                    cc().makeOperationContext();
+                doTTLForIndexAndLogErrors(workerOpCtx.get(), nss, spec);
+            });
+        }
+        _indexWorkers->waitForIdle();
+    }
+
+    /**
+     * Performs doTTLForIndex() and logs any error it raises. Returns false if the operation was
+     * interrupted, in which case no further indexes should be processed during this pass.
+     */
+    bool doTTLForIndexAndLogErrors(OperationContext* opCtx,
+                                   const NamespaceString& collectionNSS,
+                                   const BSONObj& idx) {
+        try {
+            doTTLForIndex(opCtx, collectionNSS, idx);
+        } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+            LOGV2_WARNING(22537,
+                          "TTLMonitor was interrupted, waiting {ttlMonitorSleepSecs_load} "
+                          "seconds before doing another pass",
+                          "TTLMonitor was interrupted, waiting before doing another pass",
+                          "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
+            return false;
+        } catch (const DBException& dbex) {
+            LOGV2_ERROR(22538,
+                        "Error processing ttl index: {it_second} -- {dbex}",
+                        "Error processing TTL index",
+                        "index"_attr = idx,
+                        "error"_attr = dbex);
+        }
+        return true;
     }
 
     /**
@@ -290,6 +351,40 @@ private:
                     "key"_attr = key,
                     "name"_attr = name);
 
+        long long numDeleted = 0;
+        if (ttlMonitorBatchDeletes.load()) {
+            // The collection lock is re-acquired for every batch, so that operations needing a
+            // stronger lock are not held up behind a long range of expired documents.
+            bool exhausted = false;
+            while (!exhausted) {
+                opCtx->checkForInterrupt();
+                numDeleted += deleteExpired(opCtx, collectionNSS, idx, true, &exhausted);
+            }
+        } else {
+            bool exhausted = false;
+            numDeleted = deleteExpired(opCtx, collectionNSS, idx, false, &exhausted);
+        }
+
+        ttlDeletedDocuments.increment(numDeleted);
+        LOGV2_DEBUG(22536, 1, "deleted: {numDeleted}", "numDeleted"_attr = numDeleted);
+    }
+
+    /**
+     * Deletes the documents of 'collectionNSS' that have expired according to the TTL index 'idx'.
+     * If 'batched' is false, or the collection records pre-images, all of them are removed by a
+     * yielding delete plan. Otherwise a single batch is removed, see deleteExpiredBatch(). Sets
+     * 'exhausted' to false only if more expired documents may remain. Returns the number of
+     * documents deleted.
+     */
+    long long deleteExpired(OperationContext* opCtx,
+                            const NamespaceString& collectionNSS,
+                            BSONObj idx,
+                            bool batched,
+                            bool* exhausted) {
+        *exhausted = true;
+        const BSONObj key = idx["key"].Obj();
+        const StringData name = idx["name"].valueStringData();
+
         AutoGetCollection autoGetCollection(opCtx, collectionNSS, MODE_IX);
         if (MONGO_unlikely(hangTTLMonitorWithLock.shouldFail())) {
             LOGV2(22534, "Hanging due to hangTTLMonitorWithLock fail point");
@@ -300,11 +395,11 @@ private:
         Collection* collection = autoGetCollection.getCollection();
         if (!collection) {
             // Collection was dropped.
-            return;
+            return 0;
         }
 
         if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collectionNSS)) {
-            return;
+            return 0;
         }
 
         const IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, name);
@@ -314,7 +409,7 @@ private:
                         "index not found (index build in progress? index dropped?), skipping ttl "
                         "job for: {idx}",
                         "idx"_attr = idx);
-            return;
+            return 0;
         }
 
         // Re-read 'idx' from the descriptor, in case the collection or index definition changed
@@ -326,7 +421,7 @@ private:
                         "special index can't be used as a ttl index, skipping ttl job for: {index}",
                         "Special index can't be used as a TTL index, skipping TTL job",
                         "index"_attr = idx);
-            return;
+            return 0;
         }
 
         BSONElement secondsExpireElt = idx[IndexDescriptor::kExpireAfterSecondsFieldName];
@@ -338,7 +433,7 @@ private:
                         "field"_attr = IndexDescriptor::kExpireAfterSecondsFieldName,
                         "type"_attr = typeName(secondsExpireElt.type()),
                         "index"_attr = idx);
-            return;
+            return 0;
         }
 
         const Date_t kDawnOfTime =
@@ -363,6 +458,25 @@ private:
         auto canonicalQuery = CanonicalQuery::canonicalize(opCtx, std::move(qr));
         invariant(canonicalQuery.getStatus());
 
+        // The oplog slots of a batch are reserved ahead of the deletes, which leaves no room for
+        // the pre-image no-op entries, so collections recording pre-images use the delete plan.
+        if (batched && !collection->getRecordPreImages()) {
+            try {
+                return deleteExpiredBatch(
+                    opCtx, collection, desc, startKey, endKey, direction, exhausted);
+            } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+                throw;
+            } catch (const DBException& exception) {
+                LOGV2_WARNING(5161000,
+                              "TTL batched delete for index {index} failed with status: {error}",
+                              "TTL batched delete failed",
+                              "index"_attr = idx,
+                              "error"_attr = redact(exception.toStatus()));
+                *exhausted = true;
+                return 0;
+            }
+        }
+
         auto params = std::make_unique<DeleteStageParams>();
         params->isMulti = true;
         params->canonicalQuery = canonicalQuery.getValue().get();
@@ -383,19 +497,83 @@ private:
         } catch (const ExceptionFor<ErrorCodes::QueryPlanKilled>&) {
             // It is expected that a collection drop can kill a query plan while the TTL monitor is
             // deleting an old document, so ignore this error.
-            return;
+            return 0;
         } catch (const DBException& exception) {
             LOGV2_WARNING(22543,
                           "ttl query execution for index {index} failed with status: {error}",
                           "TTL query execution failed",
                           "index"_attr = idx,
                           "error"_attr = redact(exception.toStatus()));
-            return;
+            return 0;
         }
 
-        const long long numDeleted = DeleteStage::getNumDeleted(*exec);
-        ttlDeletedDocuments.increment(numDeleted);
-        LOGV2_DEBUG(22536, 1, "deleted: {numDeleted}", "numDeleted"_attr = numDeleted);
+        return DeleteStage::getNumDeleted(*exec);
+    }
+
+    /**
+     * Deletes up to one batch of the documents whose key in the TTL index 'desc' lies between
+     * 'startKey' and 'endKey', bounded by ttlMonitorBatchedDeleteTargetDocs and
+     * ttlMonitorBatchedDeleteTargetBytes. The documents are found and deleted in a single
+     * WriteUnitOfWork, so they are all still expired when deleted without having to re-check them.
+     *
+     * The oplog slots of the batch are reserved together. Each delete is timestamped with its own
+     * slot and still logs its own 'd' oplog entry, so secondaries and change streams observe
+     * exactly the same operations as for unbatched deletes.
+     *
+     * Sets 'exhausted' to false if the batch was filled, meaning more expired documents may remain.
+     * Returns the number of documents deleted.
+     */
+    long long deleteExpiredBatch(OperationContext* opCtx,
+                                 Collection* collection,
+                                 const IndexDescriptor* desc,
+                                 const BSONObj& startKey,
+                                 const BSONObj& endKey,
+                                 InternalPlanner::Direction direction,
+                                 bool* exhausted) {
+        const size_t targetDocs = ttlMonitorBatchedDeleteTargetDocs.load();
+        const long long targetBytes = ttlMonitorBatchedDeleteTargetBytes.load();
+        const NamespaceString& nss = collection->ns();
+
+        return writeConflictRetry(opCtx, "ttlBatchedDelete", nss.ns(), [&]() -> long long {
+            WriteUnitOfWork wuow(opCtx);
+
+            std::vector<RecordId> batch;
+            long long batchBytes = 0;
+            *exhausted = true;
+            {
+                auto exec = InternalPlanner::indexScan(opCtx,
+                                                       collection,
+                                                       desc,
+                                                       startKey,
+                                                       endKey,
+                                                       BoundInclusion::kIncludeBothStartAndEndKeys,
+                                                       PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                                       direction,
+                                                       InternalPlanner::IXSCAN_FETCH);
+                BSONObj doc;
+                RecordId rid;
+                while (batch.size() < targetDocs && batchBytes < targetBytes) {
+                    if (exec->getNext(&doc, &rid) == PlanExecutor::IS_EOF) {
+                        break;
+                    }
+                    batch.push_back(rid);
+                    batchBytes += doc.objsize();
+                }
+                *exhausted = batch.size() < targetDocs && batchBytes < targetBytes;
+            }
+
+            if (batch.empty()) {
+                return 0;
+            }
+
+            Helpers::deleteWithReservedOplogSlots(opCtx, nss, batch.size(), [&](size_t i) {
+                collection->deleteDocument(opCtx, kUninitializedStmtId, batch[i], nullptr);
+            });
+
+            wuow.commit();
+            ttlDeletedDocumentBatches.increment();
+            return batch.size();
+        });
     }
 
     // Protects the state below.
@@ -406,6 +584,9 @@ private:
     mutable stdx::condition_variable _shuttingDownCV;
 
     bool _shuttingDown = false;
+
+    // Processes TTL indexes concurrently during a pass. Only used by the TTL monitor thread.
+    std::unique_ptr<ThreadPool> _indexWorkers;
 };
 
 void startTTLMonitor(ServiceContext* serviceContext) {
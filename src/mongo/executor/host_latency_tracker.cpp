@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/executor/host_latency_tracker.h"
+
+#include <cmath>
+
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+namespace executor {
+
+int HostLatencyTracker::bucketIndex(uint64_t latencyMillis) {
+    if (latencyMillis < uint64_t(kSubBucketCount)) {
+        return static_cast<int>(latencyMillis);
+    }
+
+    // Durations in [2^exponent, 2^(exponent + 1)) are split into kSubBucketCount buckets based on
+    // the kSubBucketBits bits following the highest set one
+    const int exponent = 63 - countLeadingZeros64(latencyMillis);
+    const int shift = exponent - kSubBucketBits;
+    const int subBucket = static_cast<int>(latencyMillis >> shift) & (kSubBucketCount - 1);
+
+    return (shift + 1) * kSubBucketCount + subBucket;
+}
+
+uint64_t HostLatencyTracker::bucketMaxValue(int index) {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+
+    const int shift = index / kSubBucketCount - 1;
+    const uint64_t subBucket = index % kSubBucketCount;
+    const uint64_t minValue = (kSubBucketCount + subBucket) << shift;
+
+    return minValue + ((uint64_t(1) << shift) - 1);
+}
+
+void HostLatencyTracker::record(const HostAndPort& host, Milliseconds latency) {
+    const int index = bucketIndex(std::max<int64_t>(durationCount<Milliseconds>(latency), 0));
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto& histogram = _histograms[host];
+
+    histogram.counts[index]++;
+    histogram.totalCount++;
+
+    if (++histogram.countSinceDecay < kDecayPeriod) {
+        return;
+    }
+
+    histogram.countSinceDecay = 0;
+    histogram.totalCount = 0;
+    for (auto& count : histogram.counts) {
+        count /= 2;
+        histogram.totalCount += count;
+    }
+}
+
+boost::optional<Milliseconds> HostLatencyTracker::getPercentile(const HostAndPort& host,
+                                                                double percentile) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    const auto it = _histograms.find(host);
+    if (it == _histograms.end() || it->second.totalCount < kMinSampleCount) {
+        return boost::none;
+    }
+
+    const auto& histogram = it->second;
+    const uint64_t rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(histogram.totalCount * percentile / 100)));
+
+    uint64_t countSoFar = 0;
+    for (int index = 0; index < kBucketCount; ++index) {
+        countSoFar += histogram.counts[index];
+        if (countSoFar >= rank) {
+            return Milliseconds(static_cast<int64_t>(bucketMaxValue(index)));
+        }
+    }
+
+    return Milliseconds(static_cast<int64_t>(bucketMaxValue(kBucketCount - 1)));
+}
+
+}  // namespace executor
+}  // namespace mongo
@@ -0,0 +1,104 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <boost/optional.hpp>
+#include <cstdint>
+
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/net/hostandport.h"
+
+namespace mongo {
+namespace executor {
+
+/**
+ * Tracks the distribution of the recent response times of each remote host, so that percentiles
+ * of it can be used to decide when and where to send additional requests.
+ *
+ * The response times of each host are counted in a histogram whose buckets grow exponentially,
+ * with every power of two split into kSubBucketCount linear buckets, so that any percentile is
+ * reported within 1/kSubBucketCount of the actual value at a fixed memory cost per host. Every
+ * kDecayPeriod responses from a host all of its counts are halved, so that its distribution
+ * follows changes in its load.
+ *
+ * This class is thread-safe.
+ */
+class HostLatencyTracker {
+public:
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int kSubBucketCount = 1 << kSubBucketBits;
+
+    // Number of buckets needed to cover all durations up to 2^63 milliseconds
+    static constexpr int kBucketCount = (64 - kSubBucketBits + 1) * kSubBucketCount;
+
+    static constexpr uint64_t kDecayPeriod = 1024;
+
+    // Minimum number of recent responses from a host needed to report percentiles for it
+    static constexpr uint64_t kMinSampleCount = 16;
+
+    /**
+     * Records that a response from the specified host took the given time.
+     */
+    void record(const HostAndPort& host, Milliseconds latency);
+
+    /**
+     * Returns the response time, which the specified percentage of the recent responses from the
+     * host did not exceed, or boost::none if too few responses from it have been recorded.
+     */
+    boost::optional<Milliseconds> getPercentile(const HostAndPort& host, double percentile) const;
+
+    /**
+     * Returns the bucket, which counts responses of the given duration in milliseconds, and the
+     * largest duration counted by a bucket. Exposed for testing.
+     */
+    static int bucketIndex(uint64_t latencyMillis);
+    static uint64_t bucketMaxValue(int index);
+
+private:
+    struct Histogram {
+        std::array<uint64_t, kBucketCount> counts{};
+
+        // Sum of the counts above
+        uint64_t totalCount{0};
+
+        // Number of responses recorded since the counts were last halved
+        uint64_t countSinceDecay{0};
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("HostLatencyTracker::_mutex");
+
+    stdx::unordered_map<HostAndPort, Histogram> _histograms;
+};
+
+}  // namespace executor
+}  // namespace mongo
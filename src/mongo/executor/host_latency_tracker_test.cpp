@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/executor/host_latency_tracker.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace executor {
+namespace {
+
+const HostAndPort kHost0("host0", 27017);
+const HostAndPort kHost1("host1", 27017);
+
+TEST(HostLatencyTrackerTest, BucketsCoverEveryDuration) {
+    uint64_t previousMaxValue = 0;
+    for (int index = 0; index < HostLatencyTracker::kBucketCount; ++index) {
+        const uint64_t maxValue = HostLatencyTracker::bucketMaxValue(index);
+        if (index > 0) {
+            // Every duration maps to exactly one bucket
+            ASSERT_EQ(index, HostLatencyTracker::bucketIndex(previousMaxValue + 1));
+        }
+        ASSERT_EQ(index, HostLatencyTracker::bucketIndex(maxValue));
+        previousMaxValue = maxValue;
+    }
+}
+
+TEST(HostLatencyTrackerTest, BucketsAreWithinRelativeError) {
+    for (uint64_t latency : {0, 1, 7, 8, 9, 15, 16, 100, 1000, 12345, 1000000}) {
+        const uint64_t maxValue =
+            HostLatencyTracker::bucketMaxValue(HostLatencyTracker::bucketIndex(latency));
+        ASSERT_GTE(maxValue, latency);
+        ASSERT_LTE(maxValue - latency, latency / HostLatencyTracker::kSubBucketCount);
+    }
+}
+
+TEST(HostLatencyTrackerTest, NoPercentilesWithTooFewSamples) {
+    HostLatencyTracker tracker;
+    ASSERT(!tracker.getPercentile(kHost0, 50));
+
+    for (uint64_t i = 0; i + 1 < HostLatencyTracker::kMinSampleCount; ++i) {
+        tracker.record(kHost0, Milliseconds(1));
+    }
+    ASSERT(!tracker.getPercentile(kHost0, 50));
+
+    tracker.record(kHost0, Milliseconds(1));
+    ASSERT(tracker.getPercentile(kHost0, 50) == Milliseconds(1));
+}
+
+TEST(HostLatencyTrackerTest, PercentilesArePerHost) {
+    HostLatencyTracker tracker;
+
+    // host0 responds in 1..100ms, host1 always takes 7ms
+    for (int latency = 1; latency <= 100; ++latency) {
+        tracker.record(kHost0, Milliseconds(latency));
+        tracker.record(kHost1, Milliseconds(7));
+    }
+
+    ASSERT_EQ(Milliseconds(7), *tracker.getPercentile(kHost1, 50));
+    ASSERT_EQ(Milliseconds(7), *tracker.getPercentile(kHost1, 99));
+
+    const auto median = *tracker.getPercentile(kHost0, 50);
+    ASSERT_GTE(median, Milliseconds(50));
+    ASSERT_LTE(median, Milliseconds(50 + 50 / HostLatencyTracker::kSubBucketCount));
+
+    const auto p95 = *tracker.getPercentile(kHost0, 95);
+    ASSERT_GTE(p95, Milliseconds(95));
+    ASSERT_LTE(p95, Milliseconds(95 + 95 / HostLatencyTracker::kSubBucketCount));
+}
+
+TEST(HostLatencyTrackerTest, OldSamplesDecay) {
+    HostLatencyTracker tracker;
+
+    for (uint64_t i = 0; i < HostLatencyTracker::kDecayPeriod; ++i) {
+        tracker.record(kHost0, Milliseconds(100));
+    }
+    ASSERT_EQ(Milliseconds(103), *tracker.getPercentile(kHost0, 50));
+
+    // Once the host speeds up, its older response times stop mattering after a few decay periods
+    for (uint64_t i = 0; i < 3 * HostLatencyTracker::kDecayPeriod; ++i) {
+        tracker.record(kHost0, Milliseconds(2));
+    }
+    ASSERT_EQ(Milliseconds(2), *tracker.getPercentile(kHost0, 90));
+}
+
+}  // namespace
+}  // namespace executor
+}  // namespace mongo
@@ -666,8 +666,46 @@ void NetworkInterfaceTL::RequestManager::killOperationsForPendingRequests() {
     }
 }
 
-void NetworkInterfaceTL::RequestManager::trySend(
-    StatusWith<ConnectionPool::ConnectionHandle> swConn, size_t idx) noexcept {
+boost::optional<Milliseconds> NetworkInterfaceTL::RequestManager::getHedgeDelay(WithLock,
+                                                                               size_t idx) {
+    auto firstRequestState = requests.front().lock();
+    if (!firstRequestState) {
+        return Milliseconds(0);
+    }
+
+    const auto& tracker = cmdState->interface->_hostLatencyTracker;
+    const auto& firstTarget = firstRequestState->host;
+    const auto& target = cmdState->requestOnAny.target[idx];
+
+    // Until enough responses from the first target have been seen to know how long it usually
+    // takes, hedge right away
+    const auto firstTargetLatency =
+        tracker.getPercentile(firstTarget, cmdState->requestOnAny.hedgeOptions->delayPercentile);
+    if (!firstTargetLatency) {
+        return Milliseconds(0);
+    }
+
+    // A target, whose typical response is slower than the first target's slow responses, is
+    // overloaded and the hedged request would only add to its load
+    const auto targetMedianLatency = tracker.getPercentile(target, 50);
+    if (targetMedianLatency && *targetMedianLatency >= *firstTargetLatency) {
+        LOGV2_DEBUG(5180000,
+                    2,
+                    "Not sending hedged request to overloaded target",
+                    "requestId"_attr = cmdState->requestOnAny.id,
+                    "target"_attr = target,
+                    "targetMedianLatency"_attr = *targetMedianLatency,
+                    "firstTarget"_attr = firstTarget,
+                    "firstTargetLatency"_attr = *firstTargetLatency);
+        return boost::none;
+    }
+
+    return *firstTargetLatency - firstRequestState->stopwatch.elapsed();
+}
+
+void NetworkInterfaceTL::RequestManager::trySend(StatusWith<ConnectionPool::ConnectionHandle> swConn,
+                                                 size_t idx,
+                                                 bool afterHedgeDelay) noexcept {
     // Our connection wasn't any good
     if (!swConn.isOK()) {
         {
@@ -706,34 +744,79 @@ void NetworkInterfaceTL::RequestManager::trySend(
     }
 
     std::shared_ptr<RequestState> requestState;
+    Milliseconds hedgeDelay{0};
 
     {
         stdx::lock_guard<Latch> lk(mutex);
 
         // Increment the number of conns we were able to resolve.
-        ++connsResolved;
+        if (!afterHedgeDelay) {
+            ++connsResolved;
+        }
 
         auto haveSentAll = sentIdx >= cmdState->maxConcurrentRequests();
-        if (haveSentAll || isLocked) {
+        if (haveSentAll || isLocked || (afterHedgeDelay && cmdState->finishLine.isReady())) {
             // Our command has already been satisfied or we have already sent out all
             // the requests.
             swConn.getValue()->indicateSuccess();
             return;
         }
 
-        auto currentSentIdx = sentIdx++;
+        const auto& hedgeOptions = cmdState->requestOnAny.hedgeOptions;
+        if (sentIdx > 0 && !afterHedgeDelay && hedgeOptions && hedgeOptions->delayPercentile) {
+            auto delay = getHedgeDelay(lk, idx);
+            if (!delay) {
+                // The target is too loaded for the hedged request to be of any use.
+                swConn.getValue()->indicateSuccess();
+                return;
+            }
+            hedgeDelay = *delay;
+        }
+
+        if (hedgeDelay <= Milliseconds(0)) {
+            auto currentSentIdx = sentIdx++;
 
-        requestState = std::make_shared<RequestState>(this, cmdState->shared_from_this(), idx);
-        requestState->isHedge = currentSentIdx > 0;
+            requestState = std::make_shared<RequestState>(this, cmdState->shared_from_this(), idx);
+            requestState->isHedge = currentSentIdx > 0;
 
-        // Set conn/weakConn+request under the lock so they will always be observed during cancel.
-        requestState->conn = std::move(swConn.getValue());
-        requestState->weakConn = requestState->conn;
+            // Set conn/weakConn+request under the lock so they will always be observed during
+            // cancel.
+            requestState->conn = std::move(swConn.getValue());
+            requestState->weakConn = requestState->conn;
 
-        requestState->request = RemoteCommandRequest(cmdState->requestOnAny, idx);
-        requestState->host = requestState->request->target;
+            requestState->request = RemoteCommandRequest(cmdState->requestOnAny, idx);
+            requestState->host = requestState->request->target;
 
-        requests.at(currentSentIdx) = requestState;
+            requests.at(currentSentIdx) = requestState;
+        }
+    }
+
+    if (!requestState) {
+        // Hold on to the connection until the first request has been outstanding for long enough
+        // and try again then.
+        LOGV2_DEBUG(5180001,
+                    2,
+                    "Delaying hedged request",
+                    "requestId"_attr = cmdState->requestOnAny.id,
+                    "target"_attr = cmdState->requestOnAny.target[idx],
+                    "delay"_attr = hedgeDelay);
+
+        std::shared_ptr<transport::ReactorTimer> hedgeTimer =
+            cmdState->interface->_reactor->makeTimer();
+        hedgeTimer->waitUntil(cmdState->interface->now() + hedgeDelay, cmdState->baton)
+            .getAsync([this,
+                       anchor = cmdState->shared_from_this(),
+                       hedgeTimer,
+                       conn = std::move(swConn.getValue()),
+                       idx](Status status) mutable {
+                if (!status.isOK()) {
+                    conn->indicateSuccess();
+                    return;
+                }
+
+                trySend(std::move(conn), idx, true);
+            });
+        return;
     }
 
     LOGV2_DEBUG(4646300,
@@ -808,6 +891,16 @@ void NetworkInterfaceTL::RequestState::resolve(Future<RemoteCommandResponse> fut
             returnConnection(status);
 
             auto commandStatus = getStatusFromCommandResult(response.data);
+
+            // Only successful hedgeable reads, sent while hedged reads are delayed, feed the
+            // latency tracker. Other commands, such as awaitData getMores, and hedges cut short by
+            // maxTimeMS would skew the response times of their targets.
+            const auto& hedgeOptions = cmdState->requestOnAny.hedgeOptions;
+            if (hedgeOptions && hedgeOptions->delayPercentile > 0 && status.isOK() &&
+                commandStatus.isOK()) {
+                interface()->_hostLatencyTracker.record(host, stopwatch.elapsed());
+            }
+
             // Ignore maxTimeMS expiration errors for hedged reads without triggering the finish
             // line.
             if (isHedge && commandStatus == ErrorCodes::MaxTimeMSExpired) {
@@ -34,6 +34,7 @@
 #include "mongo/client/async_client.h"
 #include "mongo/db/service_context.h"
 #include "mongo/executor/connection_pool.h"
+#include "mongo/executor/host_latency_tracker.h"
 #include "mongo/executor/network_interface.h"
 #include "mongo/logv2/log_severity.h"
 #include "mongo/platform/mutex.h"
@@ -42,6 +43,7 @@
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/transport_layer.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/strong_weak_finish_line.h"
 
@@ -232,10 +234,28 @@ private:
     struct RequestManager {
         RequestManager(CommandStateBase* cmdState);
 
-        void trySend(StatusWith<ConnectionPool::ConnectionHandle> swConn, size_t idx) noexcept;
+        /**
+         * Sends the request to the target at the given index over the acquired connection, unless
+         * the command has already been satisfied or all of its requests have been sent.
+         *
+         * If the command asks for the additional requests to be delayed, a request other than the
+         * first one is only sent once the first one has been outstanding for longer than the
+         * requested percentile of the recent response times of its target, at which point trySend
+         * is called again with 'afterHedgeDelay' set.
+         */
+        void trySend(StatusWith<ConnectionPool::ConnectionHandle> swConn,
+                     size_t idx,
+                     bool afterHedgeDelay = false) noexcept;
         void cancelRequests();
         void killOperationsForPendingRequests();
 
+        /**
+         * Returns how much longer to wait before sending a hedged request to the target at the
+         * given index, based on the recent response times of the target of the first request, or
+         * boost::none if the hedged request should not be sent because the target is overloaded.
+         */
+        boost::optional<Milliseconds> getHedgeDelay(WithLock, size_t idx);
+
         CommandStateBase* cmdState;
         std::vector<std::weak_ptr<RequestState>> requests;
 
@@ -351,6 +371,10 @@ private:
 
     std::unique_ptr<rpc::EgressMetadataHook> _metadataHook;
 
+    // Recent response times of each remote host to hedgeable reads, used to delay and suppress
+    // hedged requests. Only recorded while hedgedReadsDelayPercentile is set.
+    HostLatencyTracker _hostLatencyTracker;
+
     // We start in kDefault, transition to kStarted after startup() is complete and enter kStopped
     // at the first call to shutdown()
     enum State : int {
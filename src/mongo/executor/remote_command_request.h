@@ -46,6 +46,11 @@ struct RemoteCommandRequestBase {
     struct HedgeOptions {
         size_t count = 0;
         int maxTimeMSForHedgedReads = 0;
+
+        // If non-zero, the additional requests are only sent once the first one has been
+        // outstanding for longer than this percentile of the recent response times of its target,
+        // and are not sent to targets which are not expected to respond any sooner.
+        int delayPercentile = 0;
     };
 
     enum FireAndForgetMode { kOn, kOff };
@@ -33,6 +33,8 @@
 
 #include "mongo/s/chunk_manager.h"
 
+#include <numeric>
+
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
@@ -114,187 +116,397 @@ std::vector<std::shared_ptr<ChunkInfo>> flatten(const std::vector<ChunkType>& ch
     return flattened;
 }
 
+
+// Checks that there is neither a gap nor an overlap between the consecutive chunks 'prev' and
+// 'next'. Only chunks on different shards are checked, since only their boundaries determine the
+// shard versions.
+void checkContinuity(const ChunkInfo& prev, const ChunkInfo& next) {
+    if (prev.getShardIdAt(boost::none) == next.getShardIdAt(boost::none) ||
+        SimpleBSONObjComparator::kInstance.evaluate(prev.getMax() == next.getMin())) {
+        return;
+    }
+
+    if (SimpleBSONObjComparator::kInstance.evaluate(prev.getMax() < next.getMin()))
+        uasserted(ErrorCodes::ConflictingOperationInProgress,
+                  str::stream() << "Gap exists in the routing table between chunks "
+                                << prev.getRange().toString() << " and "
+                                << next.getRange().toString());
+    else
+        uasserted(ErrorCodes::ConflictingOperationInProgress,
+                  str::stream() << "Overlap exists in the routing table between chunks "
+                                << prev.getRange().toString() << " and "
+                                << next.getRange().toString());
+}
+
+// Returns whether 'chunk' overlaps the range from the min of the first chunk of 'chunks' to the max
+// of the last one.
+bool overlapsChunks(const ChunkInfo& chunk, const std::vector<std::shared_ptr<ChunkInfo>>& chunks) {
+    return chunk.getMin().woCompare(chunks.back()->getMax()) < 0 &&
+        chunk.getMax().woCompare(chunks.front()->getMin()) > 0;
+}
+
+void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion& version) {
+    uassert(ErrorCodes::ConflictingOperationInProgress,
+            str::stream() << "Changed chunk " << chunk->toString()
+                          << " has epoch different from that of the collection " << version.epoch(),
+            version.epoch() == chunk->getLastmod().epoch());
+
+    invariant(chunk->getLastmod() >= version);
+}
+
 }  // namespace
 
-ShardVersionMap ChunkMap::constructShardVersionMap() const {
-    ShardVersionMap shardVersions;
-    ChunkVector::const_iterator current = _chunkMap.cbegin();
+ChunkMap::ChunkBlock::ChunkBlock(ChunkVector blockChunks) : chunks(std::move(blockChunks)) {
+    invariant(!chunks.empty());
 
-    boost::optional<BSONObj> firstMin = boost::none;
-    boost::optional<BSONObj> lastMax = boost::none;
+    maxVersion = chunks.front()->getLastmod();
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const auto& chunk = chunks[i];
+        if (i > 0) {
+            checkContinuity(*chunks[i - 1], *chunk);
+        }
 
-    while (current != _chunkMap.cend()) {
-        const auto& firstChunkInRange = *current;
-        const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
+        maxVersion = std::max(maxVersion, chunk->getLastmod());
+
+        const auto& shardId = chunk->getShardIdAt(boost::none);
+        auto it = std::find_if(
+            shardVersions.begin(), shardVersions.end(), [&](const auto& shardVersion) {
+                return shardVersion.first == shardId;
+            });
+        if (it == shardVersions.end()) {
+            shardVersions.emplace_back(shardId, chunk->getLastmod());
+        } else if (chunk->getLastmod() > it->second) {
+            it->second = chunk->getLastmod();
+        }
+    }
+}
 
-        // Tracks the max shard version for the shard on which the current range will reside
-        auto shardVersionIt = shardVersions.find(currentRangeShardId);
-        if (shardVersionIt == shardVersions.end()) {
-            shardVersionIt =
-                shardVersions.emplace(currentRangeShardId, _collectionVersion.epoch()).first;
+/**
+ * Accumulates the chunks of a new ChunkMap in order. Consecutive chunks are collected into new
+ * blocks, unless a whole block of another map can be reused.
+ */
+class ChunkMap::Builder {
+public:
+    explicit Builder(OID epoch) : _chunkMap(epoch) {}
+
+    /**
+     * Appends 'chunk' after the chunks appended so far. If it overlaps the last of them, it
+     * replaces that chunk if it is newer and is dropped otherwise.
+     */
+    void appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
+        if (_pendingChunks.empty() && !_chunkMap._chunkBlocks.empty() &&
+            chunk->getRange().overlaps(_chunkMap._chunkBlocks.back()->chunks.back()->getRange())) {
+            // The last chunk may have to be replaced, so take the block it is in apart again.
+            _pendingChunks = _chunkMap._chunkBlocks.back()->chunks;
+            _chunkMap._size -= _pendingChunks.size();
+            _chunkMap._chunkBlocks.pop_back();
         }
 
-        auto& maxShardVersion = shardVersionIt->second.shardVersion;
-
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId, &maxShardVersion](const auto& currentChunk) {
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
-
-                             if (currentChunk->getLastmod() > maxShardVersion)
-                                 maxShardVersion = currentChunk->getLastmod();
-
-                             return false;
-                         });
-
-        const auto rangeLast = *std::prev(current);
-
-        const auto& rangeMin = firstChunkInRange->getMin();
-        const auto& rangeMax = rangeLast->getMax();
-
-        // Check the continuity of the chunks map
-        if (lastMax && !SimpleBSONObjComparator::kInstance.evaluate(*lastMax == rangeMin)) {
-            if (SimpleBSONObjComparator::kInstance.evaluate(*lastMax < rangeMin))
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Gap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
-            else
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Overlap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
+        appendChunkTo(_pendingChunks, chunk);
+        _chunkMap._collectionVersion = std::max(_chunkMap._collectionVersion, chunk->getLastmod());
+
+        if (_pendingChunks.size() > kMaxChunksPerBlock) {
+            // Keep the last chunk pending, because the next chunk may still replace it.
+            auto lastChunk = std::move(_pendingChunks.back());
+            _pendingChunks.pop_back();
+            _flushPendingChunks();
+            _pendingChunks.push_back(std::move(lastChunk));
         }
+    }
 
-        if (!firstMin)
-            firstMin = rangeMin;
+    /**
+     * Returns whether the chunks of 'block' can be appended as a whole, which is the case if its
+     * first chunk does not overlap the last chunk appended so far.
+     */
+    bool canAppendBlock(const ChunkBlock& block) const {
+        const auto& firstChunk = block.chunks.front();
+        if (!_pendingChunks.empty()) {
+            return !firstChunk->getRange().overlaps(_pendingChunks.back()->getRange());
+        }
+        return _chunkMap._chunkBlocks.empty() ||
+            !firstChunk->getRange().overlaps(
+                _chunkMap._chunkBlocks.back()->chunks.back()->getRange());
+    }
 
-        lastMax = rangeMax;
+    /**
+     * Appends all the chunks of 'block', which must satisfy canAppendBlock(). The block is shared
+     * rather than copied, unless the chunks appended before it are too few to make a block of
+     * their own, in which case they are combined with the chunks of 'block'.
+     */
+    void appendBlock(const std::shared_ptr<const ChunkBlock>& block) {
+        _chunkMap._collectionVersion = std::max(_chunkMap._collectionVersion, block->maxVersion);
+
+        if (_pendingChunks.empty() || _pendingChunks.size() >= kMinChunksPerBlock) {
+            _flushPendingChunks();
+            _chunkMap._chunkBlocks.push_back(block);
+            _chunkMap._size += block->chunks.size();
+            return;
+        }
 
-        // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
-        // somewhere, which should have been caught at chunk load time
-        invariant(maxShardVersion.isSet());
+        _pendingChunks.insert(_pendingChunks.end(), block->chunks.begin(), block->chunks.end());
+        if (_pendingChunks.size() > kMaxChunksPerBlock) {
+            // Split the combined chunks evenly, so that neither half is too small for a block.
+            ChunkVector secondHalf(_pendingChunks.begin() + _pendingChunks.size() / 2,
+                                   _pendingChunks.end());
+            _pendingChunks.resize(_pendingChunks.size() / 2);
+            _flushPendingChunks();
+            _pendingChunks = std::move(secondHalf);
+        }
     }
 
-    if (!_chunkMap.empty()) {
-        invariant(!shardVersions.empty());
-        invariant(firstMin.is_initialized());
-        invariant(lastMax.is_initialized());
+    ChunkMap done() {
+        _flushPendingChunks();
+        return std::move(_chunkMap);
+    }
 
-        checkAllElementsAreOfType(MinKey, firstMin.get());
-        checkAllElementsAreOfType(MaxKey, lastMax.get());
+private:
+    void _flushPendingChunks() {
+        if (_pendingChunks.empty()) {
+            return;
+        }
+        _chunkMap._size += _pendingChunks.size();
+        _chunkMap._chunkBlocks.push_back(std::make_shared<ChunkBlock>(std::move(_pendingChunks)));
+        _pendingChunks.clear();
     }
 
-    return shardVersions;
-}
+    ChunkMap _chunkMap;
+
+    // Chunks appended after the last block of '_chunkMap', ordered by max key
+    ChunkVector _pendingChunks;
+};
+
+ShardVersionMap ChunkMap::constructShardVersionMap() const {
+    ShardVersionMap shardVersions;
 
-void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
-    appendChunkTo(_chunkMap, chunk);
+    for (size_t i = 0; i < _chunkBlocks.size(); ++i) {
+        const auto& block = _chunkBlocks[i];
 
-    _collectionVersion = std::max(_collectionVersion, chunk->getLastmod());
+        // The continuity of the chunks within each block is checked when the block is created.
+        if (i > 0) {
+            checkContinuity(*_chunkBlocks[i - 1]->chunks.back(), *block->chunks.front());
+        }
+
+        // Tracks the max shard version for each shard on which the block has chunks
+        for (const auto& blockShardVersion : block->shardVersions) {
+            auto shardVersionIt = shardVersions.find(blockShardVersion.first);
+            if (shardVersionIt == shardVersions.end()) {
+                shardVersionIt =
+                    shardVersions.emplace(blockShardVersion.first, _collectionVersion.epoch())
+                        .first;
+            }
+
+            auto& maxShardVersion = shardVersionIt->second.shardVersion;
+            if (blockShardVersion.second > maxShardVersion)
+                maxShardVersion = blockShardVersion.second;
+
+            // If a shard has chunks it must have a shard version, otherwise we have an invalid
+            // chunk somewhere, which should have been caught at chunk load time
+            invariant(maxShardVersion.isSet());
+        }
+    }
+
+    if (!_chunkBlocks.empty()) {
+        invariant(!shardVersions.empty());
+
+        checkAllElementsAreOfType(MinKey, _chunkBlocks.front()->chunks.front()->getMin());
+        checkAllElementsAreOfType(MaxKey, _chunkBlocks.back()->chunks.back()->getMax());
+    }
+
+    return shardVersions;
 }
 
 std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
-    const auto it = _findIntersectingChunk(shardKey);
+    const auto position = _findIntersectingChunk(shardKey);
 
-    if (it != _chunkMap.end())
-        return *it;
+    if (position.block < _chunkBlocks.size())
+        return _chunkBlocks[position.block]->chunks[position.chunk];
 
     return std::shared_ptr<ChunkInfo>();
 }
 
-void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion& version) {
-    uassert(ErrorCodes::ConflictingOperationInProgress,
-            str::stream() << "Changed chunk " << chunk->toString()
-                          << " has epoch different from that of the collection " << version.epoch(),
-            version.epoch() == chunk->getLastmod().epoch());
+std::vector<std::shared_ptr<ChunkInfo>> ChunkMap::findIntersectingChunks(
+    const std::vector<BSONObj>& shardKeys) const {
+    std::vector<std::string> shardKeyStrings;
+    shardKeyStrings.reserve(shardKeys.size());
+    for (const auto& shardKey : shardKeys) {
+        shardKeyStrings.push_back(ShardKeyPattern::toKeyString(shardKey));
+    }
 
-    invariant(chunk->getLastmod() >= version);
+    // Bulk writes frequently come with ascending shard keys already, so only sort when necessary.
+    std::vector<size_t> order(shardKeys.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (!std::is_sorted(shardKeyStrings.begin(), shardKeyStrings.end())) {
+        std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+            return shardKeyStrings[lhs] < shardKeyStrings[rhs];
+        });
+    }
+
+    std::vector<std::shared_ptr<ChunkInfo>> chunks(shardKeys.size());
+    ChunkPosition position{0, 0};
+    for (auto index : order) {
+        position = _findIntersectingChunkFrom(position, shardKeyStrings[index]);
+        if (position.block >= _chunkBlocks.size()) {
+            break;
+        }
+        chunks[index] = _chunkBlocks[position.block]->chunks[position.chunk];
+    }
+
+    return chunks;
 }
 
 ChunkMap ChunkMap::createMerged(const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) {
-    size_t chunkMapIndex = 0;
+    size_t blockIndex = 0;
+    size_t chunkIndex = 0;
     size_t changedChunkIndex = 0;
 
-    ChunkMap updatedChunkMap(getVersion().epoch(), _chunkMap.size() + changedChunks.size());
+    Builder builder(getVersion().epoch());
 
-    while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
-        if (chunkMapIndex >= _chunkMap.size()) {
+    while (blockIndex < _chunkBlocks.size() || changedChunkIndex < changedChunks.size()) {
+        if (blockIndex >= _chunkBlocks.size()) {
             validateChunk(changedChunks[changedChunkIndex], getVersion());
-            updatedChunkMap.appendChunk(changedChunks[changedChunkIndex++]);
+            builder.appendChunk(changedChunks[changedChunkIndex++]);
+            continue;
+        }
+
+        const auto& block = _chunkBlocks[blockIndex];
+
+        // A block which is not affected by any of the remaining changed chunks is reused as is.
+        if (chunkIndex == 0 && builder.canAppendBlock(*block) &&
+            (changedChunkIndex >= changedChunks.size() ||
+             !overlapsChunks(*changedChunks[changedChunkIndex], block->chunks))) {
+            builder.appendBlock(block);
+            ++blockIndex;
             continue;
         }
 
+        auto& chunkInfo = block->chunks[chunkIndex];
+        const auto nextChunk = [&] {
+            if (++chunkIndex == block->chunks.size()) {
+                ++blockIndex;
+                chunkIndex = 0;
+            }
+        };
+
         if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            builder.appendChunk(chunkInfo);
+            nextChunk();
             continue;
         }
 
-        auto overlap = _chunkMap[chunkMapIndex]->getRange().overlaps(
-            changedChunks[changedChunkIndex]->getRange());
+        auto overlap = chunkInfo->getRange().overlaps(changedChunks[changedChunkIndex]->getRange());
 
         if (overlap) {
             auto& changedChunk = changedChunks[changedChunkIndex++];
-            auto& chunkInfo = _chunkMap[chunkMapIndex];
 
             auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
             changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
 
             validateChunk(changedChunk, getVersion());
-            updatedChunkMap.appendChunk(changedChunk);
+            builder.appendChunk(changedChunk);
         } else {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            builder.appendChunk(chunkInfo);
+            nextChunk();
         }
     }
 
-    return updatedChunkMap;
+    return builder.done();
 }
 
 BSONObj ChunkMap::toBSON() const {
     BSONObjBuilder builder;
 
     builder.append("startingVersion"_sd, getVersion().toBSON());
-    builder.append("chunkCount", static_cast<int64_t>(_chunkMap.size()));
+    builder.append("chunkCount", static_cast<int64_t>(_size));
 
     {
         BSONArrayBuilder arrayBuilder(builder.subarrayStart("chunks"_sd));
-        for (const auto& chunk : _chunkMap) {
+        forEach([&arrayBuilder](const auto& chunk) {
             arrayBuilder.append(chunk->toString());
-        }
+            return true;
+        });
     }
 
     return builder.obj();
 }
 
-ChunkMap::ChunkVector::const_iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
-                                                                       bool isMaxInclusive) const {
+ChunkMap::ChunkPosition ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
+                                                         bool isMaxInclusive) const {
     auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
 
+    // Find the first block whose last chunk ends after the key, and then the chunk within it.
+    auto findInBlocks = [&](auto&& chunkEndsAfterKey) -> ChunkPosition {
+        auto blockIt = std::partition_point(
+            _chunkBlocks.begin(), _chunkBlocks.end(), [&](const auto& block) {
+                return !chunkEndsAfterKey(block->getMaxKeyString());
+            });
+        if (blockIt == _chunkBlocks.end()) {
+            return _end();
+        }
+
+        const auto& chunks = (*blockIt)->chunks;
+        auto chunkIt = std::partition_point(chunks.begin(), chunks.end(), [&](const auto& chunk) {
+            return !chunkEndsAfterKey(chunk->getMaxKeyString());
+        });
+        invariant(chunkIt != chunks.end());
+        return {static_cast<size_t>(blockIt - _chunkBlocks.begin()),
+                static_cast<size_t>(chunkIt - chunks.begin())};
+    };
+
     if (!isMaxInclusive) {
-        return std::lower_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const auto& chunkInfo, const BSONObj& shardKey) {
-                                    return chunkInfo->getMaxKeyString() < shardKeyString;
-                                });
+        return findInBlocks(
+            [&shardKeyString](const std::string& maxKeyString) {
+                return !(maxKeyString < shardKeyString);
+            });
     } else {
-        return std::upper_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const BSONObj& shardKey, const auto& chunkInfo) {
-                                    return shardKeyString < chunkInfo->getMaxKeyString();
-                                });
+        return findInBlocks(
+            [&shardKeyString](const std::string& maxKeyString) {
+                return shardKeyString < maxKeyString;
+            });
+    }
+}
+
+ChunkMap::ChunkPosition ChunkMap::_findIntersectingChunkFrom(
+    ChunkPosition from, const std::string& shardKeyString) const {
+    auto chunkEndsAfterKey = [&shardKeyString](const auto& chunkOrBlock) {
+        return shardKeyString < chunkOrBlock->getMaxKeyString();
+    };
+
+    auto blockIt = _chunkBlocks.begin() + std::min(from.block, _chunkBlocks.size());
+    auto chunkIndex = from.chunk;
+    if (blockIt != _chunkBlocks.end() && !chunkEndsAfterKey(*blockIt)) {
+        blockIt = std::partition_point(
+            std::next(blockIt), _chunkBlocks.end(), [&](const auto& block) {
+                return !chunkEndsAfterKey(block);
+            });
+        chunkIndex = 0;
+    }
+    if (blockIt == _chunkBlocks.end()) {
+        return _end();
+    }
+
+    const auto& chunks = (*blockIt)->chunks;
+    if (!chunkEndsAfterKey(chunks[chunkIndex])) {
+        chunkIndex = std::partition_point(chunks.begin() + chunkIndex + 1,
+                                          chunks.end(),
+                                          [&](const auto& chunk) {
+                                              return !chunkEndsAfterKey(chunk);
+                                          }) -
+            chunks.begin();
     }
+    return {static_cast<size_t>(blockIt - _chunkBlocks.begin()), chunkIndex};
 }
 
-std::pair<ChunkMap::ChunkVector::const_iterator, ChunkMap::ChunkVector::const_iterator>
-ChunkMap::_overlappingBounds(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+std::pair<ChunkMap::ChunkPosition, ChunkMap::ChunkPosition> ChunkMap::_overlappingBounds(
+    const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
     const auto itMin = _findIntersectingChunk(min);
     const auto itMax = [&]() {
         auto it = _findIntersectingChunk(max, isMaxInclusive);
-        return it == _chunkMap.end() ? it : ++it;
+        if (it.block < _chunkBlocks.size() &&
+            ++it.chunk == _chunkBlocks[it.block]->chunks.size()) {
+            ++it.block;
+            it.chunk = 0;
+        }
+        return it;
     }();
 
     return {itMin, itMax};
@@ -357,6 +569,23 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj
     return Chunk(*chunkInfo, _clusterTime);
 }
 
+std::vector<boost::optional<Chunk>> ChunkManager::findIntersectingChunksWithSimpleCollation(
+    const std::vector<BSONObj>& shardKeys) const {
+    auto chunkInfos = _rt->findIntersectingChunks(shardKeys);
+
+    std::vector<boost::optional<Chunk>> chunks;
+    chunks.reserve(chunkInfos.size());
+    for (size_t i = 0; i < chunkInfos.size(); ++i) {
+        if (chunkInfos[i] && chunkInfos[i]->containsKey(shardKeys[i])) {
+            chunks.emplace_back(Chunk(*chunkInfos[i], _clusterTime));
+        } else {
+            chunks.emplace_back(boost::none);
+        }
+    }
+
+    return chunks;
+}
+
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
@@ -67,17 +67,51 @@ using ShardVersionMap = stdx::unordered_map<ShardId, ShardVersionTargetingInfo,
 // This class serves as a Facade around how the mapping of ranges to chunks is represented. It also
 // provides a simpler, high-level interface for domain specific operations without exposing the
 // underlying implementation.
+//
+// The chunks are ordered by max key and stored in immutable blocks of consecutive chunks. A map
+// created by createMerged() shares all the blocks which the changed chunks do not touch with the
+// map it was created from, so an incremental refresh costs time proportional to the number of
+// blocks plus the number of chunks in the blocks which changed, rather than to the number of
+// chunks.
 class ChunkMap {
     // Vector of chunks ordered by max key.
     using ChunkVector = std::vector<std::shared_ptr<ChunkInfo>>;
 
+    // Immutable run of consecutive chunks, which is never empty.
+    struct ChunkBlock {
+        explicit ChunkBlock(ChunkVector blockChunks);
+
+        const std::string& getMaxKeyString() const {
+            return chunks.back()->getMaxKeyString();
+        }
+
+        const ChunkVector chunks;
+
+        // Max version across the chunks in this block
+        ChunkVersion maxVersion;
+
+        // Max version of the chunks in this block on each of the shards which own any of them
+        std::vector<std::pair<ShardId, ChunkVersion>> shardVersions;
+    };
+
+    using ChunkBlockVector = std::vector<std::shared_ptr<const ChunkBlock>>;
+
+    // Position of a chunk in the map. The position past the last chunk is {_chunkBlocks.size(), 0}.
+    struct ChunkPosition {
+        size_t block;
+        size_t chunk;
+    };
+
 public:
-    explicit ChunkMap(OID epoch, size_t initialCapacity = 0) : _collectionVersion(0, 0, epoch) {
-        _chunkMap.reserve(initialCapacity);
-    }
+    // New blocks hold at most kMaxChunksPerBlock chunks. Fewer than kMinChunksPerBlock new chunks
+    // are combined with the chunks of the following block rather than sharing that block.
+    static constexpr size_t kMaxChunksPerBlock = 256;
+    static constexpr size_t kMinChunksPerBlock = kMaxChunksPerBlock / 2;
+
+    explicit ChunkMap(OID epoch) : _collectionVersion(0, 0, epoch) {}
 
     size_t size() const {
-        return _chunkMap.size();
+        return _size;
     }
 
     ChunkVersion getVersion() const {
@@ -86,12 +120,9 @@ public:
 
     template <typename Callable>
     void forEach(Callable&& handler, const BSONObj& shardKey = BSONObj()) const {
-        auto it = shardKey.isEmpty() ? _chunkMap.begin() : _findIntersectingChunk(shardKey);
-
-        for (; it != _chunkMap.end(); ++it) {
-            if (!handler(*it))
-                break;
-        }
+        const auto first =
+            shardKey.isEmpty() ? ChunkPosition{0, 0} : _findIntersectingChunk(shardKey);
+        _forEachInRange(first, _end(), std::forward<Callable>(handler));
     }
 
     template <typename Callable>
@@ -100,28 +131,64 @@ public:
                                  bool isMaxInclusive,
                                  Callable&& handler) const {
         const auto bounds = _overlappingBounds(min, max, isMaxInclusive);
-
-        for (auto it = bounds.first; it != bounds.second; ++it) {
-            if (!handler(*it))
-                break;
-        }
+        _forEachInRange(bounds.first, bounds.second, std::forward<Callable>(handler));
     }
 
     ShardVersionMap constructShardVersionMap() const;
     std::shared_ptr<ChunkInfo> findIntersectingChunk(const BSONObj& shardKey) const;
 
-    void appendChunk(const std::shared_ptr<ChunkInfo>& chunk);
+    /**
+     * Returns the chunk which contains each of 'shardKeys', in the same order, or nullptr for a
+     * key past the last chunk. The keys are located in ascending order with a single forward pass
+     * over the chunks, so a key which falls into the same chunk as the previous one costs a single
+     * comparison.
+     */
+    std::vector<std::shared_ptr<ChunkInfo>> findIntersectingChunks(
+        const std::vector<BSONObj>& shardKeys) const;
+
     ChunkMap createMerged(const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks);
 
+    /**
+     * Returns the number of blocks in which the chunks are stored. Only used for testing.
+     */
+    size_t numBlocks_forTest() const {
+        return _chunkBlocks.size();
+    }
+
     BSONObj toBSON() const;
 
 private:
-    ChunkVector::const_iterator _findIntersectingChunk(const BSONObj& shardKey,
-                                                       bool isMaxInclusive = true) const;
-    std::pair<ChunkVector::const_iterator, ChunkVector::const_iterator> _overlappingBounds(
-        const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
+    class Builder;
 
-    ChunkVector _chunkMap;
+    ChunkPosition _end() const {
+        return {_chunkBlocks.size(), 0};
+    }
+
+    template <typename Callable>
+    void _forEachInRange(ChunkPosition first, ChunkPosition last, Callable&& handler) const {
+        for (auto block = first.block; block < _chunkBlocks.size() && block <= last.block;
+             ++block) {
+            const auto& chunks = _chunkBlocks[block]->chunks;
+            const auto end = block == last.block ? last.chunk : chunks.size();
+            for (auto chunk = (block == first.block ? first.chunk : 0); chunk < end; ++chunk) {
+                if (!handler(chunks[chunk]))
+                    return;
+            }
+        }
+    }
+
+    ChunkPosition _findIntersectingChunk(const BSONObj& shardKey,
+                                         bool isMaxInclusive = true) const;
+    ChunkPosition _findIntersectingChunkFrom(ChunkPosition from,
+                                             const std::string& shardKeyString) const;
+    std::pair<ChunkPosition, ChunkPosition> _overlappingBounds(const BSONObj& min,
+                                                               const BSONObj& max,
+                                                               bool isMaxInclusive) const;
+
+    ChunkBlockVector _chunkBlocks;
+
+    // Total number of chunks across all blocks
+    size_t _size{0};
 
     // Max version across all chunks
     ChunkVersion _collectionVersion;
@@ -239,6 +306,11 @@ public:
         return _chunkMap.findIntersectingChunk(shardKey);
     }
 
+    std::vector<std::shared_ptr<ChunkInfo>> findIntersectingChunks(
+        const std::vector<BSONObj>& shardKeys) const {
+        return _chunkMap.findIntersectingChunks(shardKeys);
+    }
+
     /**
      * Returns the ids of all shards on which the collection has any chunks.
      */
@@ -406,6 +478,14 @@ public:
         return findIntersectingChunk(shardKey, CollationSpec::kSimpleSpec);
     }
 
+    /**
+     * Batched version of findIntersectingChunkWithSimpleCollation(), which returns the chunk for
+     * each of 'shardKeys', in the same order. Rather than throwing, returns boost::none for a key
+     * which cannot be targeted.
+     */
+    std::vector<boost::optional<Chunk>> findIntersectingChunksWithSimpleCollation(
+        const std::vector<BSONObj>& shardKeys) const;
+
     /**
      * Finds the shard id of the shard that owns the chunk minKey belongs to, assuming the simple
      * collation because shard keys do not support non-simple collations.
@@ -31,8 +31,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <set>
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/catalog_test_fixture.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
@@ -535,5 +537,45 @@ TEST_F(ChunkManagerQueryTest, SnapshotQueryWithMoreShardsThanLatestMetadata) {
     ASSERT_EQ(2, shardIds.size());
 }
 
+TEST_F(ChunkManagerQueryTest, FindIntersectingChunksMatchesSingleKeyLookups) {
+    const ShardKeyPattern shardKeyPattern(BSON("a" << 1));
+    std::vector<BSONObj> splitPoints;
+    for (int i = 0; i < 100; i += 10) {
+        splitPoints.push_back(BSON("a" << i));
+    }
+    auto chunkManager = makeChunkManager(kNss, shardKeyPattern, nullptr, false, splitPoints);
+
+    // Neither sorted nor unique, and including the bounds of the chunks
+    std::vector<BSONObj> shardKeys{BSON("a" << 55),
+                                   BSON("a" << MINKEY),
+                                   BSON("a" << -5),
+                                   BSON("a" << 90),
+                                   BSON("a" << 10),
+                                   BSON("a" << 9),
+                                   BSON("a" << 55),
+                                   BSON("a" << 1000),
+                                   BSON("a" << 0)};
+
+    auto chunks = chunkManager->findIntersectingChunksWithSimpleCollation(shardKeys);
+    ASSERT_EQ(shardKeys.size(), chunks.size());
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        auto expected = chunkManager->findIntersectingChunkWithSimpleCollation(shardKeys[i]);
+        ASSERT(chunks[i]);
+        ASSERT_BSONOBJ_EQ(expected.getMin(), chunks[i]->getMin());
+        ASSERT_BSONOBJ_EQ(expected.getMax(), chunks[i]->getMax());
+        ASSERT_EQ(expected.getShardId(), chunks[i]->getShardId());
+    }
+
+    // Keys which are already sorted are looked up without being sorted again
+    std::sort(shardKeys.begin(),
+              shardKeys.end(),
+              SimpleBSONObjComparator::kInstance.makeLessThan());
+    chunks = chunkManager->findIntersectingChunksWithSimpleCollation(shardKeys);
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        ASSERT(chunks[i]);
+        ASSERT(chunks[i]->containsKey(shardKeys[i]));
+    }
+}
+
 }  // namespace
 }  // namespace mongo
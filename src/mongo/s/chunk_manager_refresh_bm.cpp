@@ -125,7 +125,40 @@ void BM_IncrementalRefreshOfPessimalBalancedDistribution(benchmark::State& state
 BENCHMARK(BM_IncrementalRefreshOfPessimalBalancedDistribution)
     ->Args({2, 50000})
     ->Args({2, 250000})
-    ->Args({2, 500000});
+    ->Args({2, 500000})
+    ->Args({2, 1000000});
+
+// Measures how the cost of an incremental refresh grows with the number of chunks which changed,
+// by moving that many consecutive chunks from the middle of the collection to another shard.
+void BM_IncrementalRefreshOfConsecutiveChangedChunks(benchmark::State& state) {
+    const int nShards = 2;
+    const int nChunks = state.range(0);
+    const int nChangedChunks = state.range(1);
+    auto cm = makeChunkManagerWithOptimalBalancedDistribution(nShards, nChunks);
+
+    auto postMoveVersion = cm->getChunkManager()->getVersion();
+    const auto collName = NamespaceString(cm->getChunkManager()->getns());
+    std::vector<ChunkType> newChunks;
+    for (int i = nChunks / 2; i < nChunks / 2 + nChangedChunks; ++i) {
+        postMoveVersion.incMajor();
+        newChunks.emplace_back(
+            collName, getRangeForChunk(i, nChunks), postMoveVersion, ShardId("shard0"));
+    }
+
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(runIncrementalUpdate(*cm, newChunks));
+    }
+
+    state.counters["nChangedChunks"] = nChangedChunks;
+}
+
+BENCHMARK(BM_IncrementalRefreshOfConsecutiveChangedChunks)
+    ->Args({1000000, 1})
+    ->Args({1000000, 100})
+    ->Args({1000000, 10000})
+    ->Args({100000, 1})
+    ->Args({100000, 100})
+    ->Args({100000, 10000});
 
 template <typename ShardSelectorFn>
 auto BM_FullBuildOfChunkManager(benchmark::State& state, ShardSelectorFn selectShard) {
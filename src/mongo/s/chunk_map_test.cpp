@@ -165,4 +165,70 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestMergeAcrossBlocks) {
+    const OID epoch = OID::gen();
+    const ChunkVersion version{1, 0, epoch};
+    const int nChunks = 1000;
+
+    auto makeChunk = [&](BSONObj min, BSONObj max, ChunkVersion chunkVersion) {
+        return std::make_shared<ChunkInfo>(
+            ChunkType{kNss, ChunkRange{std::move(min), std::move(max)}, chunkVersion, kThisShard});
+    };
+
+    std::vector<std::shared_ptr<ChunkInfo>> chunks;
+    for (int i = 0; i < nChunks; ++i) {
+        auto min = i == 0 ? getShardKeyPattern().globalMin() : BSON("a" << i * 10);
+        auto max = i == nChunks - 1 ? getShardKeyPattern().globalMax() : BSON("a" << (i + 1) * 10);
+        chunks.push_back(makeChunk(std::move(min), std::move(max), version));
+    }
+
+    ChunkMap chunkMap{epoch};
+    auto fullChunkMap = chunkMap.createMerged(chunks);
+    ASSERT_EQ(fullChunkMap.size(), nChunks);
+    ASSERT_GT(fullChunkMap.numBlocks_forTest(), 1U);
+
+    // Split the last chunk of the first block and the first chunk of the second block.
+    const ChunkVersion splitVersion{1, 2, epoch};
+    auto splitChunkMap =
+        fullChunkMap.createMerged({makeChunk(BSON("a" << 2550), BSON("a" << 2555), {1, 1, epoch}),
+                                   makeChunk(BSON("a" << 2555), BSON("a" << 2560), {1, 1, epoch}),
+                                   makeChunk(BSON("a" << 2560), BSON("a" << 2565), splitVersion),
+                                   makeChunk(BSON("a" << 2565), BSON("a" << 2570), splitVersion)});
+    ASSERT_EQ(splitChunkMap.size(), nChunks + 2);
+    ASSERT_EQ(splitChunkMap.getVersion(), splitVersion);
+
+    int count = 0;
+    auto lastMax = getShardKeyPattern().globalMin();
+    splitChunkMap.forEach([&](const auto& chunkInfo) {
+        ASSERT_BSONOBJ_EQ(chunkInfo->getMin(), lastMax);
+        lastMax = chunkInfo->getMax();
+        count++;
+        return true;
+    });
+    ASSERT_EQ(count, nChunks + 2);
+    ASSERT_BSONOBJ_EQ(lastMax, getShardKeyPattern().globalMax());
+
+    ASSERT_BSONOBJ_EQ(splitChunkMap.findIntersectingChunk(BSON("a" << 2557))->getMin(),
+                      BSON("a" << 2555));
+    ASSERT_BSONOBJ_EQ(splitChunkMap.findIntersectingChunk(BSON("a" << 2560))->getMin(),
+                      BSON("a" << 2560));
+
+    count = 0;
+    splitChunkMap.forEachOverlappingChunk(
+        BSON("a" << 2545), BSON("a" << 2580), true, [&](const auto& chunk) {
+            count++;
+            return true;
+        });
+    ASSERT_EQ(count, 7);
+
+    auto shardVersions = splitChunkMap.constructShardVersionMap();
+    ASSERT_EQ(shardVersions.size(), 1U);
+    ASSERT_EQ(shardVersions.at(kThisShard).shardVersion, splitVersion);
+
+    // The map the split was merged into is left as it was.
+    ASSERT_EQ(fullChunkMap.size(), nChunks);
+    ASSERT_BSONOBJ_EQ(fullChunkMap.findIntersectingChunk(BSON("a" << 2557))->getMin(),
+                      BSON("a" << 2550));
+}
+
 }  // namespace mongo
\ No newline at end of file
@@ -31,6 +31,7 @@
 
 #include <vector>
 
+#include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/write_ops.h"
@@ -96,6 +97,25 @@ public:
      */
     virtual ShardEndpoint targetInsert(OperationContext* opCtx, const BSONObj& doc) const = 0;
 
+    /**
+     * Returns the ShardEndpoint for each of 'docs', in the same order, or the error with which
+     * targetInsert() would have failed for that document. Targeters which can target many
+     * documents at once more efficiently than one at a time should override this.
+     */
+    virtual std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+        std::vector<StatusWith<ShardEndpoint>> endpoints;
+        endpoints.reserve(docs.size());
+        for (const auto& doc : docs) {
+            try {
+                endpoints.emplace_back(targetInsert(opCtx, doc));
+            } catch (const DBException& ex) {
+                endpoints.emplace_back(ex.toStatus());
+            }
+        }
+        return endpoints;
+    }
+
     /**
      * Returns a vector of ShardEndpoints for a potentially multi-shard update or throws
      * ShardKeyNotFound if 'updateOp' misses a shard key, but the type of update requires it.
@@ -105,8 +105,12 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(
-          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
+      _mergeOnKeyStrings(_params.getSort() &&
+                         _params.getSort()->nFields() <= int(Ordering::kMaxCompoundIndexKeys)),
+      _mergeTree(MergingComparator(_remotes,
+                                   _params.getSort().value_or(BSONObj()),
+                                   _params.getCompareWholeSortKey(),
+                                   _mergeOnKeyStrings)),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
@@ -127,6 +131,7 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
         _addBatchToBuffer(WithLock::withoutLock(), remoteIndex, remote.getCursorResponse());
         ++remoteIndex;
     }
+    _mergeTree.reset(_remotes.size());
     // If this is a change stream, then we expect to have already received PBRTs from every shard.
     invariant(_promisedMinSortKeys.empty() || _promisedMinSortKeys.size() == _remotes.size());
     _setInitialHighWaterMark();
@@ -221,6 +226,7 @@ void AsyncResultsMerger::addNewShardCursors(std::vector<RemoteCursor>&& newCurso
                               remote.getCursorResponse().getPartialResultsReturned());
         _addBatchToBuffer(lk, newIndex, remote.getCursorResponse());
     }
+    _mergeTree.reset(_remotes.size());
 }
 
 bool AsyncResultsMerger::partialResultsReturned() const {
@@ -307,11 +313,11 @@ bool AsyncResultsMerger::_readySorted(WithLock lk) {
 }
 
 bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
-    if (_mergeQueue.empty()) {
+    if (_remotes.empty() || !_remotes[_mergeTree.winner()].hasNext()) {
         return false;
     }
 
-    auto smallestRemote = _mergeQueue.top();
+    auto smallestRemote = _mergeTree.winner();
     auto smallestResult = _remotes[smallestRemote].docBuffer.front();
     auto keyWeWantToReturn =
         extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
@@ -359,25 +365,23 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
-    if (_mergeQueue.empty()) {
+    if (_remotes.empty() || !_remotes[_mergeTree.winner()].hasNext()) {
         return {};
     }
 
-    size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
+    size_t smallestRemote = _mergeTree.winner();
 
-    invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status.isOK());
 
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
-
-    // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
-    // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
+    if (_mergeOnKeyStrings) {
+        _remotes[smallestRemote].sortKeyBuffer.pop();
     }
 
+    // Let the next result from 'smallestRemote', if it has one, compete for the next spot.
+    _mergeTree.replayWinner();
+
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
     if (_tailableMode == TailableModeEnum::kTailableAndAwaitData) {
         if (_remotes[smallestRemote].eligibleForHighWaterMark) {
@@ -708,6 +712,9 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        std::queue<KeyString::Value> emptySortKeyBuffer;
+        std::swap(remote.sortKeyBuffer, emptySortKeyBuffer);
+        _mergeTree.invalidate();
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -763,6 +770,9 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
     _updateRemoteMetadata(lk, remoteIndex, response);
+
+    const auto sortKeyOrdering =
+        _mergeOnKeyStrings ? Ordering::make(*_params.getSort()) : Ordering::allAscending();
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
         if (_params.getSort()) {
@@ -785,12 +795,23 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
         ++remote.fetchedCount;
+
+        // Encode the sort key once here rather than comparing it as BSON on every step of the
+        // merge. mongod has already mapped strings to their collation comparison keys, so the
+        // KeyStrings compare the same way as the sort keys do under the sort pattern.
+        if (_mergeOnKeyStrings) {
+            KeyString::HeapBuilder sortKey(
+                KeyString::Version::kLatestVersion,
+                extractSortKey(obj, _params.getCompareWholeSortKey()),
+                sortKeyOrdering);
+            remote.sortKeyBuffer.push(sortKey.release());
+        }
     }
 
-    // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
+    // If we're doing a sorted merge, then the merge tree has to take the new results of this
+    // remote into account.
     if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+        _mergeTree.invalidate();
     }
     return true;
 }
@@ -907,13 +928,33 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 // AsyncResultsMerger::MergingComparator
 //
 
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
+bool AsyncResultsMerger::MergingComparator::operator()(size_t lhs, size_t rhs) const {
+    const auto& leftRemote = _remotes[lhs];
+    const auto& rightRemote = _remotes[rhs];
+
+    if (leftRemote.hasNext() != rightRemote.hasNext()) {
+        return leftRemote.hasNext();
+    }
+
+    if (leftRemote.hasNext()) {
+        if (auto cmp = _compareNextResults(leftRemote, rightRemote); cmp != 0) {
+            return cmp < 0;
+        }
+    }
+
+    // Break ties by the position of the remote so that the merge order is deterministic.
+    return lhs < rhs;
+}
+
+int AsyncResultsMerger::MergingComparator::_compareNextResults(const RemoteCursorData& lhs,
+                                                               const RemoteCursorData& rhs) const {
+    if (_compareKeyStrings) {
+        return lhs.sortKeyBuffer.front().compare(rhs.sortKeyBuffer.front());
+    }
 
-    return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
-                           extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
+    return compareSortKeys(extractSortKey(*lhs.docBuffer.front().getResult(), _compareWholeSortKey),
+                           extractSortKey(*rhs.docBuffer.front().getResult(), _compareWholeSortKey),
+                           _sort);
 }
 
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
@@ -36,10 +36,12 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/cursor_id.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
 #include "mongo/s/query/cluster_query_result.h"
+#include "mongo/s/query/loser_tree.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/net/hostandport.h"
 #include "mongo/util/time_support.h"
@@ -88,8 +90,8 @@ public:
      * the hosts on which they exist in _remotes.
      *
      * Additionally copies each remote's first batch of results, if one exists, into that remote's
-     * docBuffer. If a sort is specified in the ClusterClientCursorParams, places the remotes with
-     * buffered results onto _mergeQueue.
+     * docBuffer. If a sort is specified in the ClusterClientCursorParams, sets up _mergeTree to
+     * merge the buffered results of the remotes.
      *
      * The TaskExecutor* must remain valid for the lifetime of the ARM.
      *
@@ -308,6 +310,10 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // Used only if the merge is on KeyStrings. The sort keys of the results in 'docBuffer', in
+        // the same order, encoded as KeyStrings so that the merge can compare them with memcmp.
+        std::queue<KeyString::Value> sortKeyBuffer;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -320,16 +326,26 @@ private:
         long long fetchedCount = 0;
     };
 
+    /**
+     * Orders remotes by the sort key of their next buffered result. Remotes without a buffered
+     * result sort after all others.
+     */
     class MergingComparator {
     public:
         MergingComparator(const std::vector<RemoteCursorData>& remotes,
                           const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
+                          bool compareWholeSortKey,
+                          bool compareKeyStrings)
+            : _remotes(remotes),
+              _sort(sort),
+              _compareWholeSortKey(compareWholeSortKey),
+              _compareKeyStrings(compareKeyStrings) {}
 
-        bool operator()(const size_t& lhs, const size_t& rhs);
+        bool operator()(size_t lhs, size_t rhs) const;
 
     private:
+        int _compareNextResults(const RemoteCursorData& lhs, const RemoteCursorData& rhs) const;
+
         const std::vector<RemoteCursorData>& _remotes;
 
         const BSONObj _sort;
@@ -338,6 +354,10 @@ private:
         // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
         // be {$sortKey: 1}.
         const bool _compareWholeSortKey;
+
+        // When '_compareKeyStrings' is true, the remotes' 'sortKeyBuffer's are compared rather
+        // than the sort keys of their buffered documents.
+        const bool _compareKeyStrings;
     };
 
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
@@ -480,15 +500,20 @@ private:
     TailableModeEnum _tailableMode;
     AsyncResultsMergerParams _params;
 
+    // Whether the sort keys of the remotes are merged as KeyStrings, which is possible whenever
+    // there is a sort whose pattern can be expressed as an Ordering.
+    const bool _mergeOnKeyStrings;
+
     // Must be acquired before accessing any data members (other than _params, which is read-only).
     mutable Mutex _mutex = MONGO_MAKE_LATCH("AsyncResultsMerger::_mutex");
 
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // The winner of this tree is the index into '_remotes' for the remote host that has the next
+    // document to return, according to the sort order, if that remote has any buffered results.
+    // Used only if there is a sort.
+    LoserTree<MergingComparator> _mergeTree;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
@@ -441,6 +441,48 @@ TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortKeysOfDifferentTypesMergeInBSONOrder) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1}}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // Schedule requests.
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    ASSERT_FALSE(arm->ready());
+
+    // Deliver responses. Numbers of different types compare by value, and sort after strings.
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: ['b']}"),
+                                   fromjson("{$sortKey: [NumberLong(3)]}"),
+                                   fromjson("{$sortKey: [1.5]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch1);
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: ['a']}"),
+                                   fromjson("{$sortKey: [2.5]}"),
+                                   fromjson("{$sortKey: [1]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch2);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    // ARM returns all results in sorted order.
+    for (auto&& expected : {fromjson("{$sortKey: ['b']}"),
+                            fromjson("{$sortKey: ['a']}"),
+                            fromjson("{$sortKey: [NumberLong(3)]}"),
+                            fromjson("{$sortKey: [2.5]}"),
+                            fromjson("{$sortKey: [1.5]}"),
+                            fromjson("{$sortKey: [1]}")}) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(expected, *unittest::assertGet(arm->nextReady()).getResult());
+    }
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, SortedButNoSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
@@ -707,8 +707,12 @@ Status dispatchPipelineAndMerge(OperationContext* opCtx,
                                 bool hasChangeStream) {
     auto expCtx = targeter.pipeline->getContext();
     // If not, split the pipeline as necessary and dispatch to the relevant shards.
-    auto shardDispatchResults = sharded_agg_helpers::dispatchShardPipeline(
-        serializedCommand, hasChangeStream, std::move(targeter.pipeline));
+    // Only this path dispatches the exchange consumers, and explain never runs them.
+    auto shardDispatchResults =
+        sharded_agg_helpers::dispatchShardPipeline(serializedCommand,
+                                                   hasChangeStream,
+                                                   std::move(targeter.pipeline),
+                                                   !expCtx->explain /* eligibleForGroupExchange */);
 
     // If the operation is an explain, then we verify that it succeeded on all targeted
     // shards, write the results to the output builder, and return immediately.
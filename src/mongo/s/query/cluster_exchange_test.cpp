@@ -39,6 +39,7 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
 #include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
 #include "mongo/s/query/sharded_agg_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
@@ -60,6 +61,30 @@ protected:
     boost::optional<ChunkVersion> _mergeTargetCollectionVersion;
 };
 
+class ClusterGroupExchangeTest : public ClusterExchangeTest {
+protected:
+    void setUp() override {
+        ClusterExchangeTest::setUp();
+        internalQueryEnableHashPartitionedGroup.store(true);
+    }
+
+    void tearDown() override {
+        internalQueryEnableHashPartitionedGroup.store(false);
+        ClusterExchangeTest::tearDown();
+    }
+
+    boost::optional<sharded_agg_helpers::ShardedExchangePolicy> checkIfEligible(
+        Pipeline::SourceContainer mergeStages,
+        boost::optional<BSONObj> shardCursorsSortSpec = boost::none) {
+        sharded_agg_helpers::SplitPipeline splitPipeline(
+            nullptr, Pipeline::create(std::move(mergeStages), expCtx()), shardCursorsSortSpec);
+        return sharded_agg_helpers::checkIfEligibleForGroupExchange(
+            operationContext(), splitPipeline, _shardIds);
+    }
+
+    std::set<ShardId> _shardIds{ShardId("0"), ShardId("1"), ShardId("2")};
+};
+
 TEST_F(ClusterExchangeTest, ShouldNotExchangeIfPipelineDoesNotEndWithMerge) {
     setupNShards(2);
     auto mergePipe = Pipeline::create({DocumentSourceLimit::create(expCtx(), 1)}, expCtx());
@@ -608,5 +633,52 @@ TEST_F(ClusterExchangeTest, CompoundShardKeyThreeShards) {
 
     future.default_timed_get();
 }
+
+TEST_F(ClusterGroupExchangeTest, MergingGroupIsHashPartitionedAcrossTargetedShards) {
+    auto exchangeSpec = checkIfEligible({parseStage("{$group: {_id: '$x', $doingMerge: true}}"),
+                                         parseStage("{$match: {_id: {$gte: 0}}}"),
+                                         parseStage("{$project: {word: '$_id', _id: 0}}")});
+    ASSERT_TRUE(exchangeSpec);
+    ASSERT(exchangeSpec->exchangeSpec.getPolicy() == ExchangePolicyEnum::kKeyRange);
+    ASSERT_BSONOBJ_EQ(exchangeSpec->exchangeSpec.getKey(),
+                      BSON("_id"
+                           << "hashed"));
+    ASSERT_EQ(exchangeSpec->exchangeSpec.getConsumers(), 3);
+    ASSERT(exchangeSpec->consumerShards ==
+           std::vector<ShardId>(_shardIds.begin(), _shardIds.end()));
+    ASSERT(exchangeSpec->exchangeSpec.getConsumerIds().get() == std::vector<int>({0, 1, 2}));
+
+    // The hash space is split into three ranges of equal width.
+    const auto& boundaries = exchangeSpec->exchangeSpec.getBoundaries().get();
+    ASSERT_EQ(boundaries.size(), 4UL);
+    ASSERT_BSONOBJ_EQ(boundaries[0], BSON("_id" << MINKEY));
+    ASSERT_BSONOBJ_EQ(boundaries[1], BSON("_id" << -3074457345618258603LL));
+    ASSERT_BSONOBJ_EQ(boundaries[2], BSON("_id" << 3074457345618258602LL));
+    ASSERT_BSONOBJ_EQ(boundaries[3], BSON("_id" << MAXKEY));
+}
+
+TEST_F(ClusterGroupExchangeTest, GroupIsNotHashPartitionedWhenDisabled) {
+    internalQueryEnableHashPartitionedGroup.store(false);
+    ASSERT_FALSE(checkIfEligible({parseStage("{$group: {_id: '$x', $doingMerge: true}}")}));
+}
+
+TEST_F(ClusterGroupExchangeTest, GroupIsNotHashPartitionedForASingleShard) {
+    _shardIds = {ShardId("0")};
+    ASSERT_FALSE(checkIfEligible({parseStage("{$group: {_id: '$x', $doingMerge: true}}")}));
+}
+
+TEST_F(ClusterGroupExchangeTest, PipelineNotStartingWithMergingGroupIsNotHashPartitioned) {
+    ASSERT_FALSE(checkIfEligible({parseStage("{$match: {x: 1}}")}));
+    ASSERT_FALSE(checkIfEligible({parseStage("{$group: {_id: '$x'}}")}));
+    ASSERT_FALSE(checkIfEligible({parseStage("{$group: {_id: '$x', $doingMerge: true}}")},
+                                 BSON("x" << 1)));
+}
+
+TEST_F(ClusterGroupExchangeTest, GroupFollowedBySingleMergerStageIsNotHashPartitioned) {
+    ASSERT_FALSE(checkIfEligible({parseStage("{$group: {_id: '$x', $doingMerge: true}}"),
+                                  parseStage("{$sort: {_id: 1}}")}));
+    ASSERT_FALSE(checkIfEligible({parseStage("{$group: {_id: '$x', $doingMerge: true}}"),
+                                  DocumentSourceLimit::create(expCtx(), 1)}));
+}
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * A tournament tree of losers over the leaves [0, numLeaves), which repeatedly selects the smallest
+ * leaf according to 'Less'. Unlike a binary heap, replacing the value of the winning leaf costs
+ * exactly one comparison per level of the tree, which makes it well suited to k-way merges.
+ *
+ * The tree does not own the values of the leaves; 'Less' compares two leaf indexes, and leaves
+ * which have run out of values should compare greater than all others. After the value of the
+ * winning leaf changes, the caller must call replayWinner(). After the value of any other leaf
+ * changes, the caller must call invalidate(), and the tree is rebuilt from scratch on next use.
+ *
+ * 'Less' must be a strict total order over the leaves, so ties should be broken, e.g. by index.
+ */
+template <typename Less>
+class LoserTree {
+public:
+    explicit LoserTree(Less less) : _less(std::move(less)) {}
+
+    /**
+     * Resizes the tree to 'numLeaves' leaves. The tree is rebuilt on next use.
+     */
+    void reset(size_t numLeaves) {
+        _numLeaves = numLeaves;
+        _needsRebuild = true;
+    }
+
+    void invalidate() {
+        _needsRebuild = true;
+    }
+
+    size_t numLeaves() const {
+        return _numLeaves;
+    }
+
+    /**
+     * Returns the index of the smallest leaf. The tree must have at least one leaf.
+     */
+    size_t winner() {
+        invariant(_numLeaves > 0);
+        if (_needsRebuild) {
+            _rebuild();
+        }
+        return _winner;
+    }
+
+    /**
+     * Restores the tree after the value of the winning leaf has changed.
+     */
+    void replayWinner() {
+        if (_needsRebuild) {
+            return;
+        }
+
+        // The leaves are nodes [numLeaves, 2 * numLeaves) of an implicit binary tree whose
+        // internal nodes [1, numLeaves) each hold the loser of the match played at that node.
+        auto candidate = _winner;
+        for (auto node = (_numLeaves + candidate) / 2; node > 0; node /= 2) {
+            if (_less(_losers[node], candidate)) {
+                std::swap(_losers[node], candidate);
+            }
+        }
+        _winner = candidate;
+    }
+
+private:
+    void _rebuild() {
+        // The winner of each internal node, only needed while playing the first round.
+        std::vector<size_t> winners(_numLeaves);
+        _losers.assign(_numLeaves, 0);
+
+        auto winnerAt = [&](size_t node) {
+            return node >= _numLeaves ? node - _numLeaves : winners[node];
+        };
+        for (auto node = _numLeaves - 1; node > 0; --node) {
+            auto left = winnerAt(2 * node);
+            auto right = winnerAt(2 * node + 1);
+            if (_less(right, left)) {
+                std::swap(left, right);
+            }
+            winners[node] = left;
+            _losers[node] = right;
+        }
+
+        _winner = winnerAt(1);
+        _needsRebuild = false;
+    }
+
+    Less _less;
+
+    size_t _numLeaves{0};
+    bool _needsRebuild{true};
+
+    size_t _winner{0};
+    std::vector<size_t> _losers;
+};
+
+}  // namespace mongo
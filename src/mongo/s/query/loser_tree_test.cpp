@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/loser_tree.h"
+
+#include <deque>
+#include <vector>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Runs = std::vector<std::deque<int>>;
+
+/**
+ * Orders runs by their first value, with exhausted runs last and ties broken by index.
+ */
+struct RunLess {
+    bool operator()(size_t lhs, size_t rhs) const {
+        const auto& left = (*runs)[lhs];
+        const auto& right = (*runs)[rhs];
+        if (left.empty() != right.empty()) {
+            return !left.empty();
+        }
+        if (!left.empty() && left.front() != right.front()) {
+            return left.front() < right.front();
+        }
+        return lhs < rhs;
+    }
+
+    const Runs* runs;
+};
+
+std::vector<std::pair<int, size_t>> mergeRuns(Runs& runs) {
+    LoserTree<RunLess> tree(RunLess{&runs});
+    tree.reset(runs.size());
+
+    std::vector<std::pair<int, size_t>> merged;
+    while (!runs[tree.winner()].empty()) {
+        auto winner = tree.winner();
+        merged.emplace_back(runs[winner].front(), winner);
+        runs[winner].pop_front();
+        tree.replayWinner();
+    }
+    return merged;
+}
+
+TEST(LoserTreeTest, SingleLeaf) {
+    Runs runs{{1, 2, 3}};
+    auto merged = mergeRuns(runs);
+    ASSERT(merged == (std::vector<std::pair<int, size_t>>{{1, 0}, {2, 0}, {3, 0}}));
+}
+
+TEST(LoserTreeTest, MergesRunsInOrder) {
+    // An odd number of leaves, including empty ones, so that the tree is not complete
+    Runs runs{{5, 9}, {}, {1, 4, 7}, {2, 3, 8}, {6}, {}, {0, 10}};
+    auto merged = mergeRuns(runs);
+
+    std::vector<int> values;
+    for (auto&& [value, leaf] : merged) {
+        values.push_back(value);
+    }
+    ASSERT(values == (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+TEST(LoserTreeTest, BreaksTiesByLeaf) {
+    Runs runs{{1, 2}, {1}, {0, 2}};
+    auto merged = mergeRuns(runs);
+    ASSERT(merged ==
+           (std::vector<std::pair<int, size_t>>{{0, 2}, {1, 0}, {1, 1}, {2, 0}, {2, 2}}));
+}
+
+TEST(LoserTreeTest, RebuildsAfterInvalidate) {
+    Runs runs{{3}, {}, {4}};
+    LoserTree<RunLess> tree(RunLess{&runs});
+    tree.reset(runs.size());
+    ASSERT_EQ(0U, tree.winner());
+
+    // A leaf which is not the winner gets a smaller value
+    runs[1].push_back(1);
+    tree.invalidate();
+    ASSERT_EQ(1U, tree.winner());
+
+    runs[1].pop_front();
+    tree.replayWinner();
+    ASSERT_EQ(0U, tree.winner());
+
+    // A new leaf is added
+    runs.push_back({2});
+    tree.reset(runs.size());
+    ASSERT_EQ(3U, tree.winner());
+}
+
+}  // namespace
+}  // namespace mongo
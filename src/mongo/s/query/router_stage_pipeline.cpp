@@ -57,7 +57,9 @@ StatusWith<ClusterQueryResult> RouterStagePipeline::next(RouterExecStage::ExecCo
         return _validateAndConvertToBSON(*result);
     }
 
-    // If we reach this point, we have hit EOF.
+    // If we reach this point, we have hit EOF. Every event read by the pipeline has been returned,
+    // so the high water mark of the remotes can be reported from now on.
+    _lastReturnedResumeToken = BSONObj();
     if (!_mergePipeline->getContext()->isTailableAwaitData()) {
         _mergePipeline.get_deleter().dismissDisposal();
         _mergePipeline->dispose(getOpCtx());
@@ -87,6 +89,9 @@ std::size_t RouterStagePipeline::getNumRemotes() const {
 }
 
 BSONObj RouterStagePipeline::getPostBatchResumeToken() const {
+    if (!_lastReturnedResumeToken.isEmpty()) {
+        return _lastReturnedResumeToken;
+    }
     return _mergeCursorsStage ? _mergeCursorsStage->getHighWaterMark() : BSONObj();
 }
 
@@ -110,6 +115,7 @@ BSONObj RouterStagePipeline::_validateAndConvertToBSON(const Document& event) {
                           << (eventBSON["_id"] ? BSON("_id" << eventBSON["_id"]) : BSONObj()),
             (resumeToken.getType() == BSONType::Object) &&
                 idField.binaryEqual(resumeToken.getDocument().toBson()));
+    _lastReturnedResumeToken = idField.getOwned();
 
     // Return the event in BSONObj form, minus the $sortKey metadata.
     return eventBSON;
@@ -69,5 +69,10 @@ private:
 
     // May be null if this pipeline runs exclusively on mongos without contacting the shards at all.
     boost::intrusive_ptr<DocumentSourceMergeCursors> _mergeCursorsStage;
+
+    // The resume token of the change stream event returned by the last call to next(), if it
+    // returned one. Stages of the pipeline may have read further events ahead of it, which moves
+    // the high water mark of '_mergeCursorsStage' past events that were not returned yet.
+    BSONObj _lastReturnedResumeToken;
 };
 }  // namespace mongo
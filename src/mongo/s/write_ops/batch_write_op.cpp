@@ -31,6 +31,7 @@
 
 #include "mongo/s/write_ops/batch_write_op.h"
 
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -245,6 +246,70 @@ void trackErrors(const ShardEndpoint& endpoint,
     }
 }
 
+/**
+ * Targets the documents of the ready inserts of a batch a window at a time, so that the targeter
+ * can look up their shard keys together rather than one by one. Each window is as large as the
+ * number of inserts already handed out, so that when targeting stops early (as it does for ordered
+ * batches whose inserts go to more than one shard) the inserts targeted in vain stay proportional
+ * to the ones which were used.
+ */
+class InsertEndpointCache {
+public:
+    InsertEndpointCache(OperationContext* opCtx,
+                        const NSTargeter& targeter,
+                        const std::vector<WriteOp>& writeOps)
+        : _opCtx(opCtx), _targeter(targeter), _writeOps(writeOps) {}
+
+    /**
+     * Returns the endpoint of the insert at 'index', which must be a ready insert, or the error
+     * with which targeting it failed.
+     */
+    const StatusWith<ShardEndpoint>& get(size_t index) {
+        if (index < _windowBegin || index >= _windowBegin + _endpointIndexes.size()) {
+            _targetWindowFrom(index);
+        }
+
+        ++_numConsumed;
+        return _endpoints[_endpointIndexes[index - _windowBegin]];
+    }
+
+private:
+    static constexpr size_t kMinWindowSize = 16;
+
+    void _targetWindowFrom(size_t begin) {
+        const size_t windowSize = std::max(kMinWindowSize, _numConsumed);
+
+        std::vector<BSONObj> docs;
+        _endpointIndexes.clear();
+        for (size_t i = begin; i < _writeOps.size() && docs.size() < windowSize; ++i) {
+            if (_writeOps[i].getWriteState() == WriteOpState_Ready) {
+                _endpointIndexes.push_back(docs.size());
+                docs.push_back(_writeOps[i].getWriteItem().getDocument());
+            } else {
+                _endpointIndexes.push_back(kNotTargeted);
+            }
+        }
+
+        _windowBegin = begin;
+        _endpoints = _targeter.targetInserts(_opCtx, docs);
+        invariant(_endpoints.size() == docs.size());
+    }
+
+    static constexpr size_t kNotTargeted = std::numeric_limits<size_t>::max();
+
+    OperationContext* const _opCtx;
+    const NSTargeter& _targeter;
+    const std::vector<WriteOp>& _writeOps;
+
+    // The index of the first write op of the current window, and for each write op of the window
+    // its position in '_endpoints', if it was targeted
+    size_t _windowBegin{0};
+    std::vector<size_t> _endpointIndexes;
+    std::vector<StatusWith<ShardEndpoint>> _endpoints;
+
+    size_t _numConsumed{0};
+};
+
 }  // namespace
 
 BatchWriteOp::BatchWriteOp(OperationContext* opCtx, const BatchedCommandRequest& clientRequest)
@@ -302,6 +367,13 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // Inserts are targeted by their documents alone, so the documents of many of them can be
+    // targeted together
+    boost::optional<InsertEndpointCache> insertEndpoints;
+    if (_clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert) {
+        insertEndpoints.emplace(_opCtx, targeter, _writeOps);
+    }
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -319,7 +391,11 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
         Status targetStatus = Status::OK();
         try {
-            writeOp.targetWrites(_opCtx, targeter, &writes);
+            if (insertEndpoints) {
+                writeOp.targetInsertAt(uassertStatusOK(insertEndpoints->get(i)), &writes);
+            } else {
+                writeOp.targetWrites(_opCtx, targeter, &writes);
+            }
         } catch (const DBException& ex) {
             targetStatus = ex.toStatus();
         }
@@ -49,6 +49,7 @@
 #include "mongo/s/grid.h"
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/s/write_ops/chunk_manager_targeter.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/intrusive_counter.h"
 #include "mongo/util/str.h"
 #include "signal.h"
@@ -403,6 +404,72 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
                          _routingInfo->db().databaseVersion());
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    if (!_routingInfo->cm()) {
+        return NSTargeter::targetInserts(opCtx, docs);
+    }
+
+    const auto& shardKeyPattern = _routingInfo->cm()->getShardKeyPattern();
+
+    std::vector<StatusWith<ShardEndpoint>> endpoints;
+    endpoints.reserve(docs.size());
+
+    // Extract the shard keys of all the documents first, so that they can be looked up in the
+    // routing table together.
+    std::vector<BSONObj> shardKeys;
+    std::vector<size_t> shardKeyDocIndexes;
+    for (size_t i = 0; i < docs.size(); ++i) {
+        auto shardKey = shardKeyPattern.extractShardKeyFromDoc(docs[i]);
+        if (shardKey.isEmpty()) {
+            // See targetInsert() for why the shard key would be empty.
+            endpoints.emplace_back(ErrorCodes::ShardKeyNotFound,
+                                   "Shard key cannot contain array values or array descendants.");
+            continue;
+        }
+
+        // Only a placeholder until the chunk for the shard key has been found.
+        endpoints.emplace_back(ErrorCodes::InternalError, "Document has not been targeted");
+        shardKeys.push_back(std::move(shardKey));
+        shardKeyDocIndexes.push_back(i);
+    }
+
+    auto chunks = _routingInfo->cm()->findIntersectingChunksWithSimpleCollation(shardKeys);
+
+    // Many documents go to the same few shards, so only look up the version of each shard once.
+    stdx::unordered_map<ShardId, StatusWith<ChunkVersion>, ShardId::Hasher> shardVersions;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto& endpoint = endpoints[shardKeyDocIndexes[i]];
+        if (!chunks[i]) {
+            endpoint = Status(ErrorCodes::ShardKeyNotFound,
+                              str::stream() << "Cannot target single shard using key "
+                                            << shardKeys[i] << " for namespace " << _nss);
+            continue;
+        }
+
+        const auto& shardId = chunks[i]->getShardId();
+        auto shardVersionIt = shardVersions.find(shardId);
+        if (shardVersionIt == shardVersions.end()) {
+            auto shardVersion = [&]() -> StatusWith<ChunkVersion> {
+                try {
+                    return _routingInfo->cm()->getVersion(shardId);
+                } catch (const DBException& ex) {
+                    return ex.toStatus();
+                }
+            }();
+            shardVersionIt = shardVersions.emplace(shardId, std::move(shardVersion)).first;
+        }
+
+        if (!shardVersionIt->second.isOK()) {
+            endpoint = shardVersionIt->second.getStatus();
+            continue;
+        }
+        endpoint = ShardEndpoint(shardId, shardVersionIt->second.getValue());
+    }
+
+    return endpoints;
+}
+
 std::vector<ShardEndpoint> ChunkManagerTargeter::targetUpdate(OperationContext* opCtx,
                                                               const BatchItemRef& itemRef) const {
     // If the update is replacement-style:
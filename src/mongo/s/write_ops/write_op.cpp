@@ -76,6 +76,20 @@ void WriteOp::targetWrites(OperationContext* opCtx,
         endpoints = targeter.targetAllShards(opCtx);
     }
 
+    const bool ignoreShardVersion = endpoints.size() > 1u && !inTransaction;
+    _addChildWrites(std::move(endpoints), ignoreShardVersion, targetedWrites);
+}
+
+void WriteOp::targetInsertAt(ShardEndpoint endpoint, std::vector<TargetedWrite*>* targetedWrites) {
+    invariant(_itemRef.getOpType() == BatchedCommandRequest::BatchType_Insert);
+    std::vector<ShardEndpoint> endpoints;
+    endpoints.push_back(std::move(endpoint));
+    _addChildWrites(std::move(endpoints), false, targetedWrites);
+}
+
+void WriteOp::_addChildWrites(std::vector<ShardEndpoint> endpoints,
+                              bool ignoreShardVersion,
+                              std::vector<TargetedWrite*>* targetedWrites) {
     for (auto&& endpoint : endpoints) {
         // If the operation was already successfull on that shard, do not repeat it
         if (_successfulShardSet.count(endpoint.shardName))
@@ -87,7 +101,7 @@ void WriteOp::targetWrites(OperationContext* opCtx,
 
         // Outside of a transaction, multiple endpoints currently imply no versioning, since we
         // can't retry half a regular multi-write.
-        if (endpoints.size() > 1u && !inTransaction) {
+        if (ignoreShardVersion) {
             endpoint.shardVersion = ChunkVersion::IGNORED();
             endpoint.shardVersion.canThrowSSVOnIgnored();
         }
@@ -123,6 +123,12 @@ public:
                       const NSTargeter& targeter,
                       std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as targetWrites(), but for an insert whose ShardEndpoint was already determined by the
+     * caller, for example by targeting the documents of a whole batch together.
+     */
+    void targetInsertAt(ShardEndpoint endpoint, std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -166,6 +172,14 @@ private:
      */
     void _updateOpState();
 
+    /**
+     * Creates a pending child write for each of 'endpoints' on which this write has not already
+     * succeeded.
+     */
+    void _addChildWrites(std::vector<ShardEndpoint> endpoints,
+                         bool ignoreShardVersion,
+                         std::vector<TargetedWrite*>* targetedWrites);
+
     // Owned elsewhere, reference to a batch with a write item
     const BatchItemRef _itemRef;
 
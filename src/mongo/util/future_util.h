@@ -145,12 +145,24 @@ private:
                         return ExecutorFuture<ReturnType>(executor, std::move(s));
 
                     // Retry after a delay.
-                    return sleepFor(executor, Milliseconds(delay)).then([this, self]() mutable {
+                    return sleepFor(executor, nextDelay()).then([this, self]() mutable {
                         return run();
                     });
                 });
         }
 
+        /**
+         * Returns how long to wait before the next iteration, evaluating the delay if it is a
+         * callable.
+         */
+        Milliseconds nextDelay() {
+            if constexpr (std::is_invocable_v<Delay&>) {
+                return Milliseconds(delay());
+            } else {
+                return Milliseconds(delay);
+            }
+        }
+
         std::shared_ptr<executor::TaskExecutor> executor;
         BodyCallable executeLoopBody;
         ConditionCallable shouldStopIteration;
@@ -176,7 +188,8 @@ public:
 
     /**
      * Creates a delay which takes place after evaluating the condition and before executing the
-     * loop body.
+     * loop body. The delay is either a duration, or a callable returning a duration which is
+     * invoked anew before every delay.
      */
     template <typename Delay>
     auto withDelayBetweenIterations(Delay delay)&& {
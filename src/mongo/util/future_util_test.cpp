@@ -130,6 +130,26 @@ TEST_F(AsyncTryUntilTest, LoopRespectsDelayAfterEvaluatingCondition) {
     ASSERT_EQ(i, numLoops);
 }
 
+TEST_F(AsyncTryUntilTest, LoopEvaluatesDelayCallableBeforeEveryDelay) {
+    const int numLoops = 3;
+    auto i = 0;
+    auto numDelays = 0;
+    auto resultFut = AsyncTry([&] {
+                         ++i;
+                         return i;
+                     })
+                         .until([&](StatusWith<int> swInt) { return swInt.getValue() == numLoops; })
+                         .withDelayBetweenIterations([&] {
+                             ++numDelays;
+                             return Milliseconds(0);
+                         })
+                         .on(executor());
+    resultFut.wait();
+
+    ASSERT_EQ(i, numLoops);
+    ASSERT_EQ(numDelays, numLoops - 1);
+}
+
 TEST_F(AsyncTryUntilTest, LoopBodyPropagatesValueOfLastIterationToCaller) {
     auto i = 0;
     auto expectedResult = 3;